@@ -0,0 +1,111 @@
+/**
+ * @file        boottime.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Boot Phase Timing Report
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <boottime.h>
+#include <cpu.h>
+#include <serial.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Report names of the phases, NULL for the reference timestamp
+static const char* const BootPhaseNames[BOOT_PHASES] =
+{
+    NULL,
+    "pen",
+    "invalidate",
+    "cpu_init",
+    "page_table",
+    "mmu",
+    "bss",
+};
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+// Set in boot.S
+extern volatile uint32_t boot_times[][BOOT_ROW_SIZE / sizeof(uint32_t)];
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Reads the generic timer frequency (CNTFRQ, set by the firmware)
+ * @param   None
+ * @retval  Frequency (Hz), 0 without the generic timer
+ */
+static uint32_t BootTimerFrequency(void);
+
+
+/* Private functions -------------------------------------- */
+
+uint32_t BootTimerFrequency(void)
+{
+    uint32_t frequency = 0;
+#ifdef CORTEX_A7
+    asm volatile("mrc   p15, 0, %[_freq], c14, c0, 0" : [_freq] "=r" (frequency));
+#endif
+    return frequency;
+}
+
+/**
+ * BootTimesPrint Implementation (See header arch/include/boottime.h file for description)
+*/
+void BootTimesPrint(void)
+{
+    uint32_t cpu, phase;
+    uint32_t mhz = BootTimerFrequency() / 1000000;
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        volatile uint32_t* times = boot_times[cpu];
+        uint32_t last = times[BOOT_T_START];
+
+        // CPUs that never left the pen (or were not started) have no MMU time
+        if(times[BOOT_T_MMU] == 0)
+        {
+            continue;
+        }
+
+        puts("@boot");
+        putfield("cpu", cpu);
+
+        for(phase = BOOT_T_START + 1; phase < BOOT_PHASES; ++phase)
+        {
+            // Phases the CPU does not run stay 0
+            if(times[phase] != 0)
+            {
+                putfield(BootPhaseNames[phase], times[phase] - last);
+                last = times[phase];
+            }
+        }
+
+        putfield("total", last - times[BOOT_T_START]);
+
+        // Image entry: lz4 stub, then boot loader and load time
+        if(times[BOOT_W_DECOMPRESS] != 0)
+        {
+            putfield("decompress", times[BOOT_W_DECOMPRESS]);
+        }
+
+        if(times[BOOT_W_ENTRY] != 0 && mhz != 0)
+        {
+            putfield("entry_us", times[BOOT_W_ENTRY] / mhz);
+        }
+
+        puts("\n");
+    }
+}
@@ -42,6 +42,7 @@
 #define ABT_BIT			(1<<8)
 #define IRQ_BIT			(1<<7)
 #define FIQ_BIT			(1<<6)
+#define T_BIT			(1<<5)
 
 /* Exported macros ---------------------------------------- */
 
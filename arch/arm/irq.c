@@ -0,0 +1,235 @@
+/**
+ * @file        irq.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Interrupt Controller (GICv1/GICv2)
+ *
+ *              Both boards have the GIC in the private peripheral block
+ *              given by CBAR: the Cortex-A9 MPCore GIC and the GIC-400 of
+ *              the Cortex-A7 cluster only differ in the CPU interface offset.
+ *              The addresses of the device tree are used when there is one.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <irq.h>
+#include <ioremap.h>
+#include <io.h>
+#include <cpu.h>
+#include <platform.h>
+#include <trace.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Offsets from the private peripheral base (CBAR)
+#define GICD_OFFSET         (0x1000)
+#if defined(CORTEX_A9)
+    #define GICC_OFFSET     (0x0100)
+#else
+    #define GICC_OFFSET     (0x2000)
+#endif
+
+// Distributor registers
+#define GICD_CTLR           (0x000)
+#define GICD_TYPER          (0x004)
+#define GICD_ISENABLER      (0x100)
+#define GICD_ICENABLER      (0x180)
+#define GICD_ICPENDR        (0x280)
+#define GICD_IPRIORITYR     (0x400)
+#define GICD_ITARGETSR      (0x800)
+#define GICD_ICFGR          (0xC00)
+#define GICD_SGIR           (0xF00)
+
+// CPU interface registers
+#define GICC_CTLR           (0x00)
+#define GICC_PMR            (0x04)
+#define GICC_BPR            (0x08)
+#define GICC_IAR            (0x0C)
+#define GICC_EOIR           (0x10)
+
+#define GIC_ENABLE          (1)
+#define GIC_PRIORITY        (0xA0)      // Default priority of every interrupt
+#define GIC_PRIORITY_MASK   (0xF0)      // Interrupts below 0xF0 are signaled
+#define GIC_SPURIOUS        (1020)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    irq_handler_t handler;
+    void*         arg;
+}irq_entry_t;
+
+
+/* Private macros ----------------------------------------- */
+
+#define GICD(reg)           ((volatile void*)(gicDist + (reg)))
+#define GICC(reg)           ((volatile void*)(gicCpu + (reg)))
+
+
+/* Private variables -------------------------------------- */
+
+static ulong_t gicDist;
+static ulong_t gicCpu;
+static uint32_t gicLines;
+
+static irq_entry_t irqTable[IRQ_LINES];
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Get the private peripheral base address
+ * @param   None
+ * @retval  Physical address (CBAR)
+ */
+static ulong_t IrqPeripheralBase(void);
+
+
+/* Private functions -------------------------------------- */
+
+ulong_t IrqPeripheralBase(void)
+{
+    ulong_t cbar;
+    asm volatile("mrc   p15, 4, %[_cbar], c15, c0, 0" : [_cbar] "=r" (cbar));
+    return (cbar & 0xFFFF8000);
+}
+
+/**
+ * IrqInit Implementation (See header include/irq.h file for description)
+*/
+int32_t IrqInit(void)
+{
+    const fdt_platform_t* platform = PlatformGet();
+    ulong_t base = IrqPeripheralBase();
+    paddr_t dist = (platform->gicDist != NULL) ? platform->gicDist : (paddr_t)(base + GICD_OFFSET);
+    paddr_t cpu = (platform->gicCpu != NULL) ? platform->gicCpu : (paddr_t)(base + GICC_OFFSET);
+    uint32_t i;
+
+    gicDist = (ulong_t)ioremap(dist, 0x1000);
+    gicCpu = (ulong_t)ioremap(cpu, 0x2000);
+
+    if((gicDist == 0) || (gicCpu == 0))
+    {
+        return E_NO_MEMORY;
+    }
+
+    gicLines = 32 * ((readl_relaxed(GICD(GICD_TYPER)) & 0x1F) + 1);
+    if(gicLines > IRQ_LINES)
+    {
+        gicLines = IRQ_LINES;
+    }
+
+    writel_relaxed(0, GICD(GICD_CTLR));
+
+    // Shared interrupts: disabled, level triggered, default priority, CPU 0
+    for(i = IRQ_SPI_BASE; i < gicLines; i += 32)
+    {
+        writel_relaxed(0xFFFFFFFF, GICD(GICD_ICENABLER + (i / 8)));
+        writel_relaxed(0xFFFFFFFF, GICD(GICD_ICPENDR + (i / 8)));
+    }
+
+    for(i = IRQ_SPI_BASE; i < gicLines; i += 16)
+    {
+        writel_relaxed(0, GICD(GICD_ICFGR + (i / 4)));
+    }
+
+    for(i = IRQ_SPI_BASE; i < gicLines; i += 4)
+    {
+        writel_relaxed(GIC_PRIORITY * 0x01010101U, GICD(GICD_IPRIORITYR + i));
+        writel_relaxed(0x01010101, GICD(GICD_ITARGETSR + i));
+    }
+
+    writel_relaxed(GIC_ENABLE, GICD(GICD_CTLR));
+
+    IrqCpuInit();
+
+    return E_OK;
+}
+
+/**
+ * IrqCpuInit Implementation (See header include/irq.h file for description)
+*/
+void IrqCpuInit(void)
+{
+    uint32_t i;
+
+    // Banked SGIs and PPIs: PPIs disabled, SGIs enabled
+    writel_relaxed(0xFFFF0000, GICD(GICD_ICENABLER));
+    writel_relaxed(0x0000FFFF, GICD(GICD_ISENABLER));
+
+    for(i = 0; i < IRQ_SPI_BASE; i += 4)
+    {
+        writel_relaxed(GIC_PRIORITY * 0x01010101U, GICD(GICD_IPRIORITYR + i));
+    }
+
+    writel_relaxed(GIC_PRIORITY_MASK, GICC(GICC_PMR));
+    writel_relaxed(0, GICC(GICC_BPR));
+    writel(GIC_ENABLE, GICC(GICC_CTLR));
+}
+
+/**
+ * IrqRegister Implementation (See header include/irq.h file for description)
+*/
+int32_t IrqRegister(uint32_t irq, irq_handler_t handler, void* arg)
+{
+    if(irq >= IRQ_LINES)
+    {
+        return E_INVAL;
+    }
+
+    irqTable[irq].arg = arg;
+    irqTable[irq].handler = handler;
+
+    return E_OK;
+}
+
+/**
+ * IrqEnable Implementation (See header include/irq.h file for description)
+*/
+void IrqEnable(uint32_t irq)
+{
+    writel(1 << (irq % 32), GICD(GICD_ISENABLER + ((irq / 32) * 4)));
+}
+
+/**
+ * IrqDisable Implementation (See header include/irq.h file for description)
+*/
+void IrqDisable(uint32_t irq)
+{
+    writel(1 << (irq % 32), GICD(GICD_ICENABLER + ((irq / 32) * 4)));
+}
+
+/**
+ * IrqSendSgi Implementation (See header include/irq.h file for description)
+*/
+void IrqSendSgi(uint32_t sgi, uint32_t cpuMask)
+{
+    // The ordered write makes the caller stores visible before the SGI
+    writel(((cpuMask & 0xFF) << 16) | (sgi & 0xF), GICD(GICD_SGIR));
+}
+
+/**
+ * IrqHandler Implementation (See header include/irq.h file for description)
+*/
+void IrqHandler(void)
+{
+    uint32_t iar, irq;
+
+    while((irq = ((iar = readl_relaxed(GICC(GICC_IAR))) & 0x3FF)) < GIC_SPURIOUS)
+    {
+        TRACE(TRACE_IRQ_ENTRY, irq, 0);
+
+        if((irq < IRQ_LINES) && (irqTable[irq].handler != NULL))
+        {
+            irqTable[irq].handler(irq, irqTable[irq].arg);
+        }
+
+        TRACE(TRACE_IRQ_EXIT, irq, 0);
+
+        writel(iar, GICC(GICC_EOIR));
+    }
+}
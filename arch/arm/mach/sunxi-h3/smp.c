@@ -0,0 +1,104 @@
+/**
+ * @file        smp.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Sunxi Allwiner H3 Secondary CPU Start
+ *
+ *              The secondary cores are powered off at reset: they are
+ *              powered and released through the CPUCFG and PRCM blocks.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <board.h>
+#include <ioremap.h>
+#include <io.h>
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private constants -------------------------------------- */
+
+#define SUNXI_PRCM          (0x01F01400)
+#define SUNXI_CPUCFG        (0x01F01C00)
+
+// CPUCFG registers
+#define CPUCFG_RST_CTRL(n)  (0x40 + ((n) * 0x40))
+#define CPUCFG_GEN_CTRL     (0x184)
+#define CPUCFG_PRIVATE0     (0x1A4)     // Secondary cores start address
+#define CPUCFG_DBG_CTRL1    (0x1E4)
+
+#define CPU_RESET_RELEASE   (0x3)       // Core and debug reset de-asserted
+
+// PRCM registers
+#define PRCM_CPU_PWROFF     (0x100)
+#define PRCM_CPU_CLAMP(n)   (0x140 + ((n) * 4))
+
+// Power clamp release steps
+static const uint8_t ClampSteps[] = {0xFE, 0xF8, 0xE0, 0x80, 0x00};
+
+
+/* Private macros ----------------------------------------- */
+
+#define CPUCFG(reg)         ((volatile void*)((ulong_t)cpucfg + (reg)))
+#define PRCM(reg)           ((volatile void*)((ulong_t)prcm + (reg)))
+
+
+/* Private variables -------------------------------------- */
+
+static void* cpucfg;
+static void* prcm;
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * BoardCpuStart Implementation (See header arch/include/board.h file for description)
+*/
+int32_t BoardCpuStart(uint32_t cpu, paddr_t entry)
+{
+    volatile uint32_t delay;
+    uint32_t i;
+
+    if(cpucfg == NULL)
+    {
+        cpucfg = ioremap(SUNXI_CPUCFG, 0x400);
+        prcm = ioremap(SUNXI_PRCM, 0x200);
+
+        if((cpucfg == NULL) || (prcm == NULL))
+        {
+            return E_NO_MEMORY;
+        }
+    }
+
+    writel((uint32_t)entry, CPUCFG(CPUCFG_PRIVATE0));
+
+    // Hold the core in reset, invalidate its L1 on reset, lock debug access
+    writel_relaxed(0, CPUCFG(CPUCFG_RST_CTRL(cpu)));
+    clrbits(CPUCFG(CPUCFG_GEN_CTRL), 1 << cpu);
+    clrbits(CPUCFG(CPUCFG_DBG_CTRL1), 1 << cpu);
+
+    // Power up
+    for(i = 0; i < sizeof(ClampSteps); ++i)
+    {
+        writel_relaxed(ClampSteps[i], PRCM(PRCM_CPU_CLAMP(cpu)));
+    }
+
+    for(delay = 0; delay < 10000; ++delay)
+    {
+
+    }
+
+    clrbits(PRCM(PRCM_CPU_PWROFF), 1 << cpu);
+
+    // Release the core
+    writel_relaxed(CPU_RESET_RELEASE, CPUCFG(CPUCFG_RST_CTRL(cpu)));
+    setbits(CPUCFG(CPUCFG_DBG_CTRL1), 1 << cpu);
+
+    return E_OK;
+}
\ No newline at end of file
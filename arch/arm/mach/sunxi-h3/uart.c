@@ -9,19 +9,24 @@
 
 /* Includes ----------------------------------------------- */
 #include <serial.h>
+#include <ioremap.h>
+#include <platform.h>
+#include <io.h>
+#include <misc.h>
 
 
 /* Private types ------------------------------------------ */
 
+// Register layout (accessed with io.h)
 typedef struct
 {
-    volatile uint32_t data;	/* 00 - Rx/Tx data */
-    volatile uint32_t ier;	/* 04 - interrupt enables */
-    volatile uint32_t iir;	/* 08 - interrupt ID / FIFO control */
-    volatile uint32_t lcr;	/* 0c - line control */
-    volatile uint32_t mcr;	/* 10 - modem control */
-    volatile uint32_t lsr;	/* 14 - line status */
-    volatile uint32_t msr;	/* 18 - modem status */
+    uint32_t data;	/* 00 - Rx/Tx data */
+    uint32_t ier;	/* 04 - interrupt enables */
+    uint32_t iir;	/* 08 - interrupt ID / FIFO control */
+    uint32_t lcr;	/* 0c - line control */
+    uint32_t mcr;	/* 10 - modem control */
+    uint32_t lsr;	/* 14 - line status */
+    uint32_t msr;	/* 18 - modem status */
 }h3_uart_t;
 
 
@@ -72,6 +77,16 @@ typedef struct
 /* Private variables -------------------------------------- */
 static h3_uart_t* uart;
 
+// 115200 8N1, interrupts disabled
+static const io_seq_t UartSetup[] =
+{
+    {offsetof(h3_uart_t, ier),  0},             // Disable uart interrupts
+    {offsetof(h3_uart_t, lcr),  LCR_DLAB},      // Select dll dlh
+    {offsetof(h3_uart_t, ier),  0},             // DLH
+    {offsetof(h3_uart_t, data), BAUD_115200},   // DLL
+    {offsetof(h3_uart_t, lcr),  LC_8_N_1},      // Line control
+};
+
 
 /* Private function prototypes ---------------------------- */
 
@@ -84,19 +99,19 @@ static h3_uart_t* uart;
 */
 int32_t SerialOpen()
 {
-    // Each UART only has 1Kb memory but the minimum amount of memory we can map is 4Kb
-    // so we will map 4k
-    uart = (h3_uart_t *)(SUNXI_UART0);
-
-    /* Disable uart interrupts*/
-    uart->ier = 0;
-    /* select dll dlh */
-    uart->lcr = LCR_DLAB;
-    /* set baudrate */
-    uart->ier = 0;				// DLH
-    uart->data = BAUD_115200;	// LSB
-    /* set line control */
-    uart->lcr = LC_8_N_1;
+    // Each UART only has 1Kb memory, it shares the section mapping with
+    // the other peripherals in the same 1Mb block
+    paddr_t base = PlatformGet()->uart;
+
+    uart = (h3_uart_t *)ioremap((base != NULL) ? base : (paddr_t)SUNXI_UART0, 0x400);
+
+    if(uart == NULL)
+    {
+        return E_NO_MEMORY;
+    }
+
+    // Register writes to the same device stay in order: one barrier for all
+    writel_seq(uart, UartSetup, sizeof(UartSetup) / sizeof(io_seq_t));
 
     return E_OK;
 }
@@ -114,12 +129,12 @@ int32_t SerialClose()
 */
 int32_t getc()
 {
-    while(!(uart->lsr & RX_READY))
+    while(!(readl_relaxed(&uart->lsr) & RX_READY))
     {
 
     }
 
-    return (int32_t)uart->data;
+    return (int32_t)readl_relaxed(&uart->data);
 }
 
 /**
@@ -175,12 +190,12 @@ char *gets(char *str)
 */
 void putc(char c)
 {
-    while (!(uart->lsr & TX_READY))
+    while (!(readl_relaxed(&uart->lsr) & TX_READY))
     {
 
     }
 
-    uart->data = c;
+    writel_relaxed(c, &uart->data);
 }
 
 /**
@@ -9,28 +9,32 @@
 
 /* Includes ----------------------------------------------- */
 #include <serial.h>
+#include <ioremap.h>
+#include <platform.h>
+#include <io.h>
 
 
 /* Private types ------------------------------------------ */
 
+// Register layout (accessed with io.h)
 typedef struct
 {
-    volatile uint32_t data;                // UART Data Register
-    volatile uint32_t status_error;        // UART Receive Status Register/Error Clear Register
-    const uint32_t reserved1[4];           // Reserved: 16 bytes
-    volatile uint32_t flag;                // UART Flag Register
-    const uint32_t reserved2[1];           // Reserved: 4 bytes
-    volatile uint32_t lp_counter;          // UART Low-power Counter Register
-    volatile uint32_t integer_br;          // UART Integer Baud Rate Register
-    volatile uint32_t fractional_br;       // UART Fractional Baud Rate Register
-    volatile uint32_t line_control;        // UART Line Control Register
-    volatile uint32_t control;             // UART Control Register
-    volatile uint32_t isr_fifo_level_sel;  // UART Interrupt FIFO level Select Register
-    volatile uint32_t isr_mask;            // UART Interrupt Mask Set/Clear Register
-    volatile uint32_t raw_isr_status;      // UART Raw Interrupt Status Register
-    volatile uint32_t masked_isr_status;   // UART Masked Interrupt Status Register
-    volatile uint32_t isr_clear;           // UART Interrupt Clear Register
-    volatile uint32_t DMA_control;         // UART DMA control Register
+    uint32_t data;                // UART Data Register
+    uint32_t status_error;        // UART Receive Status Register/Error Clear Register
+    const uint32_t reserved1[4];  // Reserved: 16 bytes
+    uint32_t flag;                // UART Flag Register
+    const uint32_t reserved2[1];  // Reserved: 4 bytes
+    uint32_t lp_counter;          // UART Low-power Counter Register
+    uint32_t integer_br;          // UART Integer Baud Rate Register
+    uint32_t fractional_br;       // UART Fractional Baud Rate Register
+    uint32_t line_control;        // UART Line Control Register
+    uint32_t control;             // UART Control Register
+    uint32_t isr_fifo_level_sel;  // UART Interrupt FIFO level Select Register
+    uint32_t isr_mask;            // UART Interrupt Mask Set/Clear Register
+    uint32_t raw_isr_status;      // UART Raw Interrupt Status Register
+    uint32_t masked_isr_status;   // UART Masked Interrupt Status Register
+    uint32_t isr_clear;           // UART Interrupt Clear Register
+    uint32_t DMA_control;         // UART DMA control Register
 } pl011_uart;
 
 
@@ -125,7 +129,7 @@ static void UartSetBaudrate();
 void UartDisable()
 {
     /* Clear control configuration */
-    uart->control = 0x00000000;
+    writel_relaxed(0x00000000, &uart->control);
 }
 
 /**
@@ -134,7 +138,7 @@ void UartDisable()
 void UartEnable()
 {
     /* Enable RX */
-    uart->control = (UART_CR_UARTEN | UART_CR_TXE | UART_CR_RXE);
+    writel_relaxed((UART_CR_UARTEN | UART_CR_TXE | UART_CR_RXE), &uart->control);
 }
 
 /**
@@ -161,8 +165,8 @@ void UartSetBaudrate()
     fbrd = (4 * mod) / baud_rate;
 
     /* Set the values of the baudrate divisors */
-    uart->integer_br = ibrd;
-    uart->fractional_br = fbrd;
+    writel_relaxed(ibrd, &uart->integer_br);
+    writel_relaxed(fbrd, &uart->fractional_br);
 }
 
 /**
@@ -170,17 +174,21 @@ void UartSetBaudrate()
 */
 int32_t SerialOpen()
 {
-    uart = (pl011_uart*)(UART_0);
+    // Console of the device tree, UART 0 of the board by default
+    paddr_t base = PlatformGet()->uart;
 
-    int lcrh_reg;
+    uart = (pl011_uart*)ioremap((base != NULL) ? base : (paddr_t)UART_0, PAGE_SIZE);
+
+    if(uart == NULL)
+    {
+        return E_NO_MEMORY;
+    }
 
     /* First, disable everything */
-    uart->control = 0x0;
+    writel_relaxed(0x0, &uart->control);
 
     /* Disable the FIFOs */
-    lcrh_reg = uart->line_control;
-    lcrh_reg &= ~UART_LCR_FEN;
-    uart->line_control = lcrh_reg;
+    clrsetbits_relaxed(&uart->line_control, UART_LCR_FEN, 0);
 
     // Set Baudrate
     UartSetBaudrate();
@@ -188,20 +196,20 @@ int32_t SerialOpen()
     /* Set the UART to be 8 bits, 1 stop bit and no parity
      * FIFOs enable
      */
-    uart->line_control = (UART_LCR_WLEN_8 | UART_LCR_FEN);
+    writel_relaxed((UART_LCR_WLEN_8 | UART_LCR_FEN), &uart->line_control);
 
     /* Enable the UART, enable TX and enable loop back*/
-    uart->control = (UART_CR_UARTEN | UART_CR_TXE | UART_CR_LBE);
+    writel_relaxed((UART_CR_UARTEN | UART_CR_TXE | UART_CR_LBE), &uart->control);
 
-    uart->data = 0x0;
+    writel_relaxed(0x0, &uart->data);
 
-    while(uart->flag & UART_FR_BUSY);
+    while(readl_relaxed(&uart->flag) & UART_FR_BUSY);
 
     /* Enable RX */
     UartEnable();
 
     /* Clear interrupts */
-    uart->isr_clear = (UART_ICR_OEIC | UART_ICR_BEIC | UART_ICR_PEIC | UART_ICR_FEIC);
+    writel_relaxed((UART_ICR_OEIC | UART_ICR_BEIC | UART_ICR_PEIC | UART_ICR_FEIC), &uart->isr_clear);
 
     return E_OK;
 }
@@ -225,12 +233,12 @@ int32_t getc()
     uint32_t data = 0;
 
     //wait until there is data in FIFO
-    while(uart->flag & UART_FR_RXFE)
+    while(readl_relaxed(&uart->flag) & UART_FR_RXFE)
     {
 
     }
 
-    data = uart->data;
+    data = readl_relaxed(&uart->data);
 
     return data;
 }
@@ -289,12 +297,12 @@ char *gets(char *str)
 void putc(char c)
 {
     //wait until txFIFO is not full
-    while(uart->flag & UART_FR_TXFF)
+    while(readl_relaxed(&uart->flag) & UART_FR_TXFF)
     {
 
     }
 
-    uart->data = c;
+    writel_relaxed(c, &uart->data);
 }
 
 /**
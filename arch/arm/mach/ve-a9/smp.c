@@ -0,0 +1,43 @@
+/**
+ * @file        smp.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       VE Secondary CPU Start
+ *
+ *              The model and QEMU start every core at the image entry:
+ *              the secondary cores already wait in the boot.S pen.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <board.h>
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * BoardCpuStart Implementation (See header arch/include/board.h file for description)
+*/
+int32_t BoardCpuStart(uint32_t cpu, paddr_t entry)
+{
+    (void)cpu;
+    (void)entry;
+
+    return E_OK;
+}
\ No newline at end of file
@@ -10,6 +10,10 @@
 /* Includes ----------------------------------------------- */
 #include <mmu.h>
 #include <misc.h>
+#include <slab.h>
+#include <page.h>
+#include <tlb.h>
+#include <trace.h>
 
 
 /* Private types ------------------------------------------ */
@@ -31,6 +35,17 @@
 #define LARGE_PAGE_SIZE     0x10000
 #define SMALL_PAGE_SIZE     0x1000
 
+// L2 page table size and entries
+#define L2_PGT_SIZE         0x400
+#define L2_PGT_ENTRIES      256
+
+// User L1 page table entries and allocation order (8Kb, 8Kb aligned)
+#define USER_PGT_ENTRIES    (USER_PGT_SIZE / sizeof(ulong_t))
+#define USER_PGT_ORDER      1
+
+// Table walk attributes (same as the kernel tables set in boot.S)
+#define TTB_FLAGS           0x6A
+
 // MMU L1 Entry Flags
 #define MMU_L1_B        (1 << 2)    // pte[2]     -> B   - Write Buffer
 #define MMU_L1_C        (1 << 3)    // pte[3]     -> C   - Cache
@@ -74,6 +89,11 @@
 
 
 /* Private variables -------------------------------------- */
+
+// L2 page tables are only released when all entries are invalid,
+// so the cache objects stay in the constructed (zeroed) state
+static slab_cache_t* l2pgtCache;
+
 static ulong_t L1CacheCfgs[] =
 {                                       // TEX[2:0] C B
     (0x0),                              //  0 0 0   0 0 -> Strongly-ordered
@@ -172,6 +192,28 @@ inline static ulong_t GetL2_S_PteFlags(memCfg_t* memCfg)
     return flags;
 }
 
+static void MMU_ZeroL2PGT(void* l2pgt)
+{
+    uint32_t i;
+    for(i = 0; i < L2_PGT_ENTRIES; ++i)
+    {
+        ((ulong_t*)l2pgt)[i] = FAULT;
+    }
+}
+
+inline static bool_t MMU_L2PGTIsEmpty(ulong_t* l2pgt)
+{
+    uint32_t i;
+    for(i = 0; i < L2_PGT_ENTRIES; ++i)
+    {
+        if(l2pgt[i] != FAULT)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 void MMU_Map16MbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg)
 {
     // Get Page Table Entry flags
@@ -242,14 +284,34 @@ void MMU_Map4KbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, m
 
 void MMU_AttachL2PGT(ulong_t* pgt, ulong_t* l2pgt, ulong_t vaddr)
 {
-    // Get page table entry
-    pgt += ((vaddr & 0xFFF00000) >> 18);
+    // Get page table entry (one word per 1Mb section)
+    pgt += (vaddr >> 20);
 
     // Set entry
     // Note: l2pgt is virtual address so we need to convert it to physical address
     *pgt = (((ulong_t)(MMU_L2P((vaddr_t)l2pgt)) & 0xfffffc00) | L2_PGT);
 }
 
+ulong_t* MMU_AllocL2PGT(void)
+{
+    if(l2pgtCache == NULL)
+    {
+        l2pgtCache = SlabCacheCreate("l2pgt", L2_PGT_SIZE, L2_PGT_SIZE, MMU_ZeroL2PGT);
+
+        if(l2pgtCache == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    return (ulong_t*)SlabAlloc(l2pgtCache);
+}
+
+void MMU_FreeL2PGT(ulong_t* l2pgt)
+{
+    SlabFree(l2pgtCache, l2pgt);
+}
+
 /* Private functions -------------------------------------- */
 
 /**
@@ -281,36 +343,73 @@ pgt_t MMU_UserPGT(void)
 */
 void MMU_MapPages(pgt_t pgt, vaddr_t vaddr, pbv_t* pages, size_t count, memCfg_t* memCfg)
 {
-    // All pars of addresses and sizes are assumed to have the same alignment
-    // No virtual addresses colision will be check since it is assumed that this was done by a Virtual Space Manager
+    // Each chunk uses the largest granule its virtual and physical addresses
+    // are both aligned to
+    // No virtual addresses colision will be check since it is assumed that this was done by a Virtual Space Manager (virtual/)
 
     ulong_t v_addr = (ulong_t)vaddr;
     uint32_t i;
     for(i = 0; i < count; v_addr += pages[i++].size)
     {
-        if((pages[i].size >= LARGE_SECTION_SIZE) && !(v_addr & (LARGE_SECTION_SIZE - 1)))
+        size_t map_size;
+        // A granule needs both addresses aligned: the entry only holds the
+        // upper bits of the physical address
+        ulong_t align = v_addr | (ulong_t)pages[i].data;
+
+        if((pages[i].size >= LARGE_SECTION_SIZE) && !(align & (LARGE_SECTION_SIZE - 1)))
         {
-            MMU_Map16MbPages((ulong_t*)pgt, (ulong_t)pages[i].data, v_addr, pages[i].size / LARGE_SECTION_SIZE, memCfg);
+            map_size = ROUND_DOWN(pages[i].size, LARGE_SECTION_SIZE);
+            MMU_Map16MbPages((ulong_t*)pgt, (ulong_t)pages[i].data, v_addr, map_size / LARGE_SECTION_SIZE, memCfg);
         }
-        else if((pages[i].size >= SECTION_SIZE) && !(v_addr & (SECTION_SIZE - 1)))
+        else if((pages[i].size >= SECTION_SIZE) && !(align & (SECTION_SIZE - 1)))
         {
-            MMU_Map1MbPages((ulong_t*)pgt, (ulong_t)pages[i].data, v_addr, pages[i].size / SECTION_SIZE, memCfg);
+            map_size = ROUND_DOWN(pages[i].size, SECTION_SIZE);
+
+            // Stop at the next 16MB boundary so the rest can use supersections
+            // (only if the physical address reaches a 16MB boundary there too)
+            if((v_addr & (LARGE_SECTION_SIZE - 1)) && !((v_addr ^ (ulong_t)pages[i].data) & (LARGE_SECTION_SIZE - 1)) &&
+               (map_size > (LARGE_SECTION_SIZE - (v_addr & (LARGE_SECTION_SIZE - 1)))))
+            {
+                map_size = LARGE_SECTION_SIZE - (v_addr & (LARGE_SECTION_SIZE - 1));
+            }
+
+            MMU_Map1MbPages((ulong_t*)pgt, (ulong_t)pages[i].data, v_addr, map_size / SECTION_SIZE, memCfg);
         }
         else
         {
             // Check if we already have a L2 Page Table
-            pgt_t l2pgt = NULL;
+            ulong_t* l1pte = &((ulong_t*)pgt)[v_addr >> 20];
+            ulong_t* l2pgt;
+            bool_t attach = FALSE;
+
+            if((*l1pte & 0x3) == L2_PGT)
+            {
+                l2pgt = (ulong_t*)MMU_P2L((paddr_t)(*l1pte & 0xFFFFFC00));
+            }
+            else
+            {
+                l2pgt = MMU_AllocL2PGT();
+
+                if(l2pgt == NULL)
+                {
+                    // Out of memory: the remaining pages are left unmapped
+                    break;
+                }
+
+                attach = TRUE;
+            }
 
             // Check if we don't exceed the 1MB boundary
-            size_t map_size = pages[i].size;
+            map_size = pages[i].size;
 
             if(((v_addr & (SECTION_SIZE - 1)) + pages[i].size) > SECTION_SIZE)
             {
                 map_size = SECTION_SIZE - (v_addr & (SECTION_SIZE - 1));
             }
 
-            if((map_size >= LARGE_PAGE_SIZE) && !(v_addr & (LARGE_PAGE_SIZE - 1)))
+            if((map_size >= LARGE_PAGE_SIZE) && !(align & (LARGE_PAGE_SIZE - 1)))
             {
+                map_size = ROUND_DOWN(map_size, LARGE_PAGE_SIZE);
                 MMU_Map64KbPages((ulong_t*)l2pgt, (ulong_t)pages[i].data, v_addr, map_size / LARGE_PAGE_SIZE, memCfg);
             }
             else
@@ -318,14 +417,257 @@ void MMU_MapPages(pgt_t pgt, vaddr_t vaddr, pbv_t* pages, size_t count, memCfg_t
                 MMU_Map4KbPages((ulong_t*)l2pgt, (ulong_t)pages[i].data, v_addr, map_size / SMALL_PAGE_SIZE, memCfg);
             }
 
-            // Is there is leftovers let MMU_MapPages decide how to map it
-            if(map_size < pages[i].size)
+            // Attach once populated so the walker never sees a partial table
+            if(attach)
+            {
+                MMU_AttachL2PGT((ulong_t*)pgt, l2pgt, v_addr);
+            }
+        }
+
+        // Is there is leftovers let MMU_MapPages decide how to map it
+        if(map_size < pages[i].size)
+        {
+            pbv_t page = {(ptr_t)((ulong_t)pages[i].data + map_size), pages[i].size - map_size};
+            MMU_MapPages(pgt, (vaddr_t)(v_addr + map_size), &page, 1, memCfg);
+        }
+    }
+
+    // New entries must be visible to the table walker before they are used
+    asm volatile("dsb\n\tisb" ::: "memory");
+
+    TRACE(TRACE_MMU_MAP, vaddr, v_addr - (ulong_t)vaddr);
+}
+
+/**
+ * MMU_UnmapPages Implementation (See arch/include/mmu.h for description)
+*/
+void MMU_UnmapPages(pgt_t pgt, vaddr_t vaddr, size_t size)
+{
+    // The range is assumed to match the granularity used to map it (as in MMU_MapPages)
+
+    ulong_t v_addr = (ulong_t)vaddr & ~(SMALL_PAGE_SIZE - 1);
+    ulong_t v_end = ROUND_UP((ulong_t)vaddr + size, SMALL_PAGE_SIZE);
+    ulong_t* l1pgt = (ulong_t*)pgt;
+    uint32_t i;
+
+    TRACE(TRACE_MMU_UNMAP, vaddr, size);
+
+    // Cores that do not broadcast get one shootdown for the whole range
+    TlbBatchBegin();
+
+    while(v_addr < v_end)
+    {
+        ulong_t* pte = &l1pgt[v_addr >> 20];
+        ulong_t next = ROUND_DOWN(v_addr, SECTION_SIZE) + SECTION_SIZE;
+
+        if((*pte & SUPERSECTION) == SUPERSECTION)
+        {
+            // Supersection entries are replicated 16 times
+            pte = &l1pgt[(v_addr >> 20) & ~0xF];
+            for(i = 0; i < 16; ++i)
+            {
+                pte[i] = FAULT;
+            }
+            next = ROUND_DOWN(v_addr, LARGE_SECTION_SIZE) + LARGE_SECTION_SIZE;
+            TlbInvalidatePage(v_addr);
+        }
+        else if((*pte & 0x3) == SECTION)
+        {
+            *pte = FAULT;
+            TlbInvalidatePage(v_addr);
+        }
+        else if((*pte & 0x3) == L2_PGT)
+        {
+            ulong_t* l2pgt = (ulong_t*)MMU_P2L((paddr_t)(*pte & 0xFFFFFC00));
+            ulong_t section = ROUND_DOWN(v_addr, SECTION_SIZE);
+
+            if(next > v_end)
+            {
+                next = v_end;
+            }
+
+            while(v_addr < next)
+            {
+                ulong_t* l2pte = &l2pgt[(v_addr & 0xFF000) >> 12];
+
+                if((*l2pte & 0x3) == LARGEPAGE)
+                {
+                    // Large page entries are replicated 16 times
+                    l2pte = &l2pgt[((v_addr & 0xFF000) >> 12) & ~0xF];
+                    for(i = 0; i < 16; ++i)
+                    {
+                        l2pte[i] = FAULT;
+                    }
+                    TlbInvalidatePage(v_addr);
+                    v_addr = ROUND_DOWN(v_addr, LARGE_PAGE_SIZE) + LARGE_PAGE_SIZE;
+                }
+                else
+                {
+                    if(*l2pte != FAULT)
+                    {
+                        *l2pte = FAULT;
+                        TlbInvalidatePage(v_addr);
+                    }
+                    v_addr += SMALL_PAGE_SIZE;
+                }
+            }
+
+            if(MMU_L2PGTIsEmpty(l2pgt))
             {
-                pbv_t page = {(ptr_t)((ulong_t)pages[i].data + map_size), pages[i].size - map_size};
-                MMU_MapPages(pgt, (vaddr_t)(v_addr + map_size), &page, 1, memCfg);
+                // Detach the L2 page table so no walk cache keeps pointing to it
+                *pte = FAULT;
+                TlbInvalidatePage(section);
+                asm volatile("dsb" ::: "memory");
+                TlbSync();
+                MMU_FreeL2PGT(l2pgt);
             }
+            continue;
+        }
+
+        v_addr = next;
+    }
+
+    asm volatile("dsb\n\tisb" ::: "memory");
+
+    TlbBatchEnd();
+}
+
+/**
+ * MMU_AllocPGT Implementation (See arch/include/mmu.h for description)
+*/
+pgt_t MMU_AllocPGT(void)
+{
+    paddr_t paddr = PageAlloc(USER_PGT_ORDER);
+    ulong_t* pgt;
+    uint32_t i;
+
+    if(paddr == NULL)
+    {
+        return NULL;
+    }
+
+    pgt = (ulong_t*)MMU_P2L(paddr);
+
+    for(i = 0; i < USER_PGT_ENTRIES; ++i)
+    {
+        pgt[i] = FAULT;
+    }
+
+    asm volatile("dsb" ::: "memory");
+
+    return (pgt_t)pgt;
+}
+
+/**
+ * MMU_FreePGT Implementation (See arch/include/mmu.h for description)
+*/
+void MMU_FreePGT(pgt_t pgt)
+{
+    PageFree(MMU_L2P((vaddr_t)pgt), USER_PGT_ORDER);
+}
+
+/**
+ * MMU_InvalidatePGT Implementation (See arch/include/mmu.h for description)
+*/
+void MMU_InvalidatePGT(pgt_t pgt)
+{
+    ulong_t* l1pgt = (ulong_t*)pgt;
+    uint32_t i;
+
+    // The mapped pages belong to the caller, only the tables are released.
+    // TLB entries are tagged with the ASID of the page table owner, which
+    // invalidates them by ASID (MMU_InvalidateASID)
+    for(i = 0; i < USER_PGT_ENTRIES; ++i)
+    {
+        if((l1pgt[i] & 0x3) == L2_PGT)
+        {
+            ulong_t* l2pgt = (ulong_t*)MMU_P2L((paddr_t)(l1pgt[i] & 0xFFFFFC00));
+
+            l1pgt[i] = FAULT;
+            MMU_ZeroL2PGT(l2pgt);
+            MMU_FreeL2PGT(l2pgt);
+        }
+        else
+        {
+            l1pgt[i] = FAULT;
         }
     }
+
+    asm volatile("dsb" ::: "memory");
+}
+
+/**
+ * MMU_SetUserPGT Implementation (See arch/include/mmu.h for description)
+*/
+void MMU_SetUserPGT(pgt_t pgt, uint32_t asid)
+{
+    // Switch through the reserved ASID 0 (as ContextSwitch in kernel.S)
+    asm volatile("mcr   p15, 0, %[_zero], c13, c0, 1\n\t"
+                 "isb\n\t"
+                 "mcr   p15, 0, %[_ttbr], c2, c0, 0\n\t"
+                 "isb\n\t"
+                 "mcr   p15, 0, %[_asid], c13, c0, 1\n\t"
+                 "isb"
+                 :: [_zero] "r" (0), [_ttbr] "r" (MMU_UserTTBR(pgt)), [_asid] "r" (asid) : "memory");
+}
+
+/**
+ * MMU_UserTTBR Implementation (See arch/include/mmu.h for description)
+*/
+ulong_t MMU_UserTTBR(pgt_t pgt)
+{
+    return ((ulong_t)MMU_L2P((vaddr_t)pgt) | TTB_FLAGS);
+}
+
+/**
+ * MMU_InvalidateASID Implementation (See arch/include/mmu.h for description)
+*/
+void MMU_InvalidateASID(uint32_t asid)
+{
+    // TLBIASIDIS
+    asm volatile("dsb   ishst\n\t"
+                 "mcr   p15, 0, %[_asid], c8, c3, 2\n\t"
+                 "dsb   ish\n\t"
+                 "isb"
+                 :: [_asid] "r" (asid & 0xFF) : "memory");
+}
+
+/**
+ * MMU_V2P Implementation (See arch/include/mmu.h for description)
+*/
+paddr_t MMU_V2P(pgt_t pgt, vaddr_t vaddr)
+{
+    ulong_t v_addr = (ulong_t)vaddr;
+    ulong_t pte = ((ulong_t*)pgt)[v_addr >> 20];
+
+    if((pte & SUPERSECTION) == SUPERSECTION)
+    {
+        return (paddr_t)((pte & 0xFF000000) | (v_addr & (LARGE_SECTION_SIZE - 1)));
+    }
+
+    if((pte & 0x3) == SECTION)
+    {
+        return (paddr_t)((pte & 0xFFF00000) | (v_addr & (SECTION_SIZE - 1)));
+    }
+
+    if((pte & 0x3) != L2_PGT)
+    {
+        return NULL;
+    }
+
+    pte = ((ulong_t*)MMU_P2L((paddr_t)(pte & 0xFFFFFC00)))[(v_addr & 0xFF000) >> 12];
+
+    if((pte & 0x3) == LARGEPAGE)
+    {
+        return (paddr_t)((pte & 0xFFFF0000) | (v_addr & (LARGE_PAGE_SIZE - 1)));
+    }
+
+    if(pte & SMALLPAGE)
+    {
+        return (paddr_t)((pte & 0xFFFFF000) | (v_addr & (SMALL_PAGE_SIZE - 1)));
+    }
+
+    return NULL;
 }
 
 /**
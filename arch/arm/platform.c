@@ -0,0 +1,120 @@
+/**
+ * @file        platform.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Platform Discovery (Device Tree)
+ *
+ *              boot.S saves r2 of the boot CPU (the physical address of the
+ *              device tree blob) before anything else uses it. The blob is
+ *              parsed before the page allocator exists, so it is read in
+ *              place through its logical address: the sections it spans
+ *              are mapped for the walk only and unmapped afterwards (the
+ *              page allocator maps the RAM for good and reuses the blob).
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <platform.h>
+#include <page.h>
+#include <mmu.h>
+#include <misc.h>
+#include <string.h>
+
+
+/* Private constants -------------------------------------- */
+
+#define SECTION_SIZE            (0x100000)
+
+// Sections mapped for the walk: blobs up to 1Mb, at any offset
+#define PLATFORM_FDT_SECTIONS   (2)
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+// Set in boot.S: r2 of the boot CPU at entry
+extern ulong_t boot_fdt;
+
+static fdt_platform_t platform;
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * PlatformInit Implementation (See header arch/include/platform.h file for description)
+*/
+int32_t PlatformInit(void)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    ulong_t* pgt = (ulong_t*)MMU_P2L(MMU_KernelPGT());
+    ulong_t ramStart = (ulong_t)MMU_KernelPGT();
+    ulong_t blob = boot_fdt;
+    ulong_t first = ROUND_DOWN(blob, SECTION_SIZE);
+    ulong_t vaddr = (ulong_t)MMU_P2L((paddr_t)first);
+    ulong_t saved[PLATFORM_FDT_SECTIONS];
+    int32_t status = E_INVAL;
+    uint32_t i;
+
+    // Only the RAM after the kernel page table has a logical address
+    if((blob < ramStart) || ((first - ramStart) > (PAGE_LOGICAL_MAX - (PLATFORM_FDT_SECTIONS * SECTION_SIZE))))
+    {
+        return E_INVAL;
+    }
+
+    // Sections already mapped (boot mapping of the image) are left as they are
+    for(i = 0; i < PLATFORM_FDT_SECTIONS; ++i)
+    {
+        saved[i] = pgt[(vaddr >> 20) + i];
+
+        if(saved[i] == 0)
+        {
+            MMU_Map1MbPages(pgt, first + (i * SECTION_SIZE), vaddr + (i * SECTION_SIZE), 1, &memCfg);
+        }
+    }
+    asm volatile("dsb\n\tisb" ::: "memory");
+
+    const void* fdt = (const void*)(vaddr + (blob - first));
+    size_t size = FdtSize(fdt);
+
+    if((size != 0) && (((blob - first) + size) <= (PLATFORM_FDT_SECTIONS * SECTION_SIZE)))
+    {
+        status = FdtParse(fdt, &platform);
+    }
+
+    if(status != E_OK)
+    {
+        memset(&platform, 0, sizeof(platform));
+    }
+
+    // Only the boot CPU runs: local invalidation of the walk mappings
+    for(i = 0; i < PLATFORM_FDT_SECTIONS; ++i)
+    {
+        if(saved[i] == 0)
+        {
+            pgt[(vaddr >> 20) + i] = 0;
+            asm volatile("dsb   ishst\n\t"
+                         "mcr   p15, 0, %[_vaddr], c8, c7, 3"   // TLBIMVAA
+                         :: [_vaddr] "r" (vaddr + (i * SECTION_SIZE)) : "memory");
+        }
+    }
+    asm volatile("dsb\n\tisb" ::: "memory");
+
+    return status;
+}
+
+/**
+ * PlatformGet Implementation (See header arch/include/platform.h file for description)
+*/
+const fdt_platform_t* PlatformGet(void)
+{
+    return &platform;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file        timer.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Per-CPU Tick Timer
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <timer.h>
+#include <irq.h>
+#include <ioremap.h>
+#include <io.h>
+#include <platform.h>
+
+
+/* Private constants -------------------------------------- */
+
+#if defined(CORTEX_A9)
+    // MPCore private timer (PPI 29), clocked by PERIPHCLK
+    #define TIMER_IRQ           (29)
+    #define TIMER_OFFSET        (0x600)
+    #ifndef TIMER_PERIPHCLK
+        #define TIMER_PERIPHCLK (200000000)
+    #endif
+
+    #define TIMER_LOAD          (0x00)
+    #define TIMER_CONTROL       (0x08)
+    #define TIMER_ISR           (0x0C)
+
+    #define TIMER_CTRL_ENABLE   (1 << 0)
+    #define TIMER_CTRL_RELOAD   (1 << 1)
+    #define TIMER_CTRL_IRQ      (1 << 2)
+#else
+    // Generic timer, virtual timer (PPI 27): usable in secure and non-secure state
+    #define TIMER_IRQ           (27)
+    #define CNTV_CTL_ENABLE     (1 << 0)
+#endif
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static timer_tick_t tickHandler;
+static uint32_t tickPeriod;
+
+#if defined(CORTEX_A9)
+static ulong_t timerBase;
+#endif
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Timer interrupt handler: acknowledges the timer and runs the tick
+ * @param   irq - Interrupt ID
+ *          arg - Not used
+ * @retval  No return
+ */
+static void TimerIrq(uint32_t irq, void* arg);
+
+
+/* Private functions -------------------------------------- */
+
+void TimerIrq(uint32_t irq, void* arg)
+{
+#if defined(CORTEX_A9)
+    writel_relaxed(1, (volatile void*)(timerBase + TIMER_ISR));
+#else
+    // Next tick relative to this one (CNTV_TVAL)
+    asm volatile("mcr   p15, 0, %[_tval], c14, c3, 0" :: [_tval] "r" (tickPeriod));
+#endif
+
+    tickHandler();
+}
+
+/**
+ * TimerInit Implementation (See header include/timer.h file for description)
+*/
+int32_t TimerInit(uint32_t hz, timer_tick_t tick)
+{
+    const fdt_platform_t* platform = PlatformGet();
+
+#if defined(CORTEX_A9)
+    ulong_t cbar;
+    asm volatile("mrc   p15, 4, %[_cbar], c15, c0, 0" : [_cbar] "=r" (cbar));
+
+    paddr_t base = (platform->timer != NULL) ? platform->timer : (paddr_t)((cbar & 0xFFFF8000) + TIMER_OFFSET);
+    timerBase = (ulong_t)ioremap(base, 0x100);
+
+    if(timerBase == 0)
+    {
+        return E_NO_MEMORY;
+    }
+
+    tickPeriod = (TIMER_PERIPHCLK / hz) - 1;
+#else
+    uint32_t frequency;
+    asm volatile("mrc   p15, 0, %[_freq], c14, c0, 0" : [_freq] "=r" (frequency));
+
+    // Firmware that does not program CNTFRQ gives it in the device tree
+    if(platform->timerFrequency != 0)
+    {
+        frequency = platform->timerFrequency;
+    }
+
+    tickPeriod = frequency / hz;
+#endif
+
+    tickHandler = tick;
+    IrqRegister(TIMER_IRQ, TimerIrq, NULL);
+
+    TimerCpuInit();
+
+    return E_OK;
+}
+
+/**
+ * TimerCpuInit Implementation (See header include/timer.h file for description)
+*/
+void TimerCpuInit(void)
+{
+#if defined(CORTEX_A9)
+    writel_relaxed(0, (volatile void*)(timerBase + TIMER_CONTROL));
+    writel_relaxed(1, (volatile void*)(timerBase + TIMER_ISR));
+    writel_relaxed(tickPeriod, (volatile void*)(timerBase + TIMER_LOAD));
+    writel_relaxed(TIMER_CTRL_ENABLE | TIMER_CTRL_RELOAD | TIMER_CTRL_IRQ, (volatile void*)(timerBase + TIMER_CONTROL));
+#else
+    asm volatile("mcr   p15, 0, %[_tval], c14, c3, 0\n\t"
+                 "mcr   p15, 0, %[_ctl], c14, c3, 1\n\t"
+                 "isb" :: [_tval] "r" (tickPeriod), [_ctl] "r" (CNTV_CTL_ENABLE));
+#endif
+
+    IrqEnable(TIMER_IRQ);
+}
@@ -0,0 +1,305 @@
+/**
+ * @file        atomic.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       ARMv7-A Atomic Operations and SMP Barriers Header File
+ *
+ *              Read-modify-write operations are LDREX/STREX loops. They do
+ *              not imply any ordering: callers that publish or consume data
+ *              through an atomic add the smp_* barriers they need
+ *              (the *_Ordered variants wrap the operation with smp_mb).
+*/
+
+#ifndef _ATOMIC_H_
+#define _ATOMIC_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    volatile int32_t counter;
+}atomic_t;
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+#define ATOMIC_INIT(value)  {(value)}
+
+// Memory barriers between CPUs (inner shareable domain)
+#define smp_mb()            asm volatile("dmb   ish" ::: "memory")
+#define smp_rmb()           asm volatile("dmb   ish" ::: "memory")
+#define smp_wmb()           asm volatile("dmb   ishst" ::: "memory")
+
+// Compiler barrier
+#define barrier()           asm volatile("" ::: "memory")
+
+// Low power wait for an event (SEV or exclusive monitor cleared)
+#define wfe()               asm volatile("wfe" ::: "memory")
+#define sev()               asm volatile("dsb   ishst\n\tsev" ::: "memory")
+
+#define READ_ONCE(x)        (*(const volatile typeof(x)*)&(x))
+#define WRITE_ONCE(x, v)    (*(volatile typeof(x)*)&(x) = (v))
+
+
+/* Exported functions ------------------------------------- */
+
+static inline int32_t Atomic_Read(const atomic_t* v)
+{
+    return v->counter;
+}
+
+static inline void Atomic_Set(atomic_t* v, int32_t value)
+{
+    v->counter = value;
+}
+
+/**
+ * @brief   Adds to an atomic counter
+ * @param   v - Atomic counter
+ *          value - Value to add
+ * @retval  New counter value
+ */
+static inline int32_t Atomic_AddReturn(atomic_t* v, int32_t value)
+{
+    int32_t result;
+    uint32_t failed;
+
+    asm volatile(
+        "1: ldrex   %[_result], [%[_ptr]]           \n\t"
+        "   add     %[_result], %[_result], %[_val] \n\t"
+        "   strex   %[_failed], %[_result], [%[_ptr]]\n\t"
+        "   teq     %[_failed], #0                  \n\t"
+        "   bne     1b                              \n\t"
+        : [_result] "=&r" (result), [_failed] "=&r" (failed), "+Qo" (v->counter)
+        : [_ptr] "r" (&v->counter), [_val] "Ir" (value)
+        : "cc");
+
+    return result;
+}
+
+/**
+ * @brief   Adds to a 32 bit word
+ * @param   ptr - Word address
+ *          value - Value to add
+ * @retval  Value before the addition
+ */
+static inline uint32_t Atomic_FetchAdd32(volatile uint32_t* ptr, uint32_t value)
+{
+    uint32_t result, updated, failed;
+
+    asm volatile(
+        "1: ldrex   %[_result], [%[_ptr]]           \n\t"
+        "   add     %[_new], %[_result], %[_val]    \n\t"
+        "   strex   %[_failed], %[_new], [%[_ptr]]  \n\t"
+        "   teq     %[_failed], #0                  \n\t"
+        "   bne     1b                              \n\t"
+        : [_result] "=&r" (result), [_new] "=&r" (updated), [_failed] "=&r" (failed), "+Qo" (*ptr)
+        : [_ptr] "r" (ptr), [_val] "r" (value)
+        : "cc");
+
+    return result;
+}
+
+/**
+ * @brief   Compares and exchanges a 32 bit word
+ * @param   ptr - Word address
+ *          old - Expected value
+ *          value - New value, stored only if the word holds old
+ * @retval  Value read (equal to old on success)
+ */
+static inline uint32_t Atomic_CmpXchg32(volatile uint32_t* ptr, uint32_t old, uint32_t value)
+{
+    uint32_t result, failed;
+
+    do
+    {
+        asm volatile(
+            "   ldrex   %[_result], [%[_ptr]]           \n\t"
+            "   mov     %[_failed], #0                  \n\t"
+            "   teq     %[_result], %[_old]             \n\t"
+            "   strexeq %[_failed], %[_val], [%[_ptr]]  \n\t"
+            : [_result] "=&r" (result), [_failed] "=&r" (failed), "+Qo" (*ptr)
+            : [_ptr] "r" (ptr), [_old] "r" (old), [_val] "r" (value)
+            : "cc");
+    }while(failed);
+
+    return result;
+}
+
+/**
+ * @brief   Exchanges a 32 bit word
+ * @param   ptr - Word address
+ *          value - New value
+ * @retval  Previous value
+ */
+static inline uint32_t Atomic_Xchg32(volatile uint32_t* ptr, uint32_t value)
+{
+    uint32_t result, failed;
+
+    asm volatile(
+        "1: ldrex   %[_result], [%[_ptr]]           \n\t"
+        "   strex   %[_failed], %[_val], [%[_ptr]]  \n\t"
+        "   teq     %[_failed], #0                  \n\t"
+        "   bne     1b                              \n\t"
+        : [_result] "=&r" (result), [_failed] "=&r" (failed), "+Qo" (*ptr)
+        : [_ptr] "r" (ptr), [_val] "r" (value)
+        : "cc");
+
+    return result;
+}
+
+/**
+ * @brief   Applies a bitwise operation to a word
+ * @param   ptr - Word address
+ *          clr - Bits cleared
+ *          set - Bits set (after clearing)
+ * @retval  Previous value
+ */
+static inline uint32_t Atomic_ClrSet32(volatile uint32_t* ptr, uint32_t clr, uint32_t set)
+{
+    uint32_t result, updated, failed;
+
+    asm volatile(
+        "1: ldrex   %[_result], [%[_ptr]]           \n\t"
+        "   bic     %[_new], %[_result], %[_clr]    \n\t"
+        "   orr     %[_new], %[_new], %[_set]       \n\t"
+        "   strex   %[_failed], %[_new], [%[_ptr]]  \n\t"
+        "   teq     %[_failed], #0                  \n\t"
+        "   bne     1b                              \n\t"
+        : [_result] "=&r" (result), [_new] "=&r" (updated), [_failed] "=&r" (failed), "+Qo" (*ptr)
+        : [_ptr] "r" (ptr), [_clr] "r" (clr), [_set] "r" (set)
+        : "cc");
+
+    return result;
+}
+
+static inline void Atomic_Add(atomic_t* v, int32_t value)
+{
+    (void)Atomic_AddReturn(v, value);
+}
+
+static inline void Atomic_Sub(atomic_t* v, int32_t value)
+{
+    (void)Atomic_AddReturn(v, -value);
+}
+
+// Inc/Dec return the new value (e.g. reference count reaching 0)
+static inline int32_t Atomic_Inc(atomic_t* v)
+{
+    return Atomic_AddReturn(v, 1);
+}
+
+static inline int32_t Atomic_Dec(atomic_t* v)
+{
+    return Atomic_AddReturn(v, -1);
+}
+
+// Value before the addition
+static inline int32_t Atomic_FetchAdd(atomic_t* v, int32_t value)
+{
+    return (int32_t)Atomic_FetchAdd32((volatile uint32_t*)&v->counter, (uint32_t)value);
+}
+
+static inline int32_t Atomic_CmpXchg(atomic_t* v, int32_t old, int32_t value)
+{
+    return (int32_t)Atomic_CmpXchg32((volatile uint32_t*)&v->counter, (uint32_t)old, (uint32_t)value);
+}
+
+static inline int32_t Atomic_Xchg(atomic_t* v, int32_t value)
+{
+    return (int32_t)Atomic_Xchg32((volatile uint32_t*)&v->counter, (uint32_t)value);
+}
+
+static inline void* Atomic_XchgPtr(void* volatile* ptr, void* value)
+{
+    return (void*)Atomic_Xchg32((volatile uint32_t*)ptr, (uint32_t)value);
+}
+
+static inline void* Atomic_CmpXchgPtr(void* volatile* ptr, void* old, void* value)
+{
+    return (void*)Atomic_CmpXchg32((volatile uint32_t*)ptr, (uint32_t)old, (uint32_t)value);
+}
+
+/* Ordered variants (full barrier before and after) ------- */
+
+static inline int32_t Atomic_AddReturnOrdered(atomic_t* v, int32_t value)
+{
+    int32_t result;
+
+    smp_mb();
+    result = Atomic_AddReturn(v, value);
+    smp_mb();
+
+    return result;
+}
+
+static inline int32_t Atomic_CmpXchgOrdered(atomic_t* v, int32_t old, int32_t value)
+{
+    int32_t result;
+
+    smp_mb();
+    result = Atomic_CmpXchg(v, old, value);
+    smp_mb();
+
+    return result;
+}
+
+/* Bit operations (bitmaps of 32 bit words) --------------- */
+
+#define ATOMIC_BIT_WORD(nr)     ((nr) >> 5)
+#define ATOMIC_BIT_MASK(nr)     (1UL << ((nr) & 31))
+
+static inline void Atomic_SetBit(uint32_t nr, volatile uint32_t* bitmap)
+{
+    Atomic_ClrSet32(&bitmap[ATOMIC_BIT_WORD(nr)], 0, ATOMIC_BIT_MASK(nr));
+}
+
+static inline void Atomic_ClearBit(uint32_t nr, volatile uint32_t* bitmap)
+{
+    Atomic_ClrSet32(&bitmap[ATOMIC_BIT_WORD(nr)], ATOMIC_BIT_MASK(nr), 0);
+}
+
+static inline void Atomic_ChangeBit(uint32_t nr, volatile uint32_t* bitmap)
+{
+    volatile uint32_t* word = &bitmap[ATOMIC_BIT_WORD(nr)];
+    uint32_t old;
+
+    do
+    {
+        old = *word;
+    }while(Atomic_CmpXchg32(word, old, old ^ ATOMIC_BIT_MASK(nr)) != old);
+}
+
+static inline bool_t Atomic_TestAndSetBit(uint32_t nr, volatile uint32_t* bitmap)
+{
+    return (Atomic_ClrSet32(&bitmap[ATOMIC_BIT_WORD(nr)], 0, ATOMIC_BIT_MASK(nr)) & ATOMIC_BIT_MASK(nr)) != 0;
+}
+
+static inline bool_t Atomic_TestAndClearBit(uint32_t nr, volatile uint32_t* bitmap)
+{
+    return (Atomic_ClrSet32(&bitmap[ATOMIC_BIT_WORD(nr)], ATOMIC_BIT_MASK(nr), 0) & ATOMIC_BIT_MASK(nr)) != 0;
+}
+
+static inline bool_t Atomic_TestBit(uint32_t nr, const volatile uint32_t* bitmap)
+{
+    return (bitmap[ATOMIC_BIT_WORD(nr)] & ATOMIC_BIT_MASK(nr)) != 0;
+}
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _ATOMIC_H_ */
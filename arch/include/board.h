@@ -0,0 +1,49 @@
+/**
+ * @file        board.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Board Specific Functions Header File
+*/
+
+#ifndef _BOARD_H_
+#define _BOARD_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Starts a secondary CPU at the given entry point. Boards that
+ *          start every core at reset leave the cores in the boot.S pen
+ *          and only need to return
+ *
+ * @param   cpu - CPU number
+ *          entry - Physical address of the entry point (_start)
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the power controller cannot
+ *          be mapped
+ */
+int32_t BoardCpuStart(uint32_t cpu, paddr_t entry);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _BOARD_H_ */
\ No newline at end of file
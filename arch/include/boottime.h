@@ -0,0 +1,80 @@
+/**
+ * @file        boottime.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Boot Phase Timing Header File
+ *
+ *              The cycle counter of each CPU is started at the top of
+ *              cpu_boot (boot.S), before anything else runs, and boot.S
+ *              records it at the end of every phase in boot_times. The
+ *              phases before the MMU is enabled are written with the
+ *              caches off; every CPU has its own cache line, which no other
+ *              CPU reads until the table is printed.
+ *
+ *              The row also records how the image was entered: the
+ *              decompression cycles of the lz4 stub (make COMPRESS=1,
+ *              arch/arm/lz4/head.S) and, on cores with the generic timer,
+ *              the time since reset when the image was entered, which
+ *              includes the boot loader and the load of the image.
+*/
+
+#ifndef _BOOTTIME_H_
+#define _BOOTTIME_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Phases (boot_times words, BOOT_T_* in boot.S)
+#define BOOT_T_START        (0)         // cpu_boot entered, cycle counter started
+#define BOOT_T_PEN          (1)         // Secondary CPUs: released from the pen
+#define BOOT_T_INVALIDATE   (2)         // v7_invalidate_l1 done
+#define BOOT_T_CPU_INIT     (3)         // cpu_init done
+#define BOOT_T_PAGE_TABLE   (4)         // CPU 0: create_page_table done
+#define BOOT_T_MMU          (5)         // enable_mmu done (virtual addresses)
+#define BOOT_T_BSS          (6)         // CPU 0: .bss cleared, main called
+#define BOOT_PHASES         (7)
+
+// Image entry (boot_times words, BOOT_W_* in boot.S), 0 when not measured
+#define BOOT_W_DECOMPRESS   (7)         // lz4 stub decompression (cycles)
+#define BOOT_W_ENTRY        (8)         // Generic timer at image entry
+
+// Bytes per CPU (one cache line on every supported core)
+#define BOOT_ROW_SIZE       (64)
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Prints the time spent in every boot phase of each CPU (cycles
+ *          since the previous phase recorded), one line per CPU:
+ *          @boot cpu=<n> <phase>=<cycles> ... total=<cycles>
+ *          followed by decompress=<cycles> and entry_us=<us since reset>
+ *          when measured
+ *          Must be called once the secondary CPUs are online
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void BootTimesPrint(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _BOOTTIME_H_ */
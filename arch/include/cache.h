@@ -0,0 +1,52 @@
+/**
+ * @file        cache.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       ARMv7-A Cache Driver Header File
+*/
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Invalidates the instruction cache (inner shareable)
+ * @param   None
+ * @retval  No return
+ */
+void v7_flush_icache_all(void);
+
+/**
+ * @brief   Cleans and invalidates the data cache lines covering [start, end)
+ *          to the point of coherency
+ * @param   start - First virtual address
+ *          end - Virtual address after the last byte
+ * @retval  No return
+ */
+void v7_flush_dcache_range(vaddr_t start, vaddr_t end);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _CACHE_H_ */
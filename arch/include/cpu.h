@@ -0,0 +1,105 @@
+/**
+ * @file        cpu.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Processor Identification Header File
+*/
+
+#ifndef _CPU_H_
+#define _CPU_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported constants ------------------------------------- */
+
+// Number of cores (set from the board configuration)
+#ifndef NR_CPUS
+    #define NR_CPUS     (4)
+#endif
+
+// L1 data cache line size
+#if defined(CORTEX_A9)
+    #define CACHE_LINE_SIZE     (32)
+#else
+    #define CACHE_LINE_SIZE     (64)
+#endif
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Get the running cpu
+ * @param   None
+ * @retval  CPU number (MPIDR.Aff0)
+ */
+static inline uint32_t CPU_Id(void)
+{
+    uint32_t mpidr;
+    asm volatile("mrc   p15, 0, %[_mpidr], c0, c0, 5" : [_mpidr] "=r" (mpidr));
+    return (mpidr & 0x3);
+}
+
+/**
+ * @brief   Get the per-CPU area offset of the running cpu
+ * @param   None
+ * @retval  Offset from the per-CPU section (TPIDRPRW)
+ */
+static inline ulong_t CPU_PercpuOffset(void)
+{
+    ulong_t offset;
+    asm volatile("mrc   p15, 0, %[_offset], c13, c0, 4" : [_offset] "=r" (offset));
+    return offset;
+}
+
+/**
+ * @brief   Set the per-CPU area offset of the running cpu
+ * @param   offset - Offset from the per-CPU section
+ * @retval  No return
+ */
+static inline void CPU_SetPercpuOffset(ulong_t offset)
+{
+    asm volatile("mcr   p15, 0, %[_offset], c13, c0, 4" :: [_offset] "r" (offset) : "memory");
+}
+
+/**
+ * @brief   Masks IRQ and FIQ on the running cpu
+ * @param   None
+ * @retval  Previous CPSR (for CPU_IrqRestore)
+ */
+static inline uint32_t CPU_IrqSave(void)
+{
+    uint32_t cpsr;
+    asm volatile("mrs   %[_cpsr], cpsr\n\t"
+                 "cpsid if" : [_cpsr] "=r" (cpsr) :: "memory");
+    return cpsr;
+}
+
+/**
+ * @brief   Restores the IRQ and FIQ masks saved by CPU_IrqSave
+ * @param   cpsr - Value returned by CPU_IrqSave
+ * @retval  No return
+ */
+static inline void CPU_IrqRestore(uint32_t cpsr)
+{
+    asm volatile("msr   cpsr_c, %[_cpsr]" :: [_cpsr] "r" (cpsr) : "memory", "cc");
+}
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _CPU_H_ */
@@ -0,0 +1,71 @@
+/**
+ * @file        fpu.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       ARMv7-A VFP/NEON Register Bank Header File
+ *
+ *              Access to cp10/cp11 is granted at boot (CPACR), the unit
+ *              itself is turned on and off through FPEXC.EN. Both cores
+ *              implement VFPv3/VFPv4 with 32 double registers (NEON).
+*/
+
+#ifndef _FPU_H_
+#define _FPU_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+/* Exported types ----------------------------------------- */
+
+// Register bank: d0-d31 and FPSCR (fpu_save / fpu_restore layout)
+typedef struct
+{
+    uint64_t d[32];
+    uint32_t fpscr;
+    uint32_t reserved;
+}fpu_state_t;
+
+
+/* Exported constants ------------------------------------- */
+
+#define FPEXC_EN            (1 << 30)   // VFP/NEON instructions enabled
+
+// FPSCR of a thread that never used the FPU: round to nearest, flush to
+// zero and default NaN (as the NEON unit works)
+#define FPSCR_DEFAULT       ((1 << 25) | (1 << 24))
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+uint32_t fpu_get_fpexc(void);
+
+void fpu_set_fpexc(uint32_t fpexc);
+
+/**
+ * @brief   Saves the register bank. FPEXC.EN must be set
+ * @param   state - Register bank (8 bytes aligned)
+ * @retval  No return
+ */
+void fpu_save(fpu_state_t* state);
+
+/**
+ * @brief   Loads the register bank. FPEXC.EN must be set
+ * @param   state - Register bank (8 bytes aligned)
+ * @retval  No return
+ */
+void fpu_restore(const fpu_state_t* state);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _FPU_H_ */
@@ -0,0 +1,205 @@
+/**
+ * @file        io.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Memory Mapped I/O Accessors Header File
+ *
+ *              Relaxed accessors (*_relaxed) are single load/store
+ *              instructions without barriers: accesses to the same device
+ *              are already kept in order by the Device memory type.
+ *              Ordered accessors add a DMB so device accesses are also
+ *              ordered against Normal memory (e.g. buffers a device reads
+ *              or writes by DMA): writes are preceded by DMB OSHST and
+ *              reads followed by DMB OSH.
+ *              A DSB is only needed to wait for a write to complete before
+ *              an effect outside the memory system (see io_sync).
+*/
+
+#ifndef _IO_H_
+#define _IO_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+// Register write of a sequence (see writel_seq)
+typedef struct
+{
+    uint32_t offset;                    // Register offset from the device base
+    uint32_t value;
+}io_seq_t;
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+// Normal memory writes done before the following device writes
+#define io_wmb()            asm volatile("dmb   oshst" ::: "memory")
+// Device reads done before the following Normal memory reads
+#define io_rmb()            asm volatile("dmb   osh" ::: "memory")
+// Wait for the outstanding device accesses to complete
+#define io_sync()           asm volatile("dsb" ::: "memory")
+
+
+/* Exported functions ------------------------------------- */
+
+/* Relaxed accessors -------------------------------------- */
+
+static inline uint8_t readb_relaxed(const volatile void* addr)
+{
+    uint8_t val;
+    asm volatile("ldrb  %0, %1" : "=r" (val) : "Qo" (*(const volatile uint8_t*)addr));
+    return val;
+}
+
+static inline uint16_t readw_relaxed(const volatile void* addr)
+{
+    uint16_t val;
+    asm volatile("ldrh  %0, %1" : "=r" (val) : "Q" (*(const volatile uint16_t*)addr));
+    return val;
+}
+
+static inline uint32_t readl_relaxed(const volatile void* addr)
+{
+    uint32_t val;
+    asm volatile("ldr   %0, %1" : "=r" (val) : "Qo" (*(const volatile uint32_t*)addr));
+    return val;
+}
+
+static inline void writeb_relaxed(uint8_t val, volatile void* addr)
+{
+    asm volatile("strb  %1, %0" : "+Qo" (*(volatile uint8_t*)addr) : "r" (val));
+}
+
+static inline void writew_relaxed(uint16_t val, volatile void* addr)
+{
+    asm volatile("strh  %1, %0" : "+Q" (*(volatile uint16_t*)addr) : "r" (val));
+}
+
+static inline void writel_relaxed(uint32_t val, volatile void* addr)
+{
+    asm volatile("str   %1, %0" : "+Qo" (*(volatile uint32_t*)addr) : "r" (val));
+}
+
+/* Ordered accessors -------------------------------------- */
+
+static inline uint8_t readb(const volatile void* addr)
+{
+    uint8_t val = readb_relaxed(addr);
+    io_rmb();
+    return val;
+}
+
+static inline uint16_t readw(const volatile void* addr)
+{
+    uint16_t val = readw_relaxed(addr);
+    io_rmb();
+    return val;
+}
+
+static inline uint32_t readl(const volatile void* addr)
+{
+    uint32_t val = readl_relaxed(addr);
+    io_rmb();
+    return val;
+}
+
+static inline void writeb(uint8_t val, volatile void* addr)
+{
+    io_wmb();
+    writeb_relaxed(val, addr);
+}
+
+static inline void writew(uint16_t val, volatile void* addr)
+{
+    io_wmb();
+    writew_relaxed(val, addr);
+}
+
+static inline void writel(uint32_t val, volatile void* addr)
+{
+    io_wmb();
+    writel_relaxed(val, addr);
+}
+
+/* Read-modify-write -------------------------------------- */
+
+static inline void clrsetbits_relaxed(volatile void* addr, uint32_t clr, uint32_t set)
+{
+    writel_relaxed((readl_relaxed(addr) & ~clr) | set, addr);
+}
+
+static inline void clrsetbits(volatile void* addr, uint32_t clr, uint32_t set)
+{
+    io_wmb();
+    clrsetbits_relaxed(addr, clr, set);
+}
+
+static inline void setbits(volatile void* addr, uint32_t set)
+{
+    clrsetbits(addr, 0, set);
+}
+
+static inline void clrbits(volatile void* addr, uint32_t clr)
+{
+    clrsetbits(addr, clr, 0);
+}
+
+/* Register sequences ------------------------------------- */
+
+/**
+ * @brief   Writes a sequence of registers in order with a single barrier
+ *          before the first write
+ * @param   base - Device base address
+ *          seq - Register writes
+ *          count - Number of writes
+ * @retval  No return
+ */
+static inline void writel_seq(volatile void* base, const io_seq_t* seq, size_t count)
+{
+    size_t i;
+
+    io_wmb();
+
+    for(i = 0; i < count; ++i)
+    {
+        writel_relaxed(seq[i].value, (volatile void*)((ulong_t)base + seq[i].offset));
+    }
+}
+
+/**
+ * @brief   Reads a sequence of consecutive registers with a single barrier
+ *          after the last read
+ * @param   addr - First register
+ *          values - Output buffer
+ *          count - Number of registers
+ * @retval  No return
+ */
+static inline void readl_seq(const volatile void* addr, uint32_t* values, size_t count)
+{
+    const volatile uint32_t* reg = (const volatile uint32_t*)addr;
+    size_t i;
+
+    for(i = 0; i < count; ++i)
+    {
+        values[i] = readl_relaxed(&reg[i]);
+    }
+
+    io_rmb();
+}
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _IO_H_ */
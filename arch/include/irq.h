@@ -0,0 +1,119 @@
+/**
+ * @file        irq.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Interrupt Controller (GIC) Header File
+*/
+
+#ifndef _IRQ_H_
+#define _IRQ_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+typedef void (*irq_handler_t)(uint32_t irq, void* arg);
+
+
+/* Exported constants ------------------------------------- */
+
+// Interrupt IDs: 0-15 SGIs, 16-31 PPIs (banked per CPU), 32+ SPIs
+#define IRQ_SGI_BASE        (0)
+#define IRQ_PPI_BASE        (16)
+#define IRQ_SPI_BASE        (32)
+
+// Interrupt lines handled by the kernel
+#define IRQ_LINES           (160)
+
+// Software generated interrupts (inter-processor)
+#define IRQ_SGI_COUNT       (16)
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Maps and initializes the GIC distributor and the interface of
+ *          the boot CPU. Must be called after IoRemapInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the GIC cannot be mapped
+ */
+int32_t IrqInit(void);
+
+/**
+ * @brief   Initializes the GIC CPU interface and the banked interrupts of
+ *          the running CPU. Called by each secondary CPU when it starts
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void IrqCpuInit(void);
+
+/**
+ * @brief   Sets the handler of an interrupt
+ *
+ * @param   irq - Interrupt ID
+ *          handler - Handler, called with IRQs masked
+ *          arg - Handler argument
+ *
+ * @retval  E_OK on success, E_INVAL if irq is out of range
+ */
+int32_t IrqRegister(uint32_t irq, irq_handler_t handler, void* arg);
+
+/**
+ * @brief   Enables an interrupt. SGIs and PPIs are enabled on the running
+ *          CPU only
+ *
+ * @param   irq - Interrupt ID
+ *
+ * @retval  No return
+ */
+void IrqEnable(uint32_t irq);
+
+/**
+ * @brief   Disables an interrupt. SGIs and PPIs are disabled on the
+ *          running CPU only
+ *
+ * @param   irq - Interrupt ID
+ *
+ * @retval  No return
+ */
+void IrqDisable(uint32_t irq);
+
+/**
+ * @brief   Sends a software generated interrupt
+ *
+ * @param   sgi - SGI number (0 to IRQ_SGI_COUNT - 1)
+ *          cpuMask - Target CPUs (bit n set: CPU n)
+ *
+ * @retval  No return
+ */
+void IrqSendSgi(uint32_t sgi, uint32_t cpuMask);
+
+/**
+ * @brief   Handles the pending interrupts (called from the IRQ vector)
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void IrqHandler(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _IRQ_H_ */
@@ -34,35 +34,11 @@
 #define ALIGN_DOWN(m,a)     ((m) & (~(a - 1)))
 #define ALIGN_UP(m,a)       (((m) + (a - 1)) & (~(a - 1)))
 
-#define setbit(addr, v)     (*((volatile ulong_t *)(addr)) |= (ulong_t)(v))
-#define readl(addr)         (*((volatile ulong_t *)(addr)))
-#define writel(v, addr)     (*((volatile ulong_t *)(addr)) = (ulong_t)(v))
+// Device register accessors are in io.h
 
 
 /* Exported functions ------------------------------------- */
 
-static inline void clrsetbits(volatile void* mem, uint32_t clr, uint32_t set)
-{
-    uint32_t __val = readl(mem);
-    __val &= ~clr;
-    __val |= set;
-    writel(__val, mem);
-}
-
-static inline void clrbits(volatile void* mem, uint32_t clr)
-{
-    uint32_t __val = readl(mem);
-    __val &= ~clr;
-    writel(__val, mem);
-}
-
-static inline void setbits(volatile void* mem, uint32_t set)
-{
-    uint32_t __val = readl(mem);
-    __val |= set;
-    writel(__val, mem);
-}
-
 #ifdef __cplusplus
     }
 #endif
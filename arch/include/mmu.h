@@ -43,6 +43,10 @@ typedef struct
 /* Exported constants ------------------------------------- */
 #define PAGE_SIZE           (4096)
 
+// User page tables translate the lower 2Gb (TTBCR.N = 1): 2048 entries
+#define USER_PGT_SIZE       (0x2000)
+#define USER_SPACE_END      (0x80000000)
+
 enum
 {
     CPOLICY_STRONGLY_ORDERED = 0,
@@ -128,11 +132,37 @@ void MMU_FreePGT(pgt_t pgt);
  */
 void MMU_InvalidatePGT(pgt_t pgt);
 
+/*
+ * @brief   Loads a user page table and its ASID in TTBR0 and CONTEXTIDR of
+ *          the running CPU. TLB entries of other ASIDs are kept
+ * @param   pgt - page table (from MMU_AllocPGT)
+ *          asid - Address space identifier (1 to 255)
+ * @retval  No return
+ */
+void MMU_SetUserPGT(pgt_t pgt, uint32_t asid);
+
+/*
+ * @brief   Get the TTBR0 value (physical address and walk attributes) that
+ *          selects the given user page table
+ * @param   pgt - page table (from MMU_AllocPGT)
+ * @retval  TTBR0 value
+ */
+ulong_t MMU_UserTTBR(pgt_t pgt);
+
+/*
+ * @brief   Invalidates the TLB entries tagged with the given ASID on all
+ *          cores (inner shareable)
+ * @param   asid - Address space identifier
+ * @retval  No return
+ */
+void MMU_InvalidateASID(uint32_t asid);
+
 /*
  * @brief   Translate a virtual address to a physical address using the given page table
- * @param   pgt - page table
+ *          (software walk, the TLB is not used)
+ * @param   pgt - page table (logical address)
  *          vaddr - virtual address
- * @retval  Returns the physical address
+ * @retval  Returns the physical address, NULL if vaddr is not mapped
  */
 paddr_t MMU_V2P(pgt_t pgt, vaddr_t vaddr);
 
@@ -150,6 +180,46 @@ paddr_t MMU_L2P(vaddr_t vaddr);
  */
 vaddr_t MMU_P2L(paddr_t paddr);
 
+/*
+ * Fixed granule mapping helpers used by MMU_MapPages. Physical and virtual
+ * addresses must be aligned to the granule and the caller is responsible
+ * for the barriers before the new mappings are used.
+ * For 64Kb and 4Kb pages pgt is the L2 page table covering vaddr.
+ */
+void MMU_Map16MbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg);
+
+void MMU_Map1MbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg);
+
+void MMU_Map64KbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg);
+
+void MMU_Map4KbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg);
+
+/*
+ * @brief   Allocates an empty L2 page table
+ * @param   None
+ * @retval  L2 page table (logical address, 1Kb aligned), NULL if out of memory
+ */
+ulong_t* MMU_AllocL2PGT(void);
+
+/*
+ * @brief   Releases a L2 page table. MMU_UnmapPages releases L2 page tables
+ *          once all their entries are unmapped
+ * @param   l2pgt - L2 page table (all entries must be invalid)
+ * @retval  No return
+ */
+void MMU_FreeL2PGT(ulong_t* l2pgt);
+
+/*
+ * @brief   Attaches a L2 page table to the L1 entry covering vaddr
+ *          (entry vaddr >> 20 of the table)
+ * @param   pgt - L1 page table
+ *          l2pgt - L2 page table from MMU_AllocL2PGT (logical address),
+ *                  populated before it is attached
+ *          vaddr - virtual address
+ * @retval  No return
+ */
+void MMU_AttachL2PGT(ulong_t* pgt, ulong_t* l2pgt, ulong_t vaddr);
+
 #ifdef __cplusplus
     }
 #endif
@@ -0,0 +1,63 @@
+/**
+ * @file        platform.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Platform Discovery Header File
+ *
+ *              The platform is described by the device tree blob the boot
+ *              loader passes in r2 (include/fdt.h). Drivers use the
+ *              discovered values when they are set and their compile time
+ *              defaults (board configuration) otherwise.
+*/
+
+#ifndef _PLATFORM_H_
+#define _PLATFORM_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <fdt.h>
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Parses the device tree blob passed by the boot loader. Must be
+ *          called before PageInit: the blob is read through its logical
+ *          address, mapped only for the walk
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_INVAL if there is no valid blob in the RAM
+ *          after the kernel (the platform description stays empty)
+ */
+int32_t PlatformInit(void);
+
+/**
+ * @brief   Gets the platform description
+ *
+ * @param   None
+ *
+ * @retval  Platform description, fields not discovered are 0
+ */
+const fdt_platform_t* PlatformGet(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _PLATFORM_H_ */
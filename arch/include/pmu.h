@@ -22,6 +22,20 @@
 
 /* Exported constants ------------------------------------- */
 
+// Number of event counters used by the kernel (Cortex-A7 implements 4, Cortex-A9 6)
+#define PMU_EVENT_COUNTERS      (4)
+
+// Common ARMv7 PMU events
+#define PMU_EVT_L1I_REFILL      (0x01)      // Instruction cache refill
+#define PMU_EVT_L1I_TLB_REFILL  (0x02)      // Instruction TLB refill
+#define PMU_EVT_L1D_REFILL      (0x03)      // Data cache refill
+#define PMU_EVT_L1D_ACCESS      (0x04)      // Data cache access
+#define PMU_EVT_L1D_TLB_REFILL  (0x05)      // Data TLB refill
+#define PMU_EVT_EXC_TAKEN       (0x09)      // Exception taken
+#define PMU_EVT_BR_MISPRED      (0x10)      // Branch mispredicted
+#define PMU_EVT_L2D_ACCESS      (0x16)      // L2 data cache access (Cortex-A7 only, PL310 has its own counters)
+#define PMU_EVT_L2D_REFILL      (0x17)      // L2 data cache refill (Cortex-A7 only)
+
 
 /* Exported macros ---------------------------------------- */
 
@@ -37,6 +51,10 @@ void pmu_int_perfcounters(uint32_t do_reset, uint32_t enable_divider);
 
 uint32_t pmu_get_cyclecount(void);
 
+void pmu_set_event(uint32_t counter, uint32_t event);
+
+uint32_t pmu_get_eventcount(uint32_t counter);
+
 #ifdef __cplusplus
     }
 #endif
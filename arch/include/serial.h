@@ -89,6 +89,25 @@ void putc(char c);
  */
 void puts(const char *s);
 
+/**
+ * @brief    Send an unsigned value in decimal
+ *
+ * @param    value - Value to be sent
+ *
+ * @retval   No return value
+ */
+void putu(uint32_t value);
+
+/**
+ * @brief    Send a " key=value" report field (decimal value)
+ *
+ * @param    key - Field name
+ *           value - Field value
+ *
+ * @retval   No return value
+ */
+void putfield(const char* key, uint32_t value);
+
 #ifdef __cplusplus
     }
 #endif
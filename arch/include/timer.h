@@ -0,0 +1,60 @@
+/**
+ * @file        timer.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Per-CPU Tick Timer Header File
+*/
+
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+typedef void (*timer_tick_t)(void);
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Sets up the tick timer (Cortex-A7: generic virtual timer,
+ *          Cortex-A9: MPCore private timer) and starts it on the running
+ *          CPU. Must be called after IrqInit
+ *
+ * @param   hz - Tick frequency
+ *          tick - Function called on every tick (IRQ context)
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the timer cannot be mapped
+ */
+int32_t TimerInit(uint32_t hz, timer_tick_t tick);
+
+/**
+ * @brief   Starts the tick timer of the running CPU. Called by each
+ *          secondary CPU when it starts
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TimerCpuInit(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _TIMER_H_ */
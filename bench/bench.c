@@ -0,0 +1,351 @@
+/**
+ * @file        bench.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       In-kernel Benchmark Runner
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <serial.h>
+#include <pmu.h>
+#include <page.h>
+#include <virtual.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t cycles[BENCH_RUNS];
+    uint32_t events[PMU_EVENT_COUNTERS][BENCH_RUNS];
+}bench_samples_t;
+
+
+/* Private constants -------------------------------------- */
+
+#if defined(SUNXI_H3)
+    #define BENCH_BOARD     "sunxi-h3"
+#elif defined(VE_A9)
+    #define BENCH_BOARD     "ve-a9"
+#else
+    #define BENCH_BOARD     "unknown"
+#endif
+
+#if defined(CORTEX_A7)
+    #define BENCH_CPU       "cortex-a7"
+#elif defined(CORTEX_A9)
+    #define BENCH_CPU       "cortex-a9"
+#else
+    #define BENCH_CPU       "unknown"
+#endif
+
+static const uint32_t DefaultEvents[PMU_EVENT_COUNTERS] =
+{
+    PMU_EVT_L1D_REFILL,
+    PMU_EVT_L1D_TLB_REFILL,
+    PMU_EVT_L1I_REFILL,
+    PMU_EVT_BR_MISPRED
+};
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static bench_samples_t samples;
+
+static uint32_t events[PMU_EVENT_COUNTERS];
+static uint32_t eventsCount;
+
+// Measured runs of each BenchRun
+static uint32_t runs = BENCH_RUNS;
+
+// Cycles taken by an empty measurement
+static uint32_t overhead;
+
+static paddr_t scratch;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Sorts the array in place (insertion sort, arrays are small)
+ * @param   array - Values to sort
+ *          size - Number of values
+ * @retval  No return
+ */
+static void BenchSort(uint32_t* array, uint32_t size);
+
+/**
+ * @brief   Empty operation used to calibrate the measurement overhead
+ * @param   arg - Not used
+ * @retval  No return
+ */
+static void BenchNop(void* arg);
+
+/**
+ * @brief   Programs the selected events in the PMU event counters
+ * @param   None
+ * @retval  No return
+ */
+static void BenchLoadEvents(void);
+
+
+/* Private functions -------------------------------------- */
+
+void BenchSort(uint32_t* array, uint32_t size)
+{
+    uint32_t i, j;
+    for(i = 1; i < size; ++i)
+    {
+        uint32_t value = array[i];
+        for(j = i; (j > 0) && (array[j - 1] > value); --j)
+        {
+            array[j] = array[j - 1];
+        }
+        array[j] = value;
+    }
+}
+
+void BenchNop(void* arg)
+{
+    (void)arg;
+}
+
+void BenchLoadEvents(void)
+{
+    uint32_t i;
+    for(i = 0; i < eventsCount; ++i)
+    {
+        pmu_set_event(i, events[i]);
+    }
+}
+
+/**
+ * BenchSetEvents Implementation (See header include/bench.h file for description)
+*/
+void BenchSetEvents(const uint32_t* evts, uint32_t count)
+{
+    if(count > PMU_EVENT_COUNTERS)
+    {
+        count = PMU_EVENT_COUNTERS;
+    }
+
+    uint32_t i;
+    for(i = 0; i < count; ++i)
+    {
+        events[i] = evts[i];
+    }
+    eventsCount = count;
+
+    BenchLoadEvents();
+}
+
+/**
+ * BenchSetRuns Implementation (See header include/bench.h file for description)
+*/
+void BenchSetRuns(uint32_t count)
+{
+    if(count == 0)
+    {
+        count = 1;
+    }
+    else if(count > BENCH_RUNS)
+    {
+        count = BENCH_RUNS;
+    }
+
+    runs = count;
+}
+
+/**
+ * BenchName Implementation (See header include/bench.h file for description)
+*/
+const char* BenchName(char* buffer, const char* p0, const char* p1, const char* p2, const char* p3)
+{
+    const char* parts[4] = {p0, p1, p2, p3};
+    uint32_t i, len = 0;
+
+    for(i = 0; i < 4; ++i)
+    {
+        const char* part = parts[i];
+
+        if(part == NULL)
+        {
+            continue;
+        }
+
+        if((len != 0) && (len < BENCH_NAME_SIZE - 1))
+        {
+            buffer[len++] = '.';
+        }
+
+        while((*part != '\0') && (len < BENCH_NAME_SIZE - 1))
+        {
+            buffer[len++] = *part++;
+        }
+    }
+
+    buffer[len] = '\0';
+
+    return buffer;
+}
+
+/**
+ * BenchRandom Implementation (See header include/bench.h file for description)
+*/
+uint32_t BenchRandom(uint32_t* state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+/**
+ * BenchScratch Implementation (See header include/bench.h file for description)
+*/
+paddr_t BenchScratch(void)
+{
+    if(scratch == NULL)
+    {
+        scratch = PageAlloc(PAGE_ORDER_16M);
+    }
+
+    return scratch;
+}
+
+/**
+ * BenchRun Implementation (See header include/bench.h file for description)
+*/
+uint32_t BenchRun(const char* name, bench_op_t op, void* arg, uint32_t units)
+{
+    uint32_t run, i;
+    uint32_t start[PMU_EVENT_COUNTERS];
+
+    for(run = 0; run < BENCH_WARMUP_RUNS; ++run)
+    {
+        op(arg);
+    }
+
+    for(run = 0; run < runs; ++run)
+    {
+        uint32_t cycles;
+
+        for(i = 0; i < eventsCount; ++i)
+        {
+            start[i] = pmu_get_eventcount(i);
+        }
+
+        PERFORMANCE_MONITORING_START(cycles);
+        op(arg);
+        PERFORMANCE_MONITORING_STOP(cycles);
+
+        for(i = 0; i < eventsCount; ++i)
+        {
+            samples.events[i][run] = pmu_get_eventcount(i) - start[i];
+        }
+
+        samples.cycles[run] = (cycles > overhead) ? (cycles - overhead) : 0;
+    }
+
+    BenchSort(samples.cycles, runs);
+
+    uint32_t median = samples.cycles[runs / 2];
+
+    // Calibration run does not print results
+    if(name == NULL)
+    {
+        return median;
+    }
+
+    puts("@bench name=");
+    puts(name);
+    putfield("runs", runs);
+    putfield("units", units);
+    putfield("min", samples.cycles[0]);
+    putfield("med", median);
+    putfield("p99", samples.cycles[((runs * 99) + 99) / 100 - 1]);
+
+    for(i = 0; i < eventsCount; ++i)
+    {
+        char key[4] = {'e', "0123456789abcdef"[(events[i] >> 4) & 0xF], "0123456789abcdef"[events[i] & 0xF], '\0'};
+
+        BenchSort(samples.events[i], runs);
+        putfield(key, samples.events[i][runs / 2]);
+    }
+
+    puts("\n");
+
+    return median;
+}
+
+/**
+ * BenchStat Implementation (See header include/bench.h file for description)
+*/
+void BenchStat(const char* name, uint32_t value)
+{
+    puts("@stat name=");
+    puts(name);
+    putfield("value", value);
+    puts("\n");
+}
+
+/**
+ * BenchRunAll Implementation (See header include/bench.h file for description)
+*/
+uint32_t BenchRunAll(void)
+{
+    // Benchmark descriptors (set in the linker script)
+    extern const bench_t __bench_start[];
+    extern const bench_t __bench_end[];
+
+    const bench_t* bench;
+    char name[BENCH_NAME_SIZE];
+    uint32_t count = 0;
+
+    // No divider. Not reset: measurements are differences and the cycle
+    // counter keeps running since cpu_boot (boot and trace timestamps)
+    pmu_int_perfcounters(0, 0);
+
+    BenchSetEvents(DefaultEvents, PMU_EVENT_COUNTERS);
+
+    // Window used by the benchmarks that build their own mappings
+    bool_t window = (VirtualReserve((vaddr_t)BENCH_SCRATCH_VADDR, BENCH_WINDOW_SIZE) != NULL);
+
+    // Measure the cost of an empty measurement
+    overhead = 0;
+    overhead = BenchRun(NULL, BenchNop, NULL, 1);
+
+    puts("\n@bench-begin board=" BENCH_BOARD " cpu=" BENCH_CPU);
+    putfield("overhead", overhead);
+    puts("\n");
+
+    for(bench = __bench_start; bench < __bench_end; ++bench, ++count)
+    {
+        // Their mappings could overwrite the ones of the window owner
+        if((bench->flags & BENCH_WINDOW) && !window)
+        {
+            BenchStat(BenchName(name, bench->name, "skipped", NULL, NULL), 1);
+            continue;
+        }
+
+        BenchSetEvents(DefaultEvents, PMU_EVENT_COUNTERS);
+        BenchSetRuns(BENCH_RUNS);
+        bench->entry();
+    }
+
+    puts("@bench-end");
+    putfield("count", count);
+    puts("\n");
+
+    return count;
+}
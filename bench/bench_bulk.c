@@ -0,0 +1,282 @@
+/**
+ * @file        bench_bulk.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Bulk IPC Benchmarks
+ *
+ *              Moves buffers between address spaces by copying (memcpy
+ *              baseline), sharing (IpcShare + IpcRevoke) and granting
+ *              (IpcGrant there and back), and streams data through a
+ *              channel with the producer on CPU1 and the consumer on CPU0.
+ *              Units are bytes, so the results compare as cycles per byte.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <ipc.h>
+#include <channel.h>
+#include <space.h>
+#include <sched.h>
+#include <page.h>
+#include <virtual.h>
+#include <string.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    void*       src;
+    void*       dst;
+    pbv_t       pages[VIRTUAL_VMALLOC_CHUNKS];
+    size_t      count;
+    size_t      size;
+    space_t*    from;
+    space_t*    to;
+}bulk_arg_t;
+
+typedef struct
+{
+    channel_t*      ch;
+    uint8_t*        buffer;
+    int32_t         doneEp;
+    volatile bool_t stop;
+}stream_arg_t;
+
+typedef struct
+{
+    uint32_t    size;
+    const char* name;
+}bulk_size_t;
+
+
+/* Private constants -------------------------------------- */
+
+// User address of the buffers (16Mb aligned, every chunk keeps its granule)
+#define BULK_VADDR          (0x10000000)
+
+// Copies of the larger buffers use fewer runs
+#define SLOW_SIZE           (1024 * 1024)
+#define SLOW_RUNS           (8)
+
+// Channel data size, bytes moved per run and per write/read
+#define STREAM_RING_SIZE    (64 * 1024)
+#define STREAM_BYTES        (256 * 1024)
+#define STREAM_CHUNK        (4 * 1024)
+
+static const bulk_size_t Sizes[] =
+{
+    {64 * 1024,         "64k"},
+    {1024 * 1024,       "1m"},
+    {4 * 1024 * 1024,   "4m"},
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpCopy(void* arg);
+
+static void OpShare(void* arg);
+
+/**
+ * @brief   Grants the buffer to the receiver and back (two transfers)
+ * @param   arg - Buffer setup
+ * @retval  No return
+ */
+static void OpGrant(void* arg);
+
+/**
+ * @brief   Reads STREAM_BYTES from the channel
+ * @param   arg - Stream setup
+ * @retval  No return
+ */
+static void OpStream(void* arg);
+
+/**
+ * @brief   Producer: fills the channel until stopped
+ * @param   arg - Stream setup
+ * @retval  No return
+ */
+static void StreamProducer(void* arg);
+
+static void BenchBulkSize(const bulk_size_t* size);
+
+static void BenchStream(void);
+
+static void BenchBulk(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpCopy(void* arg)
+{
+    bulk_arg_t* a = (bulk_arg_t*)arg;
+
+    memcpy(a->dst, a->src, a->size);
+}
+
+void OpShare(void* arg)
+{
+    bulk_arg_t* a = (bulk_arg_t*)arg;
+
+    IpcShare(a->to, (vaddr_t)BULK_VADDR, a->pages, a->count, 0);
+    IpcRevoke(a->to, (vaddr_t)BULK_VADDR, a->size);
+}
+
+void OpGrant(void* arg)
+{
+    bulk_arg_t* a = (bulk_arg_t*)arg;
+
+    IpcGrant(a->from, (vaddr_t)BULK_VADDR, a->to, (vaddr_t)BULK_VADDR, a->pages, a->count, IPC_MAP_WRITE);
+    IpcGrant(a->to, (vaddr_t)BULK_VADDR, a->from, (vaddr_t)BULK_VADDR, a->pages, a->count, IPC_MAP_WRITE);
+}
+
+void OpStream(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    size_t left = STREAM_BYTES;
+
+    while(left != 0)
+    {
+        left -= ChannelRead(s->ch, s->buffer, (left < STREAM_CHUNK) ? left : STREAM_CHUNK);
+    }
+}
+
+void StreamProducer(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint8_t chunk[256];
+    ipc_msg_t msg = {{0}};
+
+    memset(chunk, 0x5A, sizeof(chunk));
+
+    while(!s->stop)
+    {
+        ChannelWrite(s->ch, chunk, sizeof(chunk));
+    }
+
+    IpcSend(s->doneEp, &msg);
+}
+
+void BenchBulkSize(const bulk_size_t* size)
+{
+    char name[BENCH_NAME_SIZE];
+    bulk_arg_t a;
+
+    a.size = size->size;
+    a.src = VMalloc(a.size);
+    a.dst = VMalloc(a.size);
+    a.count = PageAllocVector(a.size, a.pages, VIRTUAL_VMALLOC_CHUNKS);
+    a.from = SpaceCreate();
+    a.to = SpaceCreate();
+
+    if((a.src != NULL) && (a.dst != NULL) && (a.count != 0) && (a.from != NULL) && (a.to != NULL))
+    {
+        memset(a.src, 0x5A, a.size);
+        memset(a.dst, 0, a.size);
+
+        if(a.size >= SLOW_SIZE)
+        {
+            BenchSetRuns(SLOW_RUNS);
+        }
+
+        BenchRun(BenchName(name, "bulk", "memcpy", size->name, NULL), OpCopy, &a, a.size);
+        BenchSetRuns(BENCH_RUNS);
+
+        BenchRun(BenchName(name, "bulk", "share", size->name, NULL), OpShare, &a, a.size);
+
+        // The sender owns the buffer before the first grant
+        IpcShare(a.from, (vaddr_t)BULK_VADDR, a.pages, a.count, IPC_MAP_WRITE);
+        BenchRun(BenchName(name, "bulk", "grant", size->name, NULL), OpGrant, &a, 2 * a.size);
+        IpcRevoke(a.from, (vaddr_t)BULK_VADDR, a.size);
+    }
+
+    if(a.from != NULL)
+    {
+        SpaceDestroy(a.from);
+    }
+
+    if(a.to != NULL)
+    {
+        SpaceDestroy(a.to);
+    }
+
+    if(a.count != 0)
+    {
+        PageFreeVector(a.pages, a.count);
+    }
+
+    if(a.dst != NULL)
+    {
+        VFree(a.dst);
+    }
+
+    if(a.src != NULL)
+    {
+        VFree(a.src);
+    }
+}
+
+void BenchStream(void)
+{
+    stream_arg_t s;
+    channel_t ch;
+    ipc_msg_t msg;
+
+    if(ChannelCreate(&ch, STREAM_RING_SIZE) != E_OK)
+    {
+        return;
+    }
+
+    s.ch = &ch;
+    s.buffer = VMalloc(STREAM_CHUNK);
+    s.doneEp = IpcEndpointCreate("stream done");
+    s.stop = FALSE;
+
+    if((s.buffer != NULL) && (s.doneEp >= 0) && (ThreadCreate("stream", StreamProducer, &s, SCHED_PRIORITY_DEFAULT, 1) != NULL))
+    {
+        BenchRun("bulk.channel.256k", OpStream, &s, STREAM_BYTES);
+
+        s.stop = TRUE;
+        IpcReceive(s.doneEp, &msg);
+    }
+
+    if(s.doneEp >= 0)
+    {
+        IpcEndpointDestroy(s.doneEp);
+    }
+
+    if(s.buffer != NULL)
+    {
+        VFree(s.buffer);
+    }
+
+    ChannelDestroy(&ch);
+}
+
+void BenchBulk(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < ARRAY_SIZE(Sizes); ++i)
+    {
+        BenchBulkSize(&Sizes[i]);
+    }
+
+    if(NR_CPUS > 1)
+    {
+        BenchStream();
+    }
+}
+
+BENCHMARK("bulk", BenchBulk);
@@ -0,0 +1,225 @@
+/**
+ * @file        bench_colour.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Cache Colouring Benchmarks
+ *
+ *              Two co-running tasks are modelled on one core: a latency
+ *              critical task chasing pointers over a working set that fits
+ *              in the L2 cache and a streaming task sweeping a buffer larger
+ *              than the L2 between its runs. With every colour shared the
+ *              stream evicts the working set; with disjoint colour budgets
+ *              the stream can only evict lines of its own colours.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <mmu.h>
+#include <page.h>
+#include <pmu.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t* head;
+    uint32_t  loads;
+    bool_t    stream;               // Run the streaming task first
+}corun_arg_t;
+
+typedef struct
+{
+    const char* name;
+    uint32_t    chaseMask;
+    uint32_t    streamMask;
+}partition_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define CHASE_VADDR     (BENCH_SCRATCH_VADDR)
+#define STREAM_VADDR    (BENCH_SCRATCH_VADDR + 0x1000000)
+
+// Working set of the latency critical task (3/8 of the L2)
+#define CHASE_SIZE      (192 * 1024)
+#define CHASE_STRIDE    (64)
+#define CHASE_LOADS     (CHASE_SIZE / CHASE_STRIDE)
+
+// Buffer swept by the streaming task (4 times the L2)
+#define STREAM_SIZE     (2 * 1024 * 1024)
+
+#define CORUN_RUNS      (16)
+
+static const partition_t Partitions[] =
+{
+    // Every colour shared, as with uncoloured allocation
+    {"shared",      PAGE_COLOURS_ALL,   PAGE_COLOURS_ALL},
+    // 12 colours (384Kb of L2) for the chase, 4 colours for the stream
+    {"partitioned", 0x0FFF,             0xF000},
+};
+
+static const uint32_t ColourEvents[] =
+{
+    PMU_EVT_L2D_REFILL,
+    PMU_EVT_L2D_ACCESS,
+    PMU_EVT_L1D_REFILL,
+    PMU_EVT_L1D_TLB_REFILL
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+#define NODE(n)             (*(uint32_t*)(CHASE_VADDR + ((n) * CHASE_STRIDE)))
+
+
+/* Private variables -------------------------------------- */
+
+static pbv_t chasePages[CHASE_SIZE / PAGE_SIZE];
+static pbv_t streamPages[STREAM_SIZE / PAGE_SIZE];
+
+static volatile uint32_t sink;
+
+static uint32_t seed;
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpCorun(void* arg);
+
+/**
+ * @brief   Allocates coloured pages and maps them
+ * @param   colours - Colour budget
+ *          vaddr - Virtual address
+ *          size - Size to map
+ *          pages - Page buffer vector
+ *          max - Entries available in pages
+ * @retval  Vector entries used, 0 on failure
+ */
+static size_t MapColoured(page_colours_t* colours, ulong_t vaddr, size_t size, pbv_t* pages, size_t max);
+
+/**
+ * @brief   Builds a random cyclic pointer chain over the chase working set
+ * @param   None
+ * @retval  Chain head
+ */
+static uint32_t* BuildChain(void);
+
+static void BenchColour(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpCorun(void* arg)
+{
+    corun_arg_t* corun = (corun_arg_t*)arg;
+    uint32_t* p = corun->head;
+    uint32_t i;
+
+    if(corun->stream)
+    {
+        // One write per cache line, the lines end up dirty in the L2
+        for(i = 0; i < STREAM_SIZE; i += CHASE_STRIDE)
+        {
+            *(volatile uint32_t*)(STREAM_VADDR + i) = i;
+        }
+    }
+
+    for(i = corun->loads; i != 0; i -= 4)
+    {
+        p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p;
+    }
+
+    sink = (uint32_t)p;
+}
+
+size_t MapColoured(page_colours_t* colours, ulong_t vaddr, size_t size, pbv_t* pages, size_t max)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    size_t count = PageAllocVectorColoured(colours, (vaddr_t)vaddr, size, pages, max);
+
+    if(count != 0)
+    {
+        MMU_MapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)vaddr, pages, count, &memCfg);
+    }
+
+    return count;
+}
+
+uint32_t* BuildChain(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < CHASE_LOADS; ++i)
+    {
+        NODE(i) = i;
+    }
+
+    // Sattolo's shuffle: a single cycle visiting every node
+    seed = 0x2545F491;
+    for(i = CHASE_LOADS - 1; i > 0; --i)
+    {
+        uint32_t j = BenchRandom(&seed) % i;
+        uint32_t tmp = NODE(i);
+        NODE(i) = NODE(j);
+        NODE(j) = tmp;
+    }
+
+    for(i = 0; i < CHASE_LOADS; ++i)
+    {
+        NODE(i) = CHASE_VADDR + (NODE(i) * CHASE_STRIDE);
+    }
+
+    return (uint32_t*)CHASE_VADDR;
+}
+
+void BenchColour(void)
+{
+    char name[BENCH_NAME_SIZE];
+    page_colours_t chaseColours, streamColours;
+    corun_arg_t corun;
+    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
+    uint32_t p;
+
+    BenchSetEvents(ColourEvents, ARRAY_SIZE(ColourEvents));
+    BenchSetRuns(CORUN_RUNS);
+
+    for(p = 0; p < ARRAY_SIZE(Partitions); ++p)
+    {
+        PageColoursInit(&chaseColours, Partitions[p].chaseMask, 0);
+        PageColoursInit(&streamColours, Partitions[p].streamMask, 0);
+
+        size_t chaseCount = MapColoured(&chaseColours, CHASE_VADDR, CHASE_SIZE, chasePages, ARRAY_SIZE(chasePages));
+        size_t streamCount = MapColoured(&streamColours, STREAM_VADDR, STREAM_SIZE, streamPages, ARRAY_SIZE(streamPages));
+
+        if((chaseCount != 0) && (streamCount != 0))
+        {
+            corun.head = BuildChain();
+            corun.loads = CHASE_LOADS;
+
+            corun.stream = FALSE;
+            BenchRun(BenchName(name, "colour", Partitions[p].name, "solo", NULL), OpCorun, &corun, CHASE_LOADS);
+
+            corun.stream = TRUE;
+            BenchRun(BenchName(name, "colour", Partitions[p].name, "corun", NULL), OpCorun, &corun, CHASE_LOADS);
+        }
+
+        if(chaseCount != 0)
+        {
+            MMU_UnmapPages(pgt, (vaddr_t)CHASE_VADDR, CHASE_SIZE);
+            PageFreeVectorColoured(&chaseColours, chasePages, chaseCount);
+        }
+
+        if(streamCount != 0)
+        {
+            MMU_UnmapPages(pgt, (vaddr_t)STREAM_VADDR, STREAM_SIZE);
+            PageFreeVectorColoured(&streamColours, streamPages, streamCount);
+        }
+    }
+}
+
+BENCHMARK_FLAGS("colour", BenchColour, BENCH_WINDOW);
@@ -0,0 +1,208 @@
+/**
+ * @file        bench_fault.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Demand Paging Benchmarks
+ *
+ *              A kernel thread enters an address space and writes one word
+ *              per page of a reserved region: every write takes a data
+ *              abort and maps a zeroed page. The same is done in a clone
+ *              of a populated space (copy-on-write) and in the parent once
+ *              the clone is gone (shared pages taken over without a copy).
+ *              Spawns reserve a region and touch part of it, so their cost
+ *              follows the memory touched and not the memory reserved.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <space.h>
+#include <fault.h>
+#include <page.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    const char* name;
+    size_t      reserved;
+    size_t      touched;
+}spawn_cfg_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define REGION_VADDR        (0x10000000)
+#define FAULT_PAGES         (64)
+
+static const spawn_cfg_t SpawnCfgs[] =
+{
+    {"fault.spawn.1m.touch64k",     0x100000,   0x10000},
+    {"fault.spawn.16m.touch64k",    0x1000000,  0x10000},
+    {"fault.spawn.16m.touch1m",     0x1000000,  0x100000},
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+
+/* Private variables -------------------------------------- */
+
+static space_t* parent;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Writes one word per page of the region
+ * @param   size - Bytes touched from the region start
+ * @retval  No return
+ */
+static void Touch(size_t size);
+
+static void OpZero(void* arg);
+
+static void OpCopy(void* arg);
+
+static void OpReuse(void* arg);
+
+static void OpSpawn(void* arg);
+
+static void BenchFault(void);
+
+
+/* Private functions -------------------------------------- */
+
+void Touch(size_t size)
+{
+    ulong_t vaddr;
+
+    for(vaddr = REGION_VADDR; vaddr < (REGION_VADDR + size); vaddr += PAGE_SIZE)
+    {
+        *(volatile uint32_t*)vaddr = vaddr;
+    }
+}
+
+void OpZero(void* arg)
+{
+    (void)arg;
+
+    SpaceReserve(parent, (vaddr_t)REGION_VADDR, FAULT_PAGES * PAGE_SIZE, SPACE_WRITE);
+    Touch(FAULT_PAGES * PAGE_SIZE);
+    SpaceRelease(parent, (vaddr_t)REGION_VADDR);
+}
+
+void OpCopy(void* arg)
+{
+    space_t* clone = SpaceClone(parent);
+
+    (void)arg;
+
+    if(clone != NULL)
+    {
+        SpaceEnter(clone);
+        Touch(FAULT_PAGES * PAGE_SIZE);
+        SpaceEnter(parent);
+        SpaceDestroy(clone);
+    }
+}
+
+void OpReuse(void* arg)
+{
+    space_t* clone = SpaceClone(parent);
+
+    (void)arg;
+
+    if(clone != NULL)
+    {
+        // Every page is back to one user, but still mapped read-only
+        SpaceDestroy(clone);
+        Touch(FAULT_PAGES * PAGE_SIZE);
+    }
+}
+
+void OpSpawn(void* arg)
+{
+    const spawn_cfg_t* cfg = (const spawn_cfg_t*)arg;
+    space_t* space = SpaceCreate();
+
+    if(space != NULL)
+    {
+        SpaceReserve(space, (vaddr_t)REGION_VADDR, cfg->reserved, SPACE_WRITE);
+        SpaceEnter(space);
+        Touch(cfg->touched);
+        SpaceEnter(NULL);
+        SpaceDestroy(space);
+    }
+}
+
+void BenchFault(void)
+{
+    char name[BENCH_NAME_SIZE];
+    fault_stats_t stats;
+    page_stats_t pages;
+    uint32_t i;
+
+    if((parent = SpaceCreate()) == NULL)
+    {
+        return;
+    }
+
+    SpaceEnter(parent);
+
+    // Reserve, populate and release the region: zero fill faults
+    BenchRun("fault.zero", OpZero, NULL, FAULT_PAGES);
+
+    // Populated parent region shared with a clone written to
+    SpaceReserve(parent, (vaddr_t)REGION_VADDR, FAULT_PAGES * PAGE_SIZE, SPACE_WRITE);
+    Touch(FAULT_PAGES * PAGE_SIZE);
+
+    BenchRun("fault.cow.copy", OpCopy, NULL, FAULT_PAGES);
+    BenchRun("fault.cow.reuse", OpReuse, NULL, FAULT_PAGES);
+
+    SpaceEnter(NULL);
+    SpaceDestroy(parent);
+
+    for(i = 0; i < ARRAY_SIZE(SpawnCfgs); ++i)
+    {
+        BenchRun(SpawnCfgs[i].name, OpSpawn, (void*)&SpawnCfgs[i], 1);
+    }
+
+    FaultStats(&stats);
+
+    BenchStat(BenchName(name, "fault", "zero", "count", NULL), stats.zeroFills);
+    BenchStat(BenchName(name, "fault", "copy", "count", NULL), stats.copies);
+    BenchStat(BenchName(name, "fault", "reuse", "count", NULL), stats.reuses);
+    BenchStat(BenchName(name, "fault", "fatal", NULL, NULL), stats.fatal);
+
+    // Handler cycles only (the abort entry and return are not included)
+    if(stats.zeroFills != 0)
+    {
+        BenchStat(BenchName(name, "fault", "zero", "cycles", NULL), (uint32_t)(stats.zeroCycles / stats.zeroFills));
+    }
+
+    if(stats.copies != 0)
+    {
+        BenchStat(BenchName(name, "fault", "copy", "cycles", NULL), (uint32_t)(stats.copyCycles / stats.copies));
+    }
+
+    if(stats.reuses != 0)
+    {
+        BenchStat(BenchName(name, "fault", "reuse", "cycles", NULL), (uint32_t)(stats.reuseCycles / stats.reuses));
+    }
+
+    // Zero fills served from the pages cleared by the idle CPUs
+    PageStats(&pages);
+
+    BenchStat(BenchName(name, "page", "zeroed", "hits", NULL), pages.zeroHits);
+    BenchStat(BenchName(name, "page", "zeroed", "misses", NULL), pages.zeroMisses);
+    BenchStat(BenchName(name, "page", "zeroed", "aborts", NULL), pages.zeroAborts);
+    BenchStat(BenchName(name, "page", "zeroed", "count", NULL), (uint32_t)pages.zeroedPages);
+}
+
+BENCHMARK("fault", BenchFault);
+
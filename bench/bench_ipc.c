@@ -0,0 +1,201 @@
+/**
+ * @file        bench_ipc.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       IPC Benchmarks
+ *
+ *              Call/reply ping-pong through the system call path between a
+ *              client and a server thread: kernel threads sharing the
+ *              address space, threads in two address spaces (TTBR0 and ASID
+ *              switched on every transfer, no TLB flush) and a server bound
+ *              to another CPU (no direct switch, wakeup through the
+ *              scheduler). Results are cycles per round trip.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <ipc.h>
+#include <syscall.h>
+#include <space.h>
+#include <sched.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    const char* name;
+    bool_t      spaces;             // Client and server in their own spaces
+    uint32_t    serverCpu;
+}pingpong_cfg_t;
+
+typedef struct
+{
+    const char* name;
+    uint32_t    ep;
+    uint32_t    doneEp;
+    space_t*    clientSpace;
+    space_t*    serverSpace;
+}pingpong_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define PINGPONG_ROUNDS     (64)
+#define PINGPONG_STOP       (0xFFFFFFFF)
+
+static const pingpong_cfg_t PingPongCfgs[] =
+{
+    {"ipc.call.kernel",     FALSE,  0},
+    {"ipc.call.space",      TRUE,   0},
+    {"ipc.call.remote",     TRUE,   1},
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Server: replies to every call with the first word incremented
+ * @param   arg - Ping-pong setup
+ * @retval  No return
+ */
+static void PingPongServer(void* arg);
+
+/**
+ * @brief   Client: measures the calls and stops the server
+ * @param   arg - Ping-pong setup
+ * @retval  No return
+ */
+static void PingPongClient(void* arg);
+
+static void OpCall(void* arg);
+
+static void BenchIpc(void);
+
+
+/* Private functions -------------------------------------- */
+
+void PingPongServer(void* arg)
+{
+    pingpong_t* pp = (pingpong_t*)arg;
+    ipc_msg_t msg;
+
+    if(pp->serverSpace != NULL)
+    {
+        SpaceEnter(pp->serverSpace);
+    }
+
+    SysIpcReceive(pp->ep, &msg);
+
+    while(msg.w[0] != PINGPONG_STOP)
+    {
+        msg.w[0]++;
+        SysIpcReplyWait(pp->ep, &msg);
+    }
+
+    SpaceEnter(NULL);
+
+    IpcSend(pp->doneEp, &msg);
+}
+
+void PingPongClient(void* arg)
+{
+    pingpong_t* pp = (pingpong_t*)arg;
+    ipc_msg_t msg = {{PINGPONG_STOP, 0, 0, 0}};
+
+    if(pp->clientSpace != NULL)
+    {
+        SpaceEnter(pp->clientSpace);
+    }
+
+    BenchRun(pp->name, OpCall, pp, PINGPONG_ROUNDS);
+
+    SysIpcSend(pp->ep, &msg);
+
+    SpaceEnter(NULL);
+
+    IpcSend(pp->doneEp, &msg);
+}
+
+void OpCall(void* arg)
+{
+    pingpong_t* pp = (pingpong_t*)arg;
+    ipc_msg_t msg = {{0, 1, 2, 3}};
+    uint32_t i;
+
+    for(i = 0; i < PINGPONG_ROUNDS; ++i)
+    {
+        SysIpcCall(pp->ep, &msg);
+    }
+}
+
+void BenchIpc(void)
+{
+    char name[BENCH_NAME_SIZE];
+    ipc_stats_t stats;
+    pingpong_t pp;
+    ipc_msg_t msg;
+    uint32_t i;
+
+    pp.ep = IpcEndpointCreate("pingpong");
+    pp.doneEp = IpcEndpointCreate("pingpong done");
+
+    for(i = 0; i < ARRAY_SIZE(PingPongCfgs); ++i)
+    {
+        const pingpong_cfg_t* cfg = &PingPongCfgs[i];
+
+        if(cfg->serverCpu >= NR_CPUS)
+        {
+            continue;
+        }
+
+        pp.name = cfg->name;
+        pp.clientSpace = cfg->spaces ? SpaceCreate() : NULL;
+        pp.serverSpace = cfg->spaces ? SpaceCreate() : NULL;
+
+        if(!cfg->spaces || ((pp.clientSpace != NULL) && (pp.serverSpace != NULL)))
+        {
+            // The server waits first, so every call finds it receiving. Its
+            // CPU may not be online
+            if(ThreadCreate("ipc-server", PingPongServer, &pp, SCHED_PRIORITY_DEFAULT + 1, cfg->serverCpu) != NULL)
+            {
+                ThreadCreate("ipc-client", PingPongClient, &pp, SCHED_PRIORITY_DEFAULT, CPU_Id());
+
+                // Both threads are out of their spaces once they report
+                IpcReceive(pp.doneEp, &msg);
+                IpcReceive(pp.doneEp, &msg);
+            }
+        }
+
+        if(pp.clientSpace != NULL)
+        {
+            SpaceDestroy(pp.clientSpace);
+        }
+
+        if(pp.serverSpace != NULL)
+        {
+            SpaceDestroy(pp.serverSpace);
+        }
+    }
+
+    IpcEndpointDestroy(pp.ep);
+    IpcEndpointDestroy(pp.doneEp);
+
+    IpcStats(&stats);
+
+    BenchStat(BenchName(name, "ipc", "calls", NULL, NULL), stats.calls);
+    BenchStat(BenchName(name, "ipc", "handoffs", NULL, NULL), stats.handoffs);
+    BenchStat(BenchName(name, "ipc", "queued", NULL, NULL), stats.queued);
+}
+
+BENCHMARK("ipc", BenchIpc);
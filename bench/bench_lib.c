@@ -0,0 +1,122 @@
+/**
+ * @file        bench_lib.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Memory and String Routines Benchmarks
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <string.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint8_t* dst;
+    uint8_t* src;
+    size_t   size;
+}copy_arg_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define BUFFER_SIZE     (32 * 1024)
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static uint8_t srcBuffer[BUFFER_SIZE] __attribute__((aligned(64)));
+static uint8_t dstBuffer[BUFFER_SIZE] __attribute__((aligned(64)));
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpMemcpy(void* arg);
+
+static void OpMemmove(void* arg);
+
+static void OpMemset(void* arg);
+
+static void OpMemcmp(void* arg);
+
+static void OpStrlen(void* arg);
+
+
+static void BenchLib(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpMemcpy(void* arg)
+{
+    copy_arg_t* copy = (copy_arg_t*)arg;
+    memcpy(copy->dst, copy->src, copy->size);
+}
+
+void OpMemmove(void* arg)
+{
+    copy_arg_t* copy = (copy_arg_t*)arg;
+    memmove(copy->dst, copy->src, copy->size);
+}
+
+void OpMemset(void* arg)
+{
+    copy_arg_t* copy = (copy_arg_t*)arg;
+    memset(copy->dst, 0, copy->size);
+}
+
+void OpMemcmp(void* arg)
+{
+    copy_arg_t* copy = (copy_arg_t*)arg;
+    memcmp(copy->dst, copy->src, copy->size);
+}
+
+void OpStrlen(void* arg)
+{
+    copy_arg_t* copy = (copy_arg_t*)arg;
+    strlen((const char*)copy->src);
+}
+
+void BenchLib(void)
+{
+    copy_arg_t arg;
+
+    // Non zero source so strlen walks the whole buffer
+    memset(srcBuffer, 'a', BUFFER_SIZE);
+    srcBuffer[BUFFER_SIZE - 1] = '\0';
+
+    arg.dst = dstBuffer; arg.src = srcBuffer;
+
+    arg.size = 64;
+    BenchRun("lib.memcpy.64", OpMemcpy, &arg, arg.size);
+    arg.size = 4096;
+    BenchRun("lib.memcpy.4k", OpMemcpy, &arg, arg.size);
+    arg.size = BUFFER_SIZE;
+    BenchRun("lib.memcpy.32k", OpMemcpy, &arg, arg.size);
+
+    // Misaligned source and destination
+    arg.dst = dstBuffer + 1; arg.src = srcBuffer + 3; arg.size = 4096;
+    BenchRun("lib.memcpy.4k_unaligned", OpMemcpy, &arg, arg.size);
+
+    // Overlapping backward move
+    arg.dst = dstBuffer + 64; arg.src = dstBuffer; arg.size = 4096;
+    BenchRun("lib.memmove.4k_overlap", OpMemmove, &arg, arg.size);
+
+    arg.dst = dstBuffer; arg.src = srcBuffer; arg.size = 4096;
+    BenchRun("lib.memset.4k", OpMemset, &arg, arg.size);
+
+    memcpy(dstBuffer, srcBuffer, BUFFER_SIZE);
+    arg.size = 4096;
+    BenchRun("lib.memcmp.4k", OpMemcmp, &arg, arg.size);
+
+    BenchRun("lib.strlen.32k", OpStrlen, &arg, BUFFER_SIZE - 1);
+}
+
+BENCHMARK("lib", BenchLib);
@@ -0,0 +1,87 @@
+/**
+ * @file        bench_loader.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Server Loader Benchmarks
+ *
+ *              Every server bundled in the image is loaded in a new address
+ *              space with its segments mapped in place and with every
+ *              segment copied (LOADER_COPY), the way images were loaded
+ *              before. Results are cycles per load, space creation and
+ *              destruction included. Nothing runs if no server is bundled.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <loader.h>
+#include <space.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    const loader_image_t* image;
+    uint32_t              flags;
+}load_t;
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpLoad(void* arg);
+
+static void BenchLoader(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpLoad(void* arg)
+{
+    load_t* load = (load_t*)arg;
+    space_t* space = SpaceCreate();
+    vaddr_t entry;
+
+    if(space != NULL)
+    {
+        LoaderLoad(load->image, space, load->flags, &entry);
+        SpaceDestroy(space);
+    }
+}
+
+void BenchLoader(void)
+{
+    char name[BENCH_NAME_SIZE];
+    loader_stats_t stats;
+    load_t load;
+    uint32_t i;
+
+    for(i = 0; (load.image = LoaderImage(i)) != NULL; ++i)
+    {
+        load.flags = 0;
+        BenchRun(BenchName(name, "loader", load.image->name, "map", NULL), OpLoad, &load, 1);
+
+        load.flags = LOADER_COPY;
+        BenchRun(BenchName(name, "loader", load.image->name, "copy", NULL), OpLoad, &load, 1);
+    }
+
+    LoaderStats(&stats);
+
+    BenchStat(BenchName(name, "loader", "loads", NULL, NULL), stats.loads);
+    BenchStat(BenchName(name, "loader", "mapped", NULL, NULL), stats.mapped);
+    BenchStat(BenchName(name, "loader", "shared", NULL, NULL), stats.shared);
+    BenchStat(BenchName(name, "loader", "copied", NULL, NULL), stats.copied);
+    BenchStat(BenchName(name, "loader", "zeroed", NULL, NULL), stats.zeroed);
+}
+
+BENCHMARK("loader", BenchLoader);
@@ -0,0 +1,364 @@
+/**
+ * @file        bench_mem.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Memory Bandwidth and Latency Benchmarks
+ *
+ *              The scratch memory is mapped twice: a write-allocate alias
+ *              used to prepare the buffers and a test mapping that is
+ *              remapped with every cache and access policy. Bandwidth is
+ *              measured with the STREAM kernels (copy, scale, add, triad)
+ *              plus a read only sum, latency with a random pointer chase
+ *              over cache lines. Working sets sweep L1, L2 and DDR.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <mmu.h>
+#include <cache.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t* a;
+    uint32_t* b;
+    uint32_t* c;
+    uint32_t  words;
+}stream_arg_t;
+
+typedef struct
+{
+    uint32_t* head;
+    uint32_t  loads;
+}chase_arg_t;
+
+typedef struct
+{
+    uint8_t     policy;
+    const char* name;
+    uint32_t    maxSize;            // Largest working set measured
+}policy_t;
+
+typedef struct
+{
+    uint32_t    size;
+    const char* name;
+}wset_t;
+
+
+/* Private constants -------------------------------------- */
+
+// Write-allocate alias used to initialize the buffers
+#define SETUP_VADDR     (BENCH_SCRATCH_VADDR)
+// Mapping under test
+#define TEST_VADDR      (BENCH_SCRATCH_VADDR + BENCH_SCRATCH_SIZE)
+
+// Pointer chase node size (largest cache line of both cores)
+#define CHASE_STRIDE    (64)
+#define CHASE_LOADS     (4096)
+
+#define SCALAR          (3)
+
+// Working sets from this size on use fewer runs
+#define SLOW_SIZE       (1024 * 1024)
+#define SLOW_RUNS       (8)
+
+static const policy_t CachePolicies[] =
+{
+    // Non cacheable memory does not depend on the working set size
+    {CPOLICY_STRONGLY_ORDERED,  "so",   64 * 1024},
+    {CPOLICY_UNCACHED,          "nc",   64 * 1024},
+    {CPOLICY_WRITETHROUGH,      "wt",   8 * 1024 * 1024},
+    {CPOLICY_WRITEBACK,         "wb",   8 * 1024 * 1024},
+    {CPOLICY_WRITEALLOC,        "wa",   8 * 1024 * 1024},
+};
+
+static const policy_t AccessPolicies[] =
+{
+    {APOLICY_RWNA,  "rwna", 0},
+    {APOLICY_RWRO,  "rwro", 0},
+    {APOLICY_RWRW,  "rwrw", 0},
+    {APOLICY_RONA,  "rona", 0},
+    {APOLICY_RORO,  "roro", 0},
+};
+
+static const wset_t Sizes[] =
+{
+    {8 * 1024,          "8k"},
+    {16 * 1024,         "16k"},
+    {64 * 1024,         "64k"},
+    {256 * 1024,        "256k"},
+    {1024 * 1024,       "1m"},
+    {4 * 1024 * 1024,   "4m"},
+    {8 * 1024 * 1024,   "8m"},
+};
+
+// Working set used for the access policy runs (L1 resident)
+#define ACCESS_SIZE_INDEX   (1)
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+// Pointer chase node n (setup alias)
+#define NODE(n)             (*(uint32_t*)(SETUP_VADDR + ((n) * CHASE_STRIDE)))
+
+
+/* Private variables -------------------------------------- */
+
+static volatile uint32_t sink;
+
+static uint32_t seed;
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpCopy(void* arg);
+
+static void OpScale(void* arg);
+
+static void OpAdd(void* arg);
+
+static void OpTriad(void* arg);
+
+static void OpRead(void* arg);
+
+static void OpChase(void* arg);
+
+/**
+ * @brief   Maps the test window with the given policies
+ * @param   cpolicy - Cache policy
+ *          apolicy - Access policy
+ * @retval  No return
+ */
+static void MapTest(uint8_t cpolicy, uint8_t apolicy);
+
+/**
+ * @brief   Unmaps the test window, writing back and dropping its cache lines
+ * @param   None
+ * @retval  No return
+ */
+static void UnmapTest(void);
+
+/**
+ * @brief   Builds a random cyclic pointer chain over size bytes. The chain
+ *          is written through the setup alias and points to the test window
+ * @param   size - Working set size
+ * @retval  Chain head (test window address)
+ */
+static uint32_t* BuildChain(uint32_t size);
+
+/**
+ * @brief   Runs the bandwidth and latency measurements for one working set
+ * @param   prefix - Name prefix (policy)
+ *          size - Working set size
+ *          readOnly - Skip the measurements that write to the test window
+ * @retval  No return
+ */
+static void MeasureSet(const char* prefix, const wset_t* size, bool_t readOnly);
+
+static void BenchMem(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpCopy(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint32_t i;
+    for(i = 0; i < s->words; ++i)
+    {
+        s->c[i] = s->a[i];
+    }
+}
+
+void OpScale(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint32_t i;
+    for(i = 0; i < s->words; ++i)
+    {
+        s->b[i] = SCALAR * s->c[i];
+    }
+}
+
+void OpAdd(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint32_t i;
+    for(i = 0; i < s->words; ++i)
+    {
+        s->c[i] = s->a[i] + s->b[i];
+    }
+}
+
+void OpTriad(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint32_t i;
+    for(i = 0; i < s->words; ++i)
+    {
+        s->a[i] = s->b[i] + SCALAR * s->c[i];
+    }
+}
+
+void OpRead(void* arg)
+{
+    stream_arg_t* s = (stream_arg_t*)arg;
+    uint32_t i, sum = 0;
+    for(i = 0; i < s->words; ++i)
+    {
+        sum += s->a[i];
+    }
+    sink = sum;
+}
+
+void OpChase(void* arg)
+{
+    chase_arg_t* chase = (chase_arg_t*)arg;
+    uint32_t* p = chase->head;
+    uint32_t i;
+
+    // Unrolled so the loop overhead hides behind the load latency
+    for(i = chase->loads; i != 0; i -= 8)
+    {
+        p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p;
+        p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p;
+    }
+
+    sink = (uint32_t)p;
+}
+
+void MapTest(uint8_t cpolicy, uint8_t apolicy)
+{
+    memCfg_t memCfg = {cpolicy, apolicy, TRUE, FALSE, TRUE};
+    pbv_t scratch = {BenchScratch(), BENCH_SCRATCH_SIZE};
+
+    MMU_MapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)TEST_VADDR, &scratch, 1, &memCfg);
+}
+
+void UnmapTest(void)
+{
+    // Same physical memory is used with other attributes next time
+    v7_flush_dcache_range((vaddr_t)TEST_VADDR, (vaddr_t)(TEST_VADDR + BENCH_SCRATCH_SIZE));
+    MMU_UnmapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)TEST_VADDR, BENCH_SCRATCH_SIZE);
+}
+
+uint32_t* BuildChain(uint32_t size)
+{
+    uint32_t nodes = size / CHASE_STRIDE;
+    uint32_t i;
+
+    for(i = 0; i < nodes; ++i)
+    {
+        NODE(i) = i;
+    }
+
+    // Sattolo's shuffle: a single cycle visiting every node
+    seed = 0x2545F491;
+    for(i = nodes - 1; i > 0; --i)
+    {
+        uint32_t j = BenchRandom(&seed) % i;
+        uint32_t tmp = NODE(i);
+        NODE(i) = NODE(j);
+        NODE(j) = tmp;
+    }
+
+    for(i = 0; i < nodes; ++i)
+    {
+        NODE(i) = TEST_VADDR + (NODE(i) * CHASE_STRIDE);
+    }
+
+    // Make the chain visible through non cacheable test mappings
+    v7_flush_dcache_range((vaddr_t)SETUP_VADDR, (vaddr_t)(SETUP_VADDR + size));
+
+    return (uint32_t*)TEST_VADDR;
+}
+
+void MeasureSet(const char* prefix, const wset_t* size, bool_t readOnly)
+{
+    char name[BENCH_NAME_SIZE];
+    stream_arg_t stream;
+    chase_arg_t chase;
+    uint32_t words = size->size / (3 * sizeof(uint32_t));
+    uint32_t i;
+
+    BenchSetRuns((size->size >= SLOW_SIZE) ? SLOW_RUNS : BENCH_RUNS);
+
+    // Three arrays sharing the working set
+    stream.a = (uint32_t*)TEST_VADDR;
+    stream.b = stream.a + words;
+    stream.c = stream.b + words;
+    stream.words = words;
+
+    for(i = 0; i < 3 * words; ++i)
+    {
+        ((uint32_t*)SETUP_VADDR)[i] = i;
+    }
+    v7_flush_dcache_range((vaddr_t)SETUP_VADDR, (vaddr_t)(SETUP_VADDR + size->size));
+
+    BenchRun(BenchName(name, "mem", prefix, size->name, "read"), OpRead, &stream, words * 4);
+
+    if(!readOnly)
+    {
+        BenchRun(BenchName(name, "mem", prefix, size->name, "copy"), OpCopy, &stream, words * 8);
+        BenchRun(BenchName(name, "mem", prefix, size->name, "scale"), OpScale, &stream, words * 8);
+        BenchRun(BenchName(name, "mem", prefix, size->name, "add"), OpAdd, &stream, words * 12);
+        BenchRun(BenchName(name, "mem", prefix, size->name, "triad"), OpTriad, &stream, words * 12);
+        // Keep the chain away from the lines dirtied through the test mapping
+        v7_flush_dcache_range((vaddr_t)TEST_VADDR, (vaddr_t)(TEST_VADDR + size->size));
+    }
+
+    chase.head = BuildChain(size->size);
+    chase.loads = CHASE_LOADS;
+    BenchRun(BenchName(name, "mem", prefix, size->name, "latency"), OpChase, &chase, CHASE_LOADS);
+}
+
+void BenchMem(void)
+{
+    memCfg_t setupCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    pbv_t scratch = {BenchScratch(), BENCH_SCRATCH_SIZE};
+    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
+    uint32_t p, s;
+
+    if(scratch.data == NULL)
+    {
+        return;
+    }
+
+    MMU_MapPages(pgt, (vaddr_t)SETUP_VADDR, &scratch, 1, &setupCfg);
+
+    // Cache policies: full working set sweep
+    for(p = 0; p < ARRAY_SIZE(CachePolicies); ++p)
+    {
+        MapTest(CachePolicies[p].policy, APOLICY_RWNA);
+
+        for(s = 0; (s < ARRAY_SIZE(Sizes)) && (Sizes[s].size <= CachePolicies[p].maxSize); ++s)
+        {
+            MeasureSet(CachePolicies[p].name, &Sizes[s], FALSE);
+        }
+
+        UnmapTest();
+    }
+
+    // Access policies: write-allocate memory, L1 resident working set
+    for(p = 0; p < ARRAY_SIZE(AccessPolicies); ++p)
+    {
+        uint8_t apolicy = AccessPolicies[p].policy;
+
+        MapTest(CPOLICY_WRITEALLOC, apolicy);
+        MeasureSet(AccessPolicies[p].name, &Sizes[ACCESS_SIZE_INDEX],
+                   (apolicy == APOLICY_RONA) || (apolicy == APOLICY_RORO));
+        UnmapTest();
+    }
+
+    v7_flush_dcache_range((vaddr_t)SETUP_VADDR, (vaddr_t)(SETUP_VADDR + BENCH_SCRATCH_SIZE));
+    MMU_UnmapPages(pgt, (vaddr_t)SETUP_VADDR, BENCH_SCRATCH_SIZE);
+}
+
+BENCHMARK_FLAGS("mem", BenchMem, BENCH_WINDOW);
@@ -0,0 +1,92 @@
+/**
+ * @file        bench_mmu.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       MMU Mapping Benchmarks
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <mmu.h>
+#include <page.h>
+#include <virtual.h>
+#include <string.h>
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private constants -------------------------------------- */
+
+// Mapped memory: 16Mb blocks followed by 1Mb blocks (1Mb multiple)
+#define MAP_SIZE        (0x2A00000)
+#define MAP_MAX_PAGES   (8)
+
+// Destination crossing a 16MB boundary of the mapping
+#define COPY_OFFSET     (0x1FFFFC0)
+
+static const char test_string[] = "qvNqTZp1Z0yjuUXv6PHmyLWv0cUP7SHr2o2caUsvDz9oxhDQI9lLp2meDyEBvPW6lvYtuIC8nVEGgHDgLIW62zOpJKjOlem3sIoRgXz1tI3tPwIk8npEEASnMoDHYsjAebaViYDXBvU4FBBNyblmizLqaZFnSd5ebPHVD1006G4MMLFR3THV7mcJpeKHU6KVSRfKlh5ixYgoOevK59csJfpEIdEDDWNDpF95YGHzrlKUoKqia6AIonMXUZgG2AOkOg0VHmrCN7U99wONsa1NNW7KhiSskc2bzJlROKCFlgiLo4FfS1XKGLQCAxREVlKFXcG7rGemkwhdXuDM1nYxFUYn56YPvuGbrLZl0MZn6gM28nq5og2GeSCxID2XCGmoovUGmZdxuchwaInjSrHJRpLPZy5WEjLi0BNa14bHXzZpHYXOYXyX7d6uUHUlvrJYCLaiyoPppV0rKJSa6zBA6pjEplm9Sv6wYQZHskTYD3NPTj1qKkumRC6u9Ndycsp27brPtcZKNGqfH8WXjCRIDJ7TDrUtKKJZP4gESedmUsDO4U1S3fuIlMgpBTKfIjCuWV1EJJtNWtVr3dOJBMz6sW7e";
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+
+static pbv_t pages[MAP_MAX_PAGES];
+static size_t pagesCount;
+
+static vaddr_t mapVaddr;
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpMapPages(void* arg);
+
+static void OpCopy(void* arg);
+
+
+static void BenchMmu(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpMapPages(void* arg)
+{
+    MMU_MapPages((pgt_t)arg, mapVaddr, pages, pagesCount, &memCfg);
+}
+
+void OpCopy(void* arg)
+{
+    memcpy((void*)((ulong_t)mapVaddr + COPY_OFFSET), test_string, sizeof(test_string));
+}
+
+void BenchMmu(void)
+{
+    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
+
+    pagesCount = PageAllocVector(MAP_SIZE, pages, MAP_MAX_PAGES);
+    mapVaddr = VirtualAlloc(MAP_SIZE, 0);
+
+    if((pagesCount == 0) || (mapVaddr == NULL))
+    {
+        PageFreeVector(pages, pagesCount);
+        VirtualFree(mapVaddr);
+        return;
+    }
+
+    // Remapping the same range leaves the page table unchanged between runs
+    BenchRun("mmu.map_pages", OpMapPages, pgt, pagesCount);
+
+    BenchRun("mmu.copy_cross_section", OpCopy, NULL, sizeof(test_string));
+
+    MMU_UnmapPages(pgt, mapVaddr, MAP_SIZE);
+    PageFreeVector(pages, pagesCount);
+    VirtualFree(mapVaddr);
+}
+
+BENCHMARK("mmu", BenchMmu);
@@ -0,0 +1,321 @@
+/**
+ * @file        bench_sched.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Scheduler Benchmarks
+ *
+ *              Yield ping-pong between two threads bound to the running CPU
+ *              gives the cost of a thread switch, then again with both
+ *              threads touching the FPU between yields (lazy save and
+ *              restore of the VFP bank on every switch). A batch of CPU bound
+ *              workers is then run bound to CPU 0 and free to spread over
+ *              every CPU (placed on wakeup and stolen by idle CPUs), and the
+ *              per-CPU run queue statistics are reported.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <sched.h>
+#include <atomic.h>
+#include <pmu.h>
+#include <vfp.h>
+#include <ipi.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t affinity;
+    uint32_t workers;
+}spread_arg_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define PINGPONG_YIELDS     (256)
+
+// Four cores' worth of work, split in more workers than CPUs
+#define SPREAD_WORKERS      (4 * NR_CPUS)
+#define SPREAD_LOOPS        (200000)
+
+#define SCHED_RUNS          (8)
+
+// Yields waited for the FPU check threads of the secondary CPUs
+#define VFP_CHECK_YIELDS    (100000)
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static volatile bool_t partnerStop;
+static volatile bool_t partnerVfp;
+static atomic_t workersDone;
+static atomic_t vfpChecked;
+static volatile uint32_t sink;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Executes a VFP instruction (traps on first use after a switch)
+ * @param   None
+ * @retval  No return
+ */
+static inline void VfpTouch(void);
+
+/**
+ * @brief   Partner thread of the ping-pong: yields until stopped
+ * @param   arg - Not used
+ * @retval  No return
+ */
+static void PingPongPartner(void* arg);
+
+static void OpYield(void* arg);
+
+static void OpYieldVfp(void* arg);
+
+/**
+ * @brief   CPU bound worker: a fixed amount of work, then exits
+ * @param   arg - Not used
+ * @retval  No return
+ */
+static void SpreadWorker(void* arg);
+
+static void OpSpread(void* arg);
+
+/**
+ * @brief   FPU check thread: one VFP instruction on the CPU it is bound to
+ * @param   arg - Not used
+ * @retval  No return
+ */
+static void VfpCheckWorker(void* arg);
+
+/**
+ * @brief   Runs a VFP instruction on every secondary CPU and prints how
+ *          many CPUs completed it
+ * @param   None
+ * @retval  No return
+ */
+static void CheckVfpCpus(void);
+
+/**
+ * @brief   Prints the run queue statistics of every CPU
+ * @param   None
+ * @retval  No return
+ */
+static void PrintSchedStats(void);
+
+/**
+ * @brief   Prints the lazy VFP switching statistics (all CPUs)
+ * @param   None
+ * @retval  No return
+ */
+static void PrintVfpStats(void);
+
+static void BenchSched(void);
+
+
+/* Private functions -------------------------------------- */
+
+void VfpTouch(void)
+{
+    asm volatile(".fpu vfpv3    \n"
+                 "vmov.f64 d0, d0" : : : "memory");
+}
+
+void PingPongPartner(void* arg)
+{
+    (void)arg;
+
+    while(!partnerStop)
+    {
+        if(partnerVfp)
+        {
+            VfpTouch();
+        }
+
+        ThreadYield();
+    }
+}
+
+void OpYield(void* arg)
+{
+    uint32_t i;
+
+    (void)arg;
+
+    // Every yield is two switches: to the partner and back
+    for(i = 0; i < PINGPONG_YIELDS; ++i)
+    {
+        ThreadYield();
+    }
+}
+
+void OpYieldVfp(void* arg)
+{
+    uint32_t i;
+
+    (void)arg;
+
+    for(i = 0; i < PINGPONG_YIELDS; ++i)
+    {
+        VfpTouch();
+        ThreadYield();
+    }
+}
+
+void SpreadWorker(void* arg)
+{
+    uint32_t i, acc = 0;
+
+    (void)arg;
+
+    for(i = 0; i < SPREAD_LOOPS; ++i)
+    {
+        acc = (acc * 1664525) + 1013904223;
+    }
+
+    sink = acc;
+
+    Atomic_Inc(&workersDone);
+}
+
+void OpSpread(void* arg)
+{
+    spread_arg_t* spread = (spread_arg_t*)arg;
+    uint32_t i;
+
+    Atomic_Set(&workersDone, 0);
+    spread->workers = 0;
+
+    for(i = 0; i < SPREAD_WORKERS; ++i)
+    {
+        if(ThreadCreate("worker", SpreadWorker, NULL, SCHED_PRIORITY_DEFAULT, spread->affinity) != NULL)
+        {
+            spread->workers++;
+        }
+    }
+
+    // Same priority as the workers: yielding lets the CPU 0 share run
+    while((uint32_t)Atomic_Read(&workersDone) != spread->workers)
+    {
+        ThreadYield();
+    }
+}
+
+void VfpCheckWorker(void* arg)
+{
+    (void)arg;
+
+    VfpTouch();
+
+    Atomic_Inc(&vfpChecked);
+}
+
+void CheckVfpCpus(void)
+{
+    char name[BENCH_NAME_SIZE];
+    uint32_t online = IpiOnlineMask();
+    uint32_t cpu, i;
+    uint32_t started = 0;
+
+    Atomic_Set(&vfpChecked, 0);
+
+    for(cpu = 1; cpu < NR_CPUS; ++cpu)
+    {
+        if((online & (1 << cpu)) &&
+           (ThreadCreate("vfp check", VfpCheckWorker, NULL, SCHED_PRIORITY_DEFAULT, cpu) != NULL))
+        {
+            started++;
+        }
+    }
+
+    // A CPU whose trap fails stops in the undef handler: bounded wait
+    for(i = 0; (i < VFP_CHECK_YIELDS) && ((uint32_t)Atomic_Read(&vfpChecked) != started); ++i)
+    {
+        ThreadYield();
+    }
+
+    BenchStat(BenchName(name, "vfp", "secondary", "started", NULL), started);
+    BenchStat(BenchName(name, "vfp", "secondary", "ok", NULL), (uint32_t)Atomic_Read(&vfpChecked));
+}
+
+void PrintSchedStats(void)
+{
+    char name[BENCH_NAME_SIZE];
+    char cpuName[5] = {'c', 'p', 'u', '0', '\0'};
+    sched_stats_t stats;
+    uint32_t cpu;
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        if(SchedStats(cpu, &stats) != E_OK)
+        {
+            continue;
+        }
+
+        cpuName[3] = '0' + cpu;
+
+        BenchStat(BenchName(name, "sched", cpuName, "switches", NULL), stats.switches);
+        BenchStat(BenchName(name, "sched", cpuName, "steals", NULL), stats.steals);
+        BenchStat(BenchName(name, "sched", cpuName, "wakeups", NULL), stats.wakeups);
+        BenchStat(BenchName(name, "sched", cpuName, "remote", NULL), stats.remoteWakeups);
+
+        if(stats.switches != 0)
+        {
+            BenchStat(BenchName(name, "sched", cpuName, "cycles_per_switch", NULL), (uint32_t)(stats.scheduleCycles / stats.switches));
+        }
+    }
+}
+
+void PrintVfpStats(void)
+{
+    char name[BENCH_NAME_SIZE];
+    vfp_stats_t stats;
+
+    VfpStats(&stats);
+
+    BenchStat(BenchName(name, "vfp", "traps", NULL, NULL), stats.traps);
+    BenchStat(BenchName(name, "vfp", "saves", NULL, NULL), stats.saves);
+    BenchStat(BenchName(name, "vfp", "restores", NULL, NULL), stats.restores);
+    BenchStat(BenchName(name, "vfp", "migrations", NULL, NULL), stats.migrations);
+    BenchStat(BenchName(name, "vfp", "kernel", NULL, NULL), stats.kernel);
+}
+
+void BenchSched(void)
+{
+    spread_arg_t spread;
+
+    partnerStop = FALSE;
+
+    if(ThreadCreate("partner", PingPongPartner, NULL, SchedCurrent()->priority, CPU_Id()) != NULL)
+    {
+        BenchRun("sched.yield.pingpong", OpYield, NULL, 2 * PINGPONG_YIELDS);
+
+        partnerVfp = TRUE;
+        BenchRun("sched.yield.pingpong.vfp", OpYieldVfp, NULL, 2 * PINGPONG_YIELDS);
+
+        partnerStop = TRUE;
+        ThreadYield();
+    }
+
+    BenchSetRuns(SCHED_RUNS);
+
+    spread.affinity = 0;
+    BenchRun("sched.spread.cpu0", OpSpread, &spread, SPREAD_WORKERS);
+
+    spread.affinity = THREAD_CPU_ANY;
+    BenchRun("sched.spread.any", OpSpread, &spread, SPREAD_WORKERS);
+
+    CheckVfpCpus();
+
+    PrintSchedStats();
+    PrintVfpStats();
+}
+
+BENCHMARK("sched", BenchSched);
@@ -0,0 +1,160 @@
+/**
+ * @file        bench_shootdown.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       IPI and TLB Shootdown Benchmarks
+ *
+ *              Maps pages of the scratch memory one by one (4Kb entries)
+ *              and unmaps them, each unmap on its own or all in one batch,
+ *              with broadcast TLB maintenance and with IPI shootdowns.
+ *              Units are pages. Also measures the round trip of an empty
+ *              IPI call to every other CPU and reports the IPIs sent per
+ *              shootdown.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <mmu.h>
+#include <tlb.h>
+#include <ipi.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    pbv_t*  pages;
+    bool_t  batched;
+}shootdown_arg_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define TEST_VADDR          (BENCH_SCRATCH_VADDR)
+
+// Pages unmapped per run (one L2 page table)
+#define SHOOTDOWN_PAGES     (64)
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static pbv_t pages[SHOOTDOWN_PAGES];
+
+static shootdown_arg_t shootdown = {pages, FALSE};
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Maps the pages and unmaps them one by one
+ * @param   arg - Setup (batched: one shootdown for all the unmaps)
+ * @retval  No return
+ */
+static void OpShootdown(void* arg);
+
+static void OpIpiNop(void* arg);
+
+static void OpIpiCall(void* arg);
+
+static void BenchShootdownMode(const char* mode);
+
+static void BenchShootdown(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpShootdown(void* arg)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    shootdown_arg_t* s = (shootdown_arg_t*)arg;
+    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
+    uint32_t i;
+
+    MMU_MapPages(pgt, (vaddr_t)TEST_VADDR, s->pages, SHOOTDOWN_PAGES, &memCfg);
+
+    if(s->batched)
+    {
+        TlbBatchBegin();
+    }
+
+    for(i = 0; i < SHOOTDOWN_PAGES; ++i)
+    {
+        MMU_UnmapPages(pgt, (vaddr_t)(TEST_VADDR + (i * PAGE_SIZE)), PAGE_SIZE);
+    }
+
+    if(s->batched)
+    {
+        TlbBatchEnd();
+    }
+}
+
+void OpIpiNop(void* arg)
+{
+
+}
+
+void OpIpiCall(void* arg)
+{
+    IpiCall(IpiOnlineMask(), OpIpiNop, NULL);
+}
+
+void BenchShootdownMode(const char* mode)
+{
+    char name[BENCH_NAME_SIZE];
+
+    shootdown.batched = FALSE;
+    BenchRun(BenchName(name, "shootdown", mode, "single", NULL), OpShootdown, &shootdown, SHOOTDOWN_PAGES);
+
+    shootdown.batched = TRUE;
+    BenchRun(BenchName(name, "shootdown", mode, "batched", NULL), OpShootdown, &shootdown, SHOOTDOWN_PAGES);
+}
+
+void BenchShootdown(void)
+{
+    char name[BENCH_NAME_SIZE];
+    ulong_t paddr = (ulong_t)BenchScratch();
+    tlb_stats_t before, after;
+    uint32_t i;
+
+    if(paddr == 0)
+    {
+        return;
+    }
+
+    for(i = 0; i < SHOOTDOWN_PAGES; ++i)
+    {
+        pages[i].data = (ptr_t)(paddr + (i * PAGE_SIZE));
+        pages[i].size = PAGE_SIZE;
+    }
+
+    if(TlbSetBroadcast(TRUE) == E_OK)
+    {
+        BenchShootdownMode("broadcast");
+    }
+
+    TlbSetBroadcast(FALSE);
+
+    TlbStats(&before);
+    BenchShootdownMode("ipi");
+    TlbStats(&after);
+
+    // Back to what the cores support
+    TlbInit();
+
+    BenchRun("ipi.call.all", OpIpiCall, NULL, 1);
+
+    if(after.shootdowns != before.shootdowns)
+    {
+        BenchStat(BenchName(name, "shootdown", "ipi", "shootdowns", NULL), after.shootdowns - before.shootdowns);
+        BenchStat(BenchName(name, "shootdown", "ipi", "ipis", NULL), after.ipis - before.ipis);
+        BenchStat(BenchName(name, "shootdown", "ipi", "ipis_per_shootdown", NULL),
+                  (after.ipis - before.ipis) / (after.shootdowns - before.shootdowns));
+    }
+}
+
+BENCHMARK_FLAGS("shootdown", BenchShootdown, BENCH_WINDOW);
@@ -0,0 +1,94 @@
+/**
+ * @file        bench_slab.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Page and Object Allocators Benchmarks
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <page.h>
+#include <slab.h>
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private constants -------------------------------------- */
+
+#define OBJECT_SIZE     (64)
+
+// Objects allocated at once by the burst run (beyond the per-CPU caches)
+#define BURST_OBJECTS   (256)
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static void* objects[BURST_OBJECTS];
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpSlabPair(void* arg);
+
+static void OpSlabBurst(void* arg);
+
+static void OpPagePair(void* arg);
+
+
+static void BenchSlab(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpSlabPair(void* arg)
+{
+    // Served by the per-CPU cache
+    SlabFree((slab_cache_t*)arg, SlabAlloc((slab_cache_t*)arg));
+}
+
+void OpSlabBurst(void* arg)
+{
+    uint32_t i;
+
+    for(i = 0; i < BURST_OBJECTS; ++i)
+    {
+        objects[i] = SlabAlloc((slab_cache_t*)arg);
+    }
+
+    for(i = 0; i < BURST_OBJECTS; ++i)
+    {
+        SlabFree((slab_cache_t*)arg, objects[i]);
+    }
+}
+
+void OpPagePair(void* arg)
+{
+    PageFree(PageAlloc((uint32_t)arg), (uint32_t)arg);
+}
+
+void BenchSlab(void)
+{
+    slab_cache_t* cache = SlabCacheCreate("bench", OBJECT_SIZE, SLAB_ALIGN_DEFAULT, NULL);
+
+    if(cache == NULL)
+    {
+        return;
+    }
+
+    BenchRun("slab.alloc_free", OpSlabPair, cache, 1);
+    BenchRun("slab.burst", OpSlabBurst, cache, BURST_OBJECTS);
+
+    BenchRun("page.alloc_free.4k", OpPagePair, (void*)PAGE_ORDER_4K, 1);
+    BenchRun("page.alloc_free.64k", OpPagePair, (void*)PAGE_ORDER_64K, 1);
+    BenchRun("page.alloc_free.1m", OpPagePair, (void*)PAGE_ORDER_1M, 1);
+
+    SlabCacheDestroy(cache);
+}
+
+BENCHMARK("slab", BenchSlab);
@@ -0,0 +1,153 @@
+/**
+ * @file        bench_syscall.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       System Call Benchmarks
+ *
+ *              Null system call round trips (SVC, table dispatch, return
+ *              with nothing pending) give the kernel entry and exit
+ *              overhead. A call number out of the table takes the same
+ *              path through SyscallInvalid. The calls are made in user
+ *              mode (bench_user.S) by a thread of its own address space:
+ *              each run is one IPC call to it, and the round trip without
+ *              system calls is reported as well. Results are cycles per
+ *              call.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <syscall.h>
+#include <space.h>
+#include <sched.h>
+#include <cpu.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    int32_t  ep;
+    space_t* space;
+}user_arg_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define SYSCALL_CALLS       (256)
+
+// Call number out of the system call table
+#define SYS_INVALID         (SYS_COUNT + 16)
+
+// User code page
+#define USER_VADDR          (0x10000000)
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+// Set in bench_user.S
+extern const uint8_t bench_syscall_user[];
+extern const uint8_t bench_syscall_user_end[];
+
+// Drops to user mode at entry with r0 = arg (kernel.S), does not return
+extern void UserEnter(ulong_t entry, ulong_t usrSp, ulong_t arg, ulong_t svcSp);
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   User thread: enters the benchmark space and drops to user mode
+ * @param   arg - User thread arguments
+ * @retval  No return
+ */
+static void UserStart(void* arg);
+
+/**
+ * @brief   Makes the user thread run system calls (IPC call)
+ * @param   ep - Endpoint of the user thread
+ *          calls - Number of system calls
+ *          nr - System call number
+ * @retval  No return
+ */
+static void UserCalls(int32_t ep, uint32_t calls, uint32_t nr);
+
+static void OpRoundTrip(void* arg);
+
+static void OpNull(void* arg);
+
+static void OpInvalid(void* arg);
+
+static void BenchSyscall(void);
+
+
+/* Private functions -------------------------------------- */
+
+void UserStart(void* arg)
+{
+    user_arg_t* user = (user_arg_t*)arg;
+
+    SpaceEnter(user->space);
+
+    // No stack is used by the user code
+    UserEnter((ulong_t)USER_VADDR, (ulong_t)USER_VADDR + PAGE_SIZE, (ulong_t)user->ep, (ulong_t)SchedCurrent() + THREAD_STACK_SIZE);
+}
+
+void UserCalls(int32_t ep, uint32_t calls, uint32_t nr)
+{
+    ipc_msg_t msg = {{calls, nr}};
+
+    IpcCall(ep, &msg);
+}
+
+void OpRoundTrip(void* arg)
+{
+    UserCalls(*(int32_t*)arg, 0, SYS_NULL);
+}
+
+void OpNull(void* arg)
+{
+    UserCalls(*(int32_t*)arg, SYSCALL_CALLS, SYS_NULL);
+}
+
+void OpInvalid(void* arg)
+{
+    UserCalls(*(int32_t*)arg, SYSCALL_CALLS, SYS_INVALID);
+}
+
+void BenchSyscall(void)
+{
+    static user_arg_t user;
+    size_t size = bench_syscall_user_end - bench_syscall_user;
+
+    if((user.space = SpaceCreate()) == NULL)
+    {
+        return;
+    }
+
+    if((SpaceReserve(user.space, (vaddr_t)USER_VADDR, PAGE_SIZE, SPACE_EXEC) != E_OK) ||
+       (SpaceCopyIn(user.space, (vaddr_t)USER_VADDR, bench_syscall_user, size) != E_OK) ||
+       ((user.ep = IpcEndpointCreate("syscall bench")) < 0))
+    {
+        SpaceDestroy(user.space);
+        return;
+    }
+
+    // Same CPU and priority: the IPC hands the CPU over directly. The user
+    // thread stays blocked on its endpoint afterwards
+    if(ThreadCreate("syscall user", UserStart, &user, SchedCurrent()->priority, CPU_Id()) == NULL)
+    {
+        IpcEndpointDestroy(user.ep);
+        SpaceDestroy(user.space);
+        return;
+    }
+
+    BenchRun("syscall.roundtrip", OpRoundTrip, &user.ep, 1);
+    BenchRun("syscall.null", OpNull, &user.ep, SYSCALL_CALLS);
+    BenchRun("syscall.invalid", OpInvalid, &user.ep, SYSCALL_CALLS);
+}
+
+BENCHMARK("syscall", BenchSyscall);
@@ -0,0 +1,262 @@
+/**
+ * @file        bench_tlb.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       TLB Reach Benchmarks
+ *
+ *              Maps the scratch memory with 4Kb, 64Kb, 1Mb and 16Mb pages
+ *              and walks a dependent pointer chain touching one cache line
+ *              per 4Kb page, in page order (strided) or in random page
+ *              order. The footprint sweep shows where each page size runs
+ *              out of TLB reach.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <bench.h>
+#include <mmu.h>
+#include <pmu.h>
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t* head;
+    uint32_t  accesses;
+}walk_arg_t;
+
+typedef struct
+{
+    uint32_t    size;
+    const char* name;
+}footprint_t;
+
+
+/* Private constants -------------------------------------- */
+
+#define TEST_VADDR          (BENCH_SCRATCH_VADDR)
+
+#define PAGE_4K             (0x1000)
+#define PAGE_64K            (0x10000)
+#define PAGE_1M             (0x100000)
+#define PAGE_16M            (0x1000000)
+
+// One L2 page table per 1Mb of the scratch memory
+#define L2_TABLES           (BENCH_SCRATCH_SIZE / PAGE_1M)
+
+// Line offset added per page so the touched lines spread over the cache sets
+#define LINE_SIZE           (64)
+
+#define ACCESSES            (4096)
+
+enum
+{
+    MAP_4K = 0,
+    MAP_64K,
+    MAP_1M,
+    MAP_16M,
+    MAP_TYPES
+};
+
+static const char* MapNames[MAP_TYPES] = {"4k", "64k", "1m", "16m"};
+
+static const footprint_t Footprints[] =
+{
+    {128 * 1024,        "128k"},
+    {512 * 1024,        "512k"},
+    {2 * 1024 * 1024,   "2m"},
+    {8 * 1024 * 1024,   "8m"},
+    {16 * 1024 * 1024,  "16m"},
+};
+
+static const uint32_t TlbEvents[] =
+{
+    PMU_EVT_L1D_TLB_REFILL,
+    PMU_EVT_L1I_TLB_REFILL,
+    PMU_EVT_L1D_REFILL,
+    PMU_EVT_L1D_ACCESS
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+
+// Address of the node placed in page n
+#define NODE(n)             ((uint32_t*)(TEST_VADDR + ((n) * PAGE_4K) + (((n) * LINE_SIZE) & (PAGE_4K - 1))))
+
+
+/* Private variables -------------------------------------- */
+
+// Page visiting order
+static uint32_t order[BENCH_SCRATCH_SIZE / PAGE_4K];
+
+static volatile uint32_t sink;
+
+static uint32_t seed;
+
+
+/* Private function prototypes ---------------------------- */
+
+static void OpWalk(void* arg);
+
+/**
+ * @brief   Maps the scratch memory in the test window using one page size
+ * @param   type - MAP_4K, MAP_64K, MAP_1M or MAP_16M
+ * @retval  TRUE on success, FALSE if the L2 page tables are not available
+ */
+static bool_t MapScratch(uint32_t type);
+
+/**
+ * @brief   Links one node per 4Kb page of the footprint
+ * @param   pages - Number of pages
+ *          random - Random page order instead of sequential
+ * @retval  Chain head
+ */
+static uint32_t* BuildWalk(uint32_t pages, bool_t random);
+
+static void BenchTlb(void);
+
+
+/* Private functions -------------------------------------- */
+
+void OpWalk(void* arg)
+{
+    walk_arg_t* walk = (walk_arg_t*)arg;
+    uint32_t* p = walk->head;
+    uint32_t i;
+
+    for(i = walk->accesses; i != 0; i -= 4)
+    {
+        p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p; p = (uint32_t*)*p;
+    }
+
+    sink = (uint32_t)p;
+}
+
+bool_t MapScratch(uint32_t type)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    ulong_t* pgt = (ulong_t*)MMU_P2L(MMU_KernelPGT());
+    ulong_t paddr = (ulong_t)BenchScratch();
+    ulong_t vaddr = TEST_VADDR;
+    uint32_t i;
+
+    switch(type)
+    {
+    case MAP_16M:
+        MMU_Map16MbPages(pgt, paddr, vaddr, BENCH_SCRATCH_SIZE / PAGE_16M, &memCfg);
+        break;
+    case MAP_1M:
+        MMU_Map1MbPages(pgt, paddr, vaddr, BENCH_SCRATCH_SIZE / PAGE_1M, &memCfg);
+        break;
+    default:
+        for(i = 0; i < L2_TABLES; ++i, paddr += PAGE_1M, vaddr += PAGE_1M)
+        {
+            // Released by MMU_UnmapPages
+            ulong_t* l2pgt = MMU_AllocL2PGT();
+
+            if(l2pgt == NULL)
+            {
+                MMU_UnmapPages((pgt_t)pgt, (vaddr_t)TEST_VADDR, vaddr - TEST_VADDR);
+                return FALSE;
+            }
+
+            if(type == MAP_64K)
+            {
+                MMU_Map64KbPages(l2pgt, paddr, vaddr, PAGE_1M / PAGE_64K, &memCfg);
+            }
+            else
+            {
+                MMU_Map4KbPages(l2pgt, paddr, vaddr, PAGE_1M / PAGE_4K, &memCfg);
+            }
+            MMU_AttachL2PGT(pgt, l2pgt, vaddr);
+        }
+        break;
+    }
+
+    asm volatile("dsb\n\tisb" ::: "memory");
+
+    // The walk must run on the scratch frames and nothing else: check the
+    // first and last page through the table walk of MMU_V2P
+    if((MMU_V2P((pgt_t)pgt, (vaddr_t)TEST_VADDR) != (paddr_t)BenchScratch()) ||
+       (MMU_V2P((pgt_t)pgt, (vaddr_t)(TEST_VADDR + BENCH_SCRATCH_SIZE - PAGE_4K)) !=
+        (paddr_t)((ulong_t)BenchScratch() + BENCH_SCRATCH_SIZE - PAGE_4K)))
+    {
+        MMU_UnmapPages((pgt_t)pgt, (vaddr_t)TEST_VADDR, BENCH_SCRATCH_SIZE);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+uint32_t* BuildWalk(uint32_t pages, bool_t random)
+{
+    uint32_t i;
+
+    for(i = 0; i < pages; ++i)
+    {
+        order[i] = i;
+    }
+
+    if(random)
+    {
+        // Fisher-Yates shuffle of the visiting order
+        seed = 0x9E3779B9;
+        for(i = pages - 1; i > 0; --i)
+        {
+            uint32_t j = BenchRandom(&seed) % (i + 1);
+            uint32_t tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+    }
+
+    for(i = 0; i < pages; ++i)
+    {
+        *NODE(order[i]) = (uint32_t)NODE(order[(i + 1) % pages]);
+    }
+
+    return NODE(order[0]);
+}
+
+void BenchTlb(void)
+{
+    char name[BENCH_NAME_SIZE];
+    walk_arg_t walk;
+    uint32_t type, f;
+
+    if(BenchScratch() == NULL)
+    {
+        return;
+    }
+
+    BenchSetEvents(TlbEvents, ARRAY_SIZE(TlbEvents));
+
+    walk.accesses = ACCESSES;
+
+    for(type = 0; type < MAP_TYPES; ++type)
+    {
+        if(!MapScratch(type))
+        {
+            continue;
+        }
+
+        for(f = 0; f < ARRAY_SIZE(Footprints); ++f)
+        {
+            uint32_t pages = Footprints[f].size / PAGE_4K;
+
+            walk.head = BuildWalk(pages, FALSE);
+            BenchRun(BenchName(name, "tlb", MapNames[type], Footprints[f].name, "stride"), OpWalk, &walk, ACCESSES);
+
+            walk.head = BuildWalk(pages, TRUE);
+            BenchRun(BenchName(name, "tlb", MapNames[type], Footprints[f].name, "random"), OpWalk, &walk, ACCESSES);
+        }
+
+        MMU_UnmapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)TEST_VADDR, BENCH_SCRATCH_SIZE);
+    }
+}
+
+BENCHMARK_FLAGS("tlb", BenchTlb, BENCH_WINDOW);
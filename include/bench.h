@@ -0,0 +1,176 @@
+/**
+ * @file        bench.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       In-kernel Benchmark Framework Header File
+*/
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+// Operation measured by BenchRun
+typedef void (*bench_op_t)(void* arg);
+
+// Benchmark descriptor (placed in the .bench section by BENCHMARK)
+typedef struct
+{
+    const char* name;
+    void        (*entry)(void);
+    uint32_t    flags;                  // BENCH_* flags
+}bench_t;
+
+
+/* Exported constants ------------------------------------- */
+
+// Runs discarded before measuring
+#ifndef BENCH_WARMUP_RUNS
+    #define BENCH_WARMUP_RUNS   (4)
+#endif
+
+// Maximum (and default) number of measured runs
+#ifndef BENCH_RUNS
+    #define BENCH_RUNS          (64)
+#endif
+
+// Size of the physical memory returned by BenchScratch (one 16Mb block)
+#define BENCH_SCRATCH_SIZE      (0x01000000)
+
+// Size of the buffer used with BenchName
+#define BENCH_NAME_SIZE         (64)
+
+// Kernel virtual window where the scratch memory is mapped (reserved
+// in the virtual space manager by BenchRunAll)
+#define BENCH_SCRATCH_VADDR     (0xC0000000)
+#define BENCH_WINDOW_SIZE       (2 * BENCH_SCRATCH_SIZE)
+
+// Benchmark flags
+#define BENCH_WINDOW            (1 << 0)    // Maps its own pages in the window
+
+
+/* Exported macros ---------------------------------------- */
+
+/*
+ * Register a benchmark. The runner calls entry(), which reports its results
+ * through one or more BenchRun() calls
+ */
+#define BENCHMARK(_name, _entry)                                            \
+    BENCHMARK_FLAGS(_name, _entry, 0)
+
+/*
+ * Register a benchmark with BENCH_* flags. BENCH_WINDOW benchmarks are
+ * skipped (@stat <name>.skipped) when the window could not be reserved
+ */
+#define BENCHMARK_FLAGS(_name, _entry, _flags)                              \
+    static const bench_t __bench_##_entry                                   \
+    __attribute__((used, section(".bench"), aligned(4))) = {_name, _entry, _flags}
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Runs every benchmark registered with BENCHMARK and prints the
+ *          results over the serial port, one line per measurement:
+ *          @bench name=<name> runs=<n> units=<n> min=<c> med=<c> p99=<c> e<evt>=<c> ...
+ *
+ * @param   No parameters
+ *
+ * @retval  Number of benchmarks executed
+ */
+uint32_t BenchRunAll(void);
+
+/**
+ * @brief   Measures op(arg): BENCH_WARMUP_RUNS discarded runs followed by
+ *          the selected number of measured runs. Prints the result line
+ *
+ * @param   name - Measurement name
+ *          op - Operation to measure
+ *          arg - Argument passed to op
+ *          units - Work done by one run (bytes, accesses, ...) used to
+ *                  derive per unit costs
+ *
+ * @retval  Median cycles of one run
+ */
+uint32_t BenchRun(const char* name, bench_op_t op, void* arg, uint32_t units);
+
+/**
+ * @brief   Prints a value that is not a cycle measurement (counters kept
+ *          by the code under test):
+ *          @stat name=<name> value=<value>
+ *
+ * @param   name - Statistic name
+ *          value - Value
+ *
+ * @retval  No return
+ */
+void BenchStat(const char* name, uint32_t value);
+
+/**
+ * @brief   Selects the PMU events counted during BenchRun. The selection
+ *          is restored to the default set before each benchmark
+ *
+ * @param   events - Event numbers (PMU_EVT_*)
+ *          count - Number of events (up to PMU_EVENT_COUNTERS)
+ *
+ * @retval  No return
+ */
+void BenchSetEvents(const uint32_t* events, uint32_t count);
+
+/**
+ * @brief   Selects the number of measured runs of BenchRun, for slow
+ *          operations. Restored to BENCH_RUNS before each benchmark
+ *
+ * @param   runs - Measured runs (1 to BENCH_RUNS)
+ *
+ * @retval  No return
+ */
+void BenchSetRuns(uint32_t runs);
+
+/**
+ * @brief   Builds a measurement name joining the given parts with '.'
+ *          (NULL parts are skipped)
+ *
+ * @param   buffer - Buffer of BENCH_NAME_SIZE bytes
+ *          p0..p3 - Name parts
+ *
+ * @retval  Returns buffer
+ */
+const char* BenchName(char* buffer, const char* p0, const char* p1, const char* p2, const char* p3);
+
+/**
+ * @brief   Pseudo random number generator (xorshift32), for shuffles that
+ *          must be the same on every run
+ *
+ * @param   state - Generator state (seeded by the caller, not 0)
+ *
+ * @retval  Next random value
+ */
+uint32_t BenchRandom(uint32_t* state);
+
+/**
+ * @brief   Gets the physical memory shared by the benchmarks that build their
+ *          own mappings: BENCH_SCRATCH_SIZE bytes, 16Mb aligned. Allocated
+ *          from the page allocator on first use and never released
+ *
+ * @param   No parameters
+ *
+ * @retval  Physical address, NULL if the memory is not available
+ */
+paddr_t BenchScratch(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _BENCH_H_ */
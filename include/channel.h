@@ -0,0 +1,138 @@
+/**
+ * @file        channel.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Shared Memory Channels Header File
+ *
+ *              A channel is a single producer / single consumer byte ring
+ *              in pages mapped in both address spaces, so data streams
+ *              between two servers without entering the kernel. The head
+ *              (producer) and tail (consumer) indexes live in their own
+ *              cache lines, each next to a cached copy of the other index,
+ *              so the sides only share a line when the cached copy runs out.
+*/
+
+#ifndef _CHANNEL_H_
+#define _CHANNEL_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <cpu.h>
+#include <mmu.h>
+#include <space.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Page buffer vector entries of a channel (PageAllocVector chunks)
+#define CHANNEL_PAGES_MAX   (8)
+
+
+/* Exported types ----------------------------------------- */
+
+// First page of the channel, the data follows it
+typedef struct
+{
+    struct
+    {
+        uint32_t head;                  // Next byte written
+        uint32_t tailCache;             // Last tail seen by the producer
+    }__attribute__((aligned(CACHE_LINE_SIZE))) producer;
+
+    struct
+    {
+        uint32_t tail;                  // Next byte read
+        uint32_t headCache;             // Last head seen by the consumer
+    }__attribute__((aligned(CACHE_LINE_SIZE))) consumer;
+
+    uint32_t size;                      // Data size, for the user side only
+}channel_ring_t;
+
+// The kernel never takes a bound from the ring page, which the servers it
+// is mapped in may write: only the indexes are read from it
+typedef struct
+{
+    channel_ring_t* ring;               // Kernel mapping
+    pbv_t           pages[CHANNEL_PAGES_MAX];
+    size_t          count;
+    size_t          size;               // Mapping size (ring page included)
+    uint32_t        dataSize;           // Data size (power of two)
+    uint32_t        mask;
+}channel_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+// Data area of a ring
+#define CHANNEL_DATA(_ring)     ((uint8_t*)(_ring) + PAGE_SIZE)
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Creates a channel
+ *
+ * @param   ch - Channel descriptor
+ *          size - Data size (power of two, at least PAGE_SIZE)
+ *
+ * @retval  E_OK on success, E_INVAL if size is not valid, E_NO_MEMORY if
+ *          the pages cannot be allocated or mapped
+ */
+int32_t ChannelCreate(channel_t* ch, size_t size);
+
+/**
+ * @brief   Destroys a channel. It must be unmapped from every address
+ *          space (IpcRevoke) before
+ *
+ * @param   ch - Channel
+ *
+ * @retval  No return
+ */
+void ChannelDestroy(channel_t* ch);
+
+/**
+ * @brief   Maps a channel in an address space (read/write)
+ *
+ * @param   ch - Channel
+ *          space - Address space
+ *          vaddr - Address (page aligned, ch->size bytes not mapped)
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not valid
+ */
+int32_t ChannelMap(channel_t* ch, space_t* space, vaddr_t vaddr);
+
+/**
+ * @brief   Writes to a channel (producer side). Does not wait
+ *
+ * @param   ch - Channel
+ *          data - Data
+ *          size - Bytes to write
+ *
+ * @retval  Bytes written, 0 if the ring is full or its indexes are not
+ *          consistent
+ */
+size_t ChannelWrite(channel_t* ch, const void* data, size_t size);
+
+/**
+ * @brief   Reads from a channel (consumer side). Does not wait
+ *
+ * @param   ch - Channel
+ *          data - Buffer
+ *          size - Buffer size
+ *
+ * @retval  Bytes read, 0 if the ring is empty or its indexes are not
+ *          consistent
+ */
+size_t ChannelRead(channel_t* ch, void* data, size_t size);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _CHANNEL_H_ */
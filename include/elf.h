@@ -0,0 +1,94 @@
+/**
+ * @file        elf.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       ELF32 File Format Header File
+ *
+ *              Only what the loader needs: the file header and the program
+ *              headers of little endian ARM executables.
+*/
+
+#ifndef _ELF_H_
+#define _ELF_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// e_ident
+#define EI_NIDENT           (16)
+#define EI_CLASS            (4)
+#define EI_DATA             (5)
+
+#define ELFMAG0             (0x7F)
+#define ELFMAG1             ('E')
+#define ELFMAG2             ('L')
+#define ELFMAG3             ('F')
+
+#define ELFCLASS32          (1)
+#define ELFDATA2LSB         (1)
+
+// e_type, e_machine
+#define ET_EXEC             (2)
+#define EM_ARM              (40)
+
+// p_type
+#define PT_LOAD             (1)
+
+// p_flags
+#define PF_X                (1 << 0)
+#define PF_W                (1 << 1)
+#define PF_R                (1 << 2)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint8_t  e_ident[EI_NIDENT];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint32_t e_entry;
+    uint32_t e_phoff;
+    uint32_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+    uint16_t e_shentsize;
+    uint16_t e_shnum;
+    uint16_t e_shstrndx;
+}elf32_ehdr_t;
+
+typedef struct
+{
+    uint32_t p_type;
+    uint32_t p_offset;
+    uint32_t p_vaddr;
+    uint32_t p_paddr;
+    uint32_t p_filesz;
+    uint32_t p_memsz;
+    uint32_t p_flags;
+    uint32_t p_align;
+}elf32_phdr_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _ELF_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file        fault.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Abort Handling Header File
+ *
+ *              Data and prefetch aborts are decoded from DFSR/IFSR. Page
+ *              translation and permission faults on user addresses of a
+ *              thread running in an address space are passed to SpaceFault
+ *              (zero fill on demand and copy-on-write), every other abort
+ *              is fatal.
+*/
+
+#ifndef _FAULT_H_
+#define _FAULT_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Abort types (FaultAbort)
+#define FAULT_DATA          (0)
+#define FAULT_PREFETCH      (1)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t zeroFills;                 // Zeroed pages mapped
+    uint32_t copies;                    // Shared pages copied
+    uint32_t reuses;                    // Shared pages taken over
+    uint32_t spurious;                  // Already resolved by another thread
+    uint32_t fatal;                     // Aborts not resolved
+    uint64_t zeroCycles;                // Cycles in the handler per resolution
+    uint64_t copyCycles;
+    uint64_t reuseCycles;
+}fault_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Handles an abort (called by the abort vectors, IRQs enabled as
+ *          in the aborted context)
+ *
+ * @param   fsr - Fault status (DFSR or IFSR)
+ *          far - Fault address (DFAR or IFAR)
+ *          type - FAULT_DATA or FAULT_PREFETCH
+ *
+ * @retval  E_OK if resolved (the access is retried), E_FAULT otherwise
+ */
+int32_t FaultAbort(uint32_t fsr, vaddr_t far, uint32_t type);
+
+/**
+ * @brief   Reads the fault statistics (all CPUs)
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void FaultStats(fault_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _FAULT_H_ */
@@ -0,0 +1,86 @@
+/**
+ * @file        fdt.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Flattened Device Tree Header File
+ *
+ *              Read-only walker over a flattened device tree blob (DTB,
+ *              version 17). The blob is parsed in place in a single pass,
+ *              without allocations: only the platform description the
+ *              kernel needs is kept (fdt_platform_t), the blob itself is
+ *              not referenced once FdtParse returns.
+*/
+
+#ifndef _FDT_H_
+#define _FDT_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <mmu.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Header magic (big endian in the blob)
+#define FDT_MAGIC               (0xD00DFEED)
+
+// Memory banks (/memory reg entries) and reserved ranges (/memreserve/) kept
+#define FDT_MAX_BANKS           (4)
+#define FDT_MAX_RESERVED        (4)
+
+
+/* Exported types ----------------------------------------- */
+
+// Platform description, fields not found in the blob are 0
+typedef struct
+{
+    uint32_t cpus;                          // /cpus nodes with device_type "cpu"
+    uint32_t banks;
+    pbv_t    memory[FDT_MAX_BANKS];         // RAM banks, in blob order
+    uint32_t reserved;
+    pbv_t    reserve[FDT_MAX_RESERVED];     // Memory reservation block
+    paddr_t  uart;                          // First enabled PL011 / 16550 UART
+    paddr_t  gicDist;                       // GIC distributor
+    paddr_t  gicCpu;                        // GIC CPU interface
+    paddr_t  timer;                         // Cortex-A9 private timer
+    uint32_t timerFrequency;                // Generic timer clock-frequency (Hz)
+}fdt_platform_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Checks the blob header
+ *
+ * @param   blob - Device tree blob
+ *
+ * @retval  Blob size (totalsize), 0 if the header is not valid
+ */
+size_t FdtSize(const void* blob);
+
+/**
+ * @brief   Walks the structure block and fills the platform description.
+ *          Register addresses are translated to physical addresses through
+ *          the ranges of the parent buses
+ *
+ * @param   blob - Device tree blob (FdtSize bytes readable)
+ *          platform - Platform description (cleared first)
+ *
+ * @retval  E_OK on success, E_INVAL if the blob is not valid
+ */
+int32_t FdtParse(const void* blob, fdt_platform_t* platform);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _FDT_H_ */
@@ -0,0 +1,77 @@
+/**
+ * @file        ioremap.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Device Memory Mapping Header File
+*/
+
+#ifndef _IOREMAP_H_
+#define _IOREMAP_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <mmu.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Kernel virtual window used for device mappings (1Mb slots)
+#define IOREMAP_WINDOW_SIZE     (0x4000000)
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+#define ioremap(paddr, size)    IoRemap((paddr_t)(paddr), (size), CPOLICY_DEVICE_SHARED)
+#define iounmap(vaddr)          IoUnmap((void*)(vaddr))
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Allocates the device window. Must be called after VirtualInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the window cannot be allocated
+ */
+int32_t IoRemapInit(void);
+
+/**
+ * @brief   Maps a device region (kernel read/write, not executable).
+ *          Devices are mapped with whole 1Mb sections and requests in the
+ *          same 1Mb block with the same policy share the mapping, so many
+ *          small devices cost a few L1 entries and no L2 page tables
+ *
+ * @param   paddr - Device physical address
+ *          size - Region size
+ *          cpolicy - CPOLICY_DEVICE_SHARED, CPOLICY_DEVICE_PRIVATE or
+ *                    CPOLICY_STRONGLY_ORDERED
+ *
+ * @retval  Virtual address of paddr, NULL on failure
+ */
+void* IoRemap(paddr_t paddr, size_t size, uint8_t cpolicy);
+
+/**
+ * @brief   Releases a mapping returned by IoRemap. The sections are
+ *          unmapped when their last user releases them
+ *
+ * @param   vaddr - Address returned by IoRemap
+ *
+ * @retval  No return
+ */
+void IoUnmap(void* vaddr);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _IOREMAP_H_ */
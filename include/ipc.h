@@ -0,0 +1,196 @@
+/**
+ * @file        ipc.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Synchronous IPC Header File
+ *
+ *              Threads exchange short messages (IPC_MSG_WORDS registers)
+ *              through endpoints. Send and receive block until the other
+ *              side arrives; a call also waits for the reply. When the
+ *              other side is already waiting the message is copied between
+ *              the two threads and the CPU is handed over directly
+ *              (SchedHandoff), without going through the run queues.
+ *
+ *              Larger payloads are not copied: the pages are mapped in the
+ *              receiver address space (IpcShare, IpcGrant) and only their
+ *              address travels in the message.
+*/
+
+#ifndef _IPC_H_
+#define _IPC_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <sched.h>
+#include <space.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Message words, passed in r1-r4 by the system calls
+#define IPC_MSG_WORDS       (THREAD_MSG_WORDS)
+
+// Endpoints available
+#define IPC_ENDPOINTS       (64)
+
+// IpcShare / IpcGrant flags
+#define IPC_MAP_WRITE       (1 << 0)    // Receiver may write the pages
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t w[IPC_MSG_WORDS];
+}ipc_msg_t;
+
+typedef struct
+{
+    uint32_t calls;
+    uint32_t sends;
+    uint32_t handoffs;                  // Transfers that switched directly
+    uint32_t queued;                    // Transfers where one side had to wait
+}ipc_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Creates an endpoint
+ *
+ * @param   name - Endpoint name
+ *
+ * @retval  Endpoint identifier (0 or higher), E_NO_RES if none is free
+ */
+int32_t IpcEndpointCreate(const char* name);
+
+/**
+ * @brief   Destroys an endpoint
+ *
+ * @param   ep - Endpoint
+ *
+ * @retval  E_OK on success, E_INVAL if ep is not valid, E_BUSY if threads
+ *          are waiting on it
+ */
+int32_t IpcEndpointDestroy(uint32_t ep);
+
+/**
+ * @brief   Sends a message. Waits until a thread receives it, the sender
+ *          does not wait for a reply
+ *
+ * @param   ep - Endpoint
+ *          msg - Message
+ *
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+int32_t IpcSend(uint32_t ep, ipc_msg_t* msg);
+
+/**
+ * @brief   Waits for a message. If it was sent with IpcCall the sender
+ *          waits for the reply (IpcReplyWait)
+ *
+ * @param   ep - Endpoint
+ *          msg - Message received
+ *
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+int32_t IpcReceive(uint32_t ep, ipc_msg_t* msg);
+
+/**
+ * @brief   Sends a message and waits for the reply
+ *
+ * @param   ep - Endpoint
+ *          msg - Message sent, replaced by the reply
+ *
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+int32_t IpcCall(uint32_t ep, ipc_msg_t* msg);
+
+/**
+ * @brief   Replies to the last call received by the running thread (if
+ *          any) and waits for the next message. The server side of
+ *          IpcCall: one kernel entry per request
+ *
+ * @param   ep - Endpoint
+ *          msg - Reply, replaced by the message received
+ *
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+int32_t IpcReplyWait(uint32_t ep, ipc_msg_t* msg);
+
+/**
+ * @brief   Maps pages in an address space, shared with their current users.
+ *          Mappings use the largest granule the alignment allows (64Kb,
+ *          1Mb, 16Mb), so large buffers take a few table entries. The
+ *          mapping holds a reference on each page (PageGet), dropped by
+ *          IpcRevoke
+ *
+ * @param   to - Receiver address space
+ *          vaddr - Receiver address (page aligned, range not mapped and
+ *                  outside the regions of the space)
+ *          pages - Page buffer vector (page aligned chunks)
+ *          count - Number of entries
+ *          flags - IPC_MAP_* flags
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not valid or overlaps
+ *          a region
+ */
+int32_t IpcShare(space_t* to, vaddr_t vaddr, pbv_t* pages, size_t count, uint32_t flags);
+
+/**
+ * @brief   Moves pages from one address space to another: unmapped from
+ *          the sender before they are mapped in the receiver, with both
+ *          spaces locked. The page references move with the mapping
+ *
+ * @param   from - Sender address space
+ *          fromVaddr - Sender address where pages are mapped (by IpcShare
+ *                      or IpcGrant, outside the regions of the space)
+ *          to - Receiver address space
+ *          toVaddr - Receiver address (page aligned, range not mapped and
+ *                    outside the regions of the space)
+ *          pages - Page buffer vector (the pages mapped at fromVaddr)
+ *          count - Number of entries
+ *          flags - IPC_MAP_* flags
+ *
+ * @retval  E_OK on success, E_INVAL if a range is not valid or overlaps
+ *          a region (the sender keeps the pages)
+ */
+int32_t IpcGrant(space_t* from, vaddr_t fromVaddr, space_t* to, vaddr_t toVaddr, pbv_t* pages, size_t count, uint32_t flags);
+
+/**
+ * @brief   Unmaps pages shared or granted to an address space and drops
+ *          the references of the mappings (a page is released only if
+ *          its owner already dropped its own)
+ *
+ * @param   space - Address space
+ *          vaddr - Start address
+ *          size - Size of the range
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not valid or overlaps
+ *          a region
+ */
+int32_t IpcRevoke(space_t* space, vaddr_t vaddr, size_t size);
+
+/**
+ * @brief   Reads the IPC statistics (all endpoints)
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void IpcStats(ipc_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _IPC_H_ */
@@ -0,0 +1,121 @@
+/**
+ * @file        ipi.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Inter-Processor Interrupts Header File
+ *
+ *              IPIs are GIC software generated interrupts. A reschedule IPI
+ *              makes the target CPU check its run queue on interrupt exit.
+ *              A call IPI runs a function on the target CPUs: requests are
+ *              queued per CPU, so one SGI serves every request queued
+ *              before the target takes it.
+*/
+
+#ifndef _IPI_H_
+#define _IPI_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <irq.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// SGIs used by the kernel
+#define IPI_RESCHED         (IRQ_SGI_BASE + 0)
+#define IPI_CALL            (IRQ_SGI_BASE + 1)
+
+
+/* Exported types ----------------------------------------- */
+
+// Function run by IpiCall on the target CPUs (with IRQs masked)
+typedef void (*ipi_func_t)(void* arg);
+
+typedef struct
+{
+    uint32_t sent;                      // SGIs sent
+    uint32_t received;                  // SGIs taken
+    uint32_t calls;                     // Functions run for other CPUs
+    uint32_t resched;                   // Reschedule requests sent
+}ipi_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Registers the IPI handlers and marks the boot CPU online. Must
+ *          be called after IrqInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success
+ */
+int32_t IpiInit(void);
+
+/**
+ * @brief   Marks the running CPU as an IPI target. Called by each
+ *          secondary CPU after IrqCpuInit
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void IpiCpuInit(void);
+
+/**
+ * @brief   Gets the CPUs that take IPIs
+ *
+ * @param   None
+ *
+ * @retval  CPU mask (bit n set: CPU n)
+ */
+uint32_t IpiOnlineMask(void);
+
+/**
+ * @brief   Asks a CPU to reschedule (a higher priority thread was placed
+ *          in its run queue)
+ *
+ * @param   cpu - Target CPU
+ *
+ * @retval  No return
+ */
+void IpiResched(uint32_t cpu);
+
+/**
+ * @brief   Runs a function on a set of CPUs and waits until every one has
+ *          run it. The running CPU, if in the mask, runs it directly.
+ *          Requests sent to the running CPU meanwhile are served while
+ *          waiting, so two CPUs calling each other do not deadlock
+ *
+ * @param   cpuMask - Target CPUs (offline CPUs are skipped)
+ *          func - Function
+ *          arg - Function argument
+ *
+ * @retval  Number of IPIs sent
+ */
+uint32_t IpiCall(uint32_t cpuMask, ipi_func_t func, void* arg);
+
+/**
+ * @brief   Reads the IPI statistics of a CPU
+ *
+ * @param   cpu - CPU number
+ *          stats - Statistics output
+ *
+ * @retval  E_OK on success, E_INVAL if cpu is out of range
+ */
+int32_t IpiStats(uint32_t cpu, ipi_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _IPI_H_ */
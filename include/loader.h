@@ -0,0 +1,134 @@
+/**
+ * @file        loader.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       User Server Loader Header File
+ *
+ *              User servers are ELF32 executables bundled in the boot image
+ *              (loader/servers.S, SERVERS in the board configuration). The
+ *              image pages are mapped in the server space instead of being
+ *              copied:
+ *               - Read-only segments map the image pages directly, so every
+ *                 instance of a server shares the same text. MMU_MapPages
+ *                 uses 64Kb and 1Mb entries when the alignment allows
+ *                 (servers linked with -z max-page-size=0x10000)
+ *               - Writable segments map the image pages copy-on-write:
+ *                 only pages actually written are copied
+ *               - bss is zero filled on demand, only the page shared with
+ *                 the end of the file data is copied at load time
+ *              Segments whose file offset and address disagree modulo
+ *              PAGE_SIZE are copied.
+*/
+
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <space.h>
+#include <sched.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// LoaderLoad flags
+#define LOADER_COPY         (1 << 0)    // Copy every segment (no mapping in place)
+
+// Server stack: reserved below the top of the user space, populated on demand
+#define LOADER_STACK_TOP    (USER_SPACE_END - 0x100000)
+#define LOADER_STACK_SIZE   (0x100000)
+
+// Servers running at once (LoaderSpawn)
+#define LOADER_PROCS        (16)
+
+
+/* Exported types ----------------------------------------- */
+
+// Server image bundled in the boot image (.servers.table)
+typedef struct
+{
+    const char*    name;
+    const uint8_t* data;                // ELF file (64Kb aligned)
+    size_t         size;
+}loader_image_t;
+
+typedef struct
+{
+    uint32_t loads;
+    size_t   mapped;                    // Bytes mapped in place (read-only)
+    size_t   shared;                    // Bytes mapped copy-on-write
+    size_t   copied;                    // Bytes copied at load time
+    size_t   zeroed;                    // Bytes left to zero fill on demand
+}loader_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Finds a bundled server image
+ *
+ * @param   name - Server name (ELF file name without the extension)
+ *
+ * @retval  Image, NULL if there is none with that name
+ */
+const loader_image_t* LoaderFind(const char* name);
+
+/**
+ * @brief   Get a bundled server image by index
+ *
+ * @param   index - Image index
+ *
+ * @retval  Image, NULL if index is out of range
+ */
+const loader_image_t* LoaderImage(uint32_t index);
+
+/**
+ * @brief   Loads a server image in an empty address space
+ *
+ * @param   image - Server image
+ *          space - Address space
+ *          flags - LOADER_* flags
+ *          entry - Entry point output
+ *
+ * @retval  E_OK on success, E_INVAL if the image is not a valid ARM
+ *          executable or a segment does not fit the user space,
+ *          E_NO_MEMORY or E_NO_RES if the space cannot hold it
+ */
+int32_t LoaderLoad(const loader_image_t* image, space_t* space, uint32_t flags, vaddr_t* entry);
+
+/**
+ * @brief   Starts a server: creates its address space, loads it and runs
+ *          a thread at its entry point in user mode (r0 = 0, sp at
+ *          LOADER_STACK_TOP)
+ *
+ * @param   name - Server name
+ *          priority - Thread priority
+ *          affinity - THREAD_CPU_ANY or CPU number
+ *
+ * @retval  Server thread, NULL on failure
+ */
+thread_t* LoaderSpawn(const char* name, uint32_t priority, uint32_t affinity);
+
+/**
+ * @brief   Reads the loader statistics
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void LoaderStats(loader_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _LOADER_H_ */
@@ -0,0 +1,276 @@
+/**
+ * @file        page.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Physical Page Frame Allocator Header File
+*/
+
+#ifndef _PAGE_H_
+#define _PAGE_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <mmu.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Block orders (block size = PAGE_SIZE << order)
+#define PAGE_ORDER_4K       (0)
+#define PAGE_ORDER_64K      (4)
+#define PAGE_ORDER_1M       (8)
+#define PAGE_ORDER_16M      (12)
+#define PAGE_MAX_ORDER      (PAGE_ORDER_16M)
+
+// Page colours: L2 way size / PAGE_SIZE (512Kb 8-way L2 on both boards).
+// Blocks of PAGE_COLOUR_ORDER or larger hold every colour once
+#ifndef PAGE_COLOURS
+    #define PAGE_COLOURS        (16)
+#endif
+#define PAGE_COLOUR_ORDER   (4)
+#define PAGE_COLOURS_ALL    ((1 << PAGE_COLOURS) - 1)
+
+// Largest RAM mapped in the kernel logical space (from KernelVirtualBase),
+// the virtual allocator and the device window use the rest up to VIRTUAL_END
+#define PAGE_LOGICAL_MAX    (0x60000000)
+
+// Pre-zeroed 4Kb pages the idle CPUs keep ready for PageAllocZeroed
+#define PAGE_ZERO_HIGH      (256)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    size_t totalPages;                  // Pages managed by the allocator
+    size_t freePages;                   // Pages free in the buddy lists
+    size_t cachedPages;                 // Pages held by the per-CPU caches
+    size_t colouredPages;               // Pages free in the colour lists
+    size_t freeBlocks[PAGE_MAX_ORDER + 1];  // Free blocks per order
+    size_t zeroedPages;                 // Pages in the pre-zeroed list
+    uint32_t zeroHits;                  // PageAllocZeroed served pre-zeroed
+    uint32_t zeroMisses;                // PageAllocZeroed cleared on the spot
+    uint32_t zeroAborts;                // Idle clears interrupted by work
+}page_stats_t;
+
+// Colour budget of a process: colours it may use and pages it may hold
+typedef struct
+{
+    uint32_t mask;                      // Allowed colours (bit n = colour n)
+    size_t   budget;                    // Maximum pages, 0 for no limit
+    size_t   used;                      // Pages allocated
+    uint8_t  map[PAGE_COLOURS];         // Virtual colour to allowed colour
+}page_colours_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+// Colour of a physical (cache index) or virtual (hint) address
+#define PAGE_COLOUR(addr)   (((ulong_t)(addr) >> 12) & (PAGE_COLOURS - 1))
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Initializes the allocator with the RAM bank holding the kernel
+ *          (device tree, see PlatformInit) or the RAM described in the
+ *          linker script, up to PAGE_LOGICAL_MAX. The boot page table, the
+ *          kernel image and the reserved ranges of the device tree are
+ *          excluded. The whole RAM is mapped in the kernel logical space
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if there is no RAM left to manage
+ */
+int32_t PageInit(void);
+
+/**
+ * @brief   Gets the end of the RAM mapped in the kernel logical space
+ *
+ * @param   None
+ *
+ * @retval  Logical address after the last RAM section (PageInit)
+ */
+vaddr_t PageLogicalEnd(void);
+
+/**
+ * @brief   Allocates a physically contiguous block of PAGE_SIZE << order
+ *          bytes, aligned to its size. Order 0 requests are served from the
+ *          running CPU page cache
+ *
+ * @param   order - Block order (0 to PAGE_MAX_ORDER)
+ *
+ * @retval  Physical address of the block, NULL if out of memory
+ */
+paddr_t PageAlloc(uint32_t order);
+
+/**
+ * @brief   Releases a block allocated with PageAlloc
+ *
+ * @param   paddr - Physical address of the block
+ *          order - Order used to allocate it
+ *
+ * @retval  No return
+ */
+void PageFree(paddr_t paddr, uint32_t order);
+
+/**
+ * @brief   Adds a mapping to an allocated 4Kb page, shared between address
+ *          spaces (copy-on-write). The page is released by the last PagePut
+ *
+ * @param   paddr - Physical address of the page (from PageAlloc(0), or
+ *                  a 4Kb frame of a vector mapped by IpcShare)
+ *
+ * @retval  No return
+ */
+void PageGet(paddr_t paddr);
+
+/**
+ * @brief   Drops a mapping of a 4Kb page, releasing it if it was the last
+ *
+ * @param   paddr - Physical address of the page
+ *
+ * @retval  TRUE if the page was released
+ */
+bool_t PagePut(paddr_t paddr);
+
+/**
+ * @brief   Get the number of extra mappings of a 4Kb page
+ *
+ * @param   paddr - Physical address of the page
+ *
+ * @retval  0 if the page has a single user, mappings added by PageGet
+ *          otherwise
+ */
+uint32_t PageShares(paddr_t paddr);
+
+/**
+ * @brief   Allocates size bytes as a vector of physically contiguous
+ *          chunks, using 16Mb, 1Mb and 64Kb blocks whenever possible so the
+ *          result maps with large granules. The vector is ordered from the
+ *          largest chunk to the smallest, so mapping it with MMU_MapPages at
+ *          a 16Mb aligned virtual address keeps every chunk aligned
+ *
+ * @param   size - Bytes to allocate (rounded up to PAGE_SIZE)
+ *          pages - Page buffer vector to fill
+ *          max - Entries available in pages
+ *
+ * @retval  Number of entries used, 0 on failure (nothing is allocated)
+ */
+size_t PageAllocVector(size_t size, pbv_t* pages, size_t max);
+
+/**
+ * @brief   Releases a page buffer vector filled by PageAllocVector
+ *
+ * @param   pages - Page buffer vector
+ *          count - Number of entries
+ *
+ * @retval  No return
+ */
+void PageFreeVector(pbv_t* pages, size_t count);
+
+/**
+ * @brief   Sets up a colour budget
+ *
+ * @param   colours - Colour budget
+ *          mask - Allowed colours (PAGE_COLOURS_ALL for every colour)
+ *          budget - Maximum pages, 0 for no limit
+ *
+ * @retval  E_OK on success, E_INVAL if the mask has no valid colour
+ */
+int32_t PageColoursInit(page_colours_t* colours, uint32_t mask, size_t budget);
+
+/**
+ * @brief   Allocates a 4Kb page of one of the allowed colours. The colour
+ *          is derived from the virtual address the page will be mapped at,
+ *          so consecutive virtual pages spread over the allowed colours and
+ *          processes with disjoint masks never share L2 cache sets
+ *
+ * @param   colours - Colour budget
+ *          vaddr - Virtual address the page is mapped at (colour hint)
+ *
+ * @retval  Physical address, NULL if out of memory or over budget
+ */
+paddr_t PageAllocColoured(page_colours_t* colours, vaddr_t vaddr);
+
+/**
+ * @brief   Releases a page allocated with PageAllocColoured
+ *
+ * @param   colours - Colour budget
+ *          paddr - Physical address of the page
+ *
+ * @retval  No return
+ */
+void PageFreeColoured(page_colours_t* colours, paddr_t paddr);
+
+/**
+ * @brief   Allocates size bytes of coloured pages for the virtual range
+ *          starting at vaddr, as a vector ready for MMU_MapPages(vaddr).
+ *          Physically contiguous pages are merged in one entry, up to a
+ *          64Kb block
+ *
+ * @param   colours - Colour budget
+ *          vaddr - Virtual address where the vector is mapped
+ *          size - Bytes to allocate (rounded up to PAGE_SIZE)
+ *          pages - Page buffer vector to fill
+ *          max - Entries available in pages
+ *
+ * @retval  Number of entries used, 0 on failure (nothing is allocated)
+ */
+size_t PageAllocVectorColoured(page_colours_t* colours, vaddr_t vaddr, size_t size, pbv_t* pages, size_t max);
+
+/**
+ * @brief   Releases a page buffer vector filled by PageAllocVectorColoured
+ *
+ * @param   colours - Colour budget
+ *          pages - Page buffer vector
+ *          count - Number of entries
+ *
+ * @retval  No return
+ */
+void PageFreeVectorColoured(page_colours_t* colours, pbv_t* pages, size_t count);
+
+/**
+ * @brief   Allocates a zero-filled 4Kb page. Pages cleared by the idle CPUs
+ *          (PageZeroIdle) are used first, the page is cleared on the
+ *          allocation path only when none is left
+ *
+ * @param   None
+ *
+ * @retval  Physical address, NULL if out of memory
+ */
+paddr_t PageAllocZeroed(void);
+
+/**
+ * @brief   Clears one free page into the pre-zeroed list, up to
+ *          PAGE_ZERO_HIGH pages. Called from the idle loop; the page is
+ *          cleared a few cache lines at a time and the clear is abandoned
+ *          (the page goes back to the free lists) as soon as *work is not 0
+ *
+ * @param   work - Checked between chunks, non zero when work arrived
+ *
+ * @retval  TRUE if a page was cleared, FALSE if there was nothing to do or
+ *          the clear was interrupted
+ */
+bool_t PageZeroIdle(volatile uint32_t* work);
+
+/**
+ * @brief   Gets the allocator statistics
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void PageStats(page_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _PAGE_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file        percpu.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Per-CPU Variables Header File
+ *
+ *              Per-CPU variables are placed in the .data.percpu section.
+ *              CPU 0 uses the section in place and every other CPU gets a
+ *              copy of it. Areas are cache line aligned, so variables of
+ *              different CPUs never share a line. The running CPU finds its
+ *              copy by adding the offset kept in TPIDRPRW to the variable
+ *              address.
+*/
+
+#ifndef _PERCPU_H_
+#define _PERCPU_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <cpu.h>
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+#define DEFINE_PERCPU(type, name)   \
+    __attribute__((section(".data.percpu"))) type name
+
+#define DECLARE_PERCPU(type, name)  \
+    extern __attribute__((section(".data.percpu"))) type name
+
+// Copy of a per-CPU variable of the running CPU
+#define THIS_CPU_PTR(var)           ((typeof(&(var)))((ulong_t)&(var) + CPU_PercpuOffset()))
+#define THIS_CPU(var)               (*THIS_CPU_PTR(var))
+
+// Copy of a per-CPU variable of any CPU
+#define PERCPU_PTR(var, cpu)        ((typeof(&(var)))((ulong_t)&(var) + PercpuOffset(cpu)))
+#define PERCPU(var, cpu)            (*PERCPU_PTR(var, cpu))
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Copies the per-CPU section to the areas of the other CPUs.
+ *          Must be called before any per-CPU variable is written, as the
+ *          CPU 0 copy is the template of the others
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_RES if the image reserves fewer areas
+ *          than NR_CPUS
+ */
+int32_t PercpuInit(void);
+
+/**
+ * @brief   Loads the per-CPU offset of the running CPU in TPIDRPRW.
+ *          Called by each secondary CPU when it starts
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void PercpuCpuInit(void);
+
+/**
+ * @brief   Get the per-CPU area offset of a CPU
+ *
+ * @param   cpu - CPU number
+ *
+ * @retval  Offset from the per-CPU section
+ */
+ulong_t PercpuOffset(uint32_t cpu);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _PERCPU_H_ */
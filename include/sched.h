@@ -0,0 +1,311 @@
+/**
+ * @file        sched.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Thread Scheduler Header File
+ *
+ *              Preemptive priority scheduler with one run queue per CPU.
+ *              Each queue keeps a FIFO per priority and a bitmap of the
+ *              non-empty ones, so the next thread is found with one CLZ.
+ *              Idle CPUs steal ready threads from the other queues.
+*/
+
+#ifndef _SCHED_H_
+#define _SCHED_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <cpu.h>
+#include <fpu.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Priorities: 0 is the idle thread, higher values run first
+#define SCHED_PRIORITIES        (32)
+#define SCHED_PRIORITY_MIN      (1)
+#define SCHED_PRIORITY_DEFAULT  (16)
+#define SCHED_PRIORITY_MAX      (SCHED_PRIORITIES - 1)
+
+// Tick frequency and time slice (ticks)
+#define SCHED_TICK_HZ           (1000)
+#define SCHED_TIMESLICE         (10)
+
+// Thread kernel stack: the thread descriptor is placed at its base
+#define THREAD_STACK_SIZE       (0x2000)
+#define THREAD_STACK_ORDER      (1)
+
+// Thread affinity
+#define THREAD_CPU_ANY          (0xFF)
+
+// Message registers kept in the thread for synchronous IPC (ipc/)
+#define THREAD_MSG_WORDS        (4)
+
+// Thread states
+#define THREAD_READY            (0)
+#define THREAD_RUNNING          (1)
+#define THREAD_BLOCKED          (2)
+#define THREAD_DEAD             (3)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef void (*thread_entry_t)(void* arg);
+
+// Context saved by ContextSwitch (kernel.S): callee-saved registers only,
+// plus the banked user sp and lr (not saved on kernel entry)
+typedef struct
+{
+    uint32_t r4_r11[8];
+    uint32_t sp;
+    uint32_t lr;
+    ulong_t  ttbr0;                     // User page table (0: kernel thread, kept)
+    uint32_t asid;
+    uint32_t usrSp;
+    uint32_t usrLr;
+}thread_context_t;
+
+typedef struct thread
+{
+    thread_context_t context;           // Must be the first field (kernel.S)
+    struct thread*   next;              // Run queue links (IPC wait queue while blocked)
+    struct thread*   prev;
+    uint32_t         preemptCount;      // Preemption disabled while not 0
+    uint8_t          state;
+    uint8_t          priority;
+    uint8_t          cpu;               // CPU running it or that ran it last
+    uint8_t          affinity;          // THREAD_CPU_ANY or a CPU number
+    uint32_t         timeslice;
+    const char*      name;
+    thread_entry_t   entry;
+    void*            arg;
+    uint32_t         ipcMsg[THREAD_MSG_WORDS];
+    uint32_t         ipcFlags;
+    struct thread*   ipcCaller;         // Thread waiting for a reply from this one
+    struct space*    space;             // Address space (NULL: kernel thread)
+    fpu_state_t*     vfp;               // VFP/NEON registers, allocated on first use
+    uint8_t          vfpCpu;            // CPU holding them (see include/vfp.h)
+}thread_t;
+
+typedef struct
+{
+    uint32_t ready;                     // Threads in the run queue
+    uint32_t switches;
+    uint32_t steals;                    // Threads taken from other CPUs
+    uint32_t wakeups;
+    uint32_t remoteWakeups;             // Wakeups placed on another CPU
+    uint32_t handoffs;                  // Direct switches (SchedHandoff)
+    uint64_t scheduleCycles;            // Cycles spent in Schedule (switch included)
+}sched_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Get the running thread
+ * @param   None
+ * @retval  Thread descriptor (base of the current kernel stack)
+ */
+static inline thread_t* SchedCurrent(void)
+{
+    ulong_t sp;
+    asm volatile("mov   %[_sp], sp" : [_sp] "=r" (sp));
+    return (thread_t*)(sp & ~(THREAD_STACK_SIZE - 1));
+}
+
+/**
+ * @brief   Disables preemption of the running thread (nests). The thread
+ *          stays on the running CPU until PreemptEnable
+ * @param   None
+ * @retval  No return
+ */
+static inline void PreemptDisable(void)
+{
+    SchedCurrent()->preemptCount++;
+    asm volatile("" ::: "memory");
+}
+
+/**
+ * @brief   Enables preemption again. A pending reschedule is taken on the
+ *          next interrupt or call to Schedule
+ * @param   None
+ * @retval  No return
+ */
+static inline void PreemptEnable(void)
+{
+    asm volatile("" ::: "memory");
+    SchedCurrent()->preemptCount--;
+}
+
+/**
+ * @brief   Initializes the run queues and turns the boot code into the
+ *          idle thread of CPU 0. Must be called after PercpuInit
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void SchedInit(void);
+
+/**
+ * @brief   Starts the tick of the running CPU and makes it available to
+ *          the scheduler. Must be called after IrqInit (CPU 0) or
+ *          IrqCpuInit (secondary CPUs)
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the tick timer cannot be set up
+ */
+int32_t SchedCpuStart(void);
+
+/**
+ * @brief   Idle loop of the running CPU: runs ready threads, steals work
+ *          from busy CPUs, clears free pages (PageZeroIdle) and waits in
+ *          WFE otherwise. Never returns
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void SchedIdle(void);
+
+/**
+ * @brief   Picks the next thread of the running CPU and switches to it.
+ *          The running thread stays ready unless it blocked or exited
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void Schedule(void);
+
+/**
+ * @brief   Switches directly to a blocked thread, bypassing the run queue
+ *          selection (IPC fast path). The running thread must already be
+ *          marked blocked; if it was woken in the meantime it stays ready
+ *
+ * @param   next - Blocked thread, not running on any CPU
+ *
+ * @retval  E_OK once the running thread is switched in again, E_BUSY if
+ *          next cannot run on this CPU now (nothing is changed: the caller
+ *          uses ThreadWake and Schedule instead)
+ */
+int32_t SchedHandoff(thread_t* next);
+
+/**
+ * @brief   Tick handler: charges the time slice of the running thread
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void SchedTick(void);
+
+/**
+ * @brief   Called on the way out of an interrupt: preempts the running
+ *          thread if a reschedule is pending and preemption is enabled
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void SchedIrqExit(void);
+
+/**
+ * @brief   Reads the statistics of a CPU run queue
+ *
+ * @param   cpu - CPU number
+ *          stats - Statistics output
+ *
+ * @retval  E_OK on success, E_INVAL if cpu is not valid
+ */
+int32_t SchedStats(uint32_t cpu, sched_stats_t* stats);
+
+/**
+ * @brief   Creates a thread and makes it ready
+ *
+ * @param   name - Thread name
+ *          entry - Thread function (returning from it exits the thread)
+ *          arg - Argument passed to entry
+ *          priority - SCHED_PRIORITY_MIN to SCHED_PRIORITY_MAX
+ *          affinity - THREAD_CPU_ANY or the CPU the thread is bound to
+ *                     (online)
+ *
+ * @retval  Thread, NULL on failure or if the CPU is not online
+ */
+thread_t* ThreadCreate(const char* name, thread_entry_t entry, void* arg, uint32_t priority, uint32_t affinity);
+
+/**
+ * @brief   Terminates the running thread. Its stack is released after
+ *          the switch to the next thread
+ *
+ * @param   None
+ *
+ * @retval  Does not return
+ */
+void ThreadExit(void);
+
+/**
+ * @brief   Gives the CPU to the next ready thread of the same or higher
+ *          priority
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void ThreadYield(void);
+
+/**
+ * @brief   Blocks the running thread until ThreadWake is called on it
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void ThreadBlock(void);
+
+/**
+ * @brief   Makes a blocked thread ready. It is placed on the CPU that ran
+ *          it last (cache-warm) unless that CPU is busy with a higher
+ *          priority thread and another CPU is idle
+ *
+ * @param   thread - Thread
+ *
+ * @retval  E_OK on success, E_BUSY if the thread was not blocked
+ */
+int32_t ThreadWake(thread_t* thread);
+
+/**
+ * @brief   Starts the secondary CPUs (the cores of the device tree, up to
+ *          NR_CPUS) and waits for them to reach their idle loop. Must be
+ *          called after SchedCpuStart on CPU 0
+ *
+ * @param   None
+ *
+ * @retval  Number of CPUs online
+ */
+uint32_t SmpBoot(void);
+
+/**
+ * @brief   C entry of the secondary CPUs (from boot.S)
+ *
+ * @param   None
+ *
+ * @retval  Does not return
+ */
+void SecondaryMain(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _SCHED_H_ */
@@ -0,0 +1,123 @@
+/**
+ * @file        slab.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Fixed-size Kernel Object Allocator Header File
+*/
+
+#ifndef _SLAB_H_
+#define _SLAB_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+// Object cache (see memory/slab.c)
+typedef struct slab_cache slab_cache_t;
+
+// Object constructor, called once when the object memory is first set up
+typedef void (*slab_ctor_t)(void* object);
+
+typedef struct
+{
+    const char* name;
+    size_t      objectSize;             // Object size including the alignment padding
+    uint32_t    objectsPerSlab;
+    uint32_t    slabs;                  // Slabs allocated
+    uint32_t    objectsInUse;           // Objects held outside the slabs (per-CPU caches included)
+    uint32_t    cachedObjects;          // Objects held by the per-CPU caches
+    uint32_t    allocs;
+    uint32_t    allocHits;              // Allocations served by the per-CPU caches
+    uint32_t    frees;
+    uint32_t    freeHits;               // Releases absorbed by the per-CPU caches
+}slab_stats_t;
+
+
+/* Exported constants ------------------------------------- */
+
+// Alignment used when none is given: objects never share a cache line
+#define SLAB_ALIGN_DEFAULT      (0)
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Initializes the object allocator. Must be called after PageInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success
+ */
+int32_t SlabInit(void);
+
+/**
+ * @brief   Creates a cache of fixed-size objects. Every CPU gets its own
+ *          object cache, so allocations and releases only touch the shared
+ *          slabs when it runs empty or full.
+ *          Objects are constructed when their slab is created and must be
+ *          released in the constructed state, so ctor is not run again
+ *
+ * @param   name - Cache name (statistics)
+ *          size - Object size
+ *          align - Object alignment (power of two), SLAB_ALIGN_DEFAULT to
+ *                  align objects to the cache line size
+ *          ctor - Object constructor, NULL if none
+ *
+ * @retval  New cache, NULL on failure
+ */
+slab_cache_t* SlabCacheCreate(const char* name, size_t size, size_t align, slab_ctor_t ctor);
+
+/**
+ * @brief   Destroys a cache, returning its slabs to the page allocator
+ *
+ * @param   cache - Cache to destroy
+ *
+ * @retval  E_OK on success, E_BUSY if there are objects still allocated
+ */
+int32_t SlabCacheDestroy(slab_cache_t* cache);
+
+/**
+ * @brief   Allocates an object
+ *
+ * @param   cache - Object cache
+ *
+ * @retval  Object (logical address), NULL if out of memory
+ */
+void* SlabAlloc(slab_cache_t* cache);
+
+/**
+ * @brief   Releases an object allocated from the cache
+ *
+ * @param   cache - Object cache
+ *          object - Object to release
+ *
+ * @retval  No return
+ */
+void SlabFree(slab_cache_t* cache, void* object);
+
+/**
+ * @brief   Gets the cache statistics
+ *
+ * @param   cache - Object cache
+ *          stats - Statistics output
+ *
+ * @retval  No return
+ */
+void SlabStats(slab_cache_t* cache, slab_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _SLAB_H_ */
@@ -0,0 +1,205 @@
+/**
+ * @file        space.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Address Spaces Header File
+ *
+ *              A space is a user page table (lower 2Gb) tagged with an
+ *              ASID. Its mappings are non-global, so switching between
+ *              spaces only reloads TTBR0 and CONTEXTIDR: TLB entries of the
+ *              other spaces stay valid and no TLB flush is needed.
+ *
+ *              Reserved regions are populated on demand: the first access
+ *              to a page faults and maps a zeroed page (SpaceFault). A
+ *              cloned space shares the populated pages read-only with its
+ *              parent and a write copies the page (copy-on-write), so
+ *              creating a space costs time in proportion to the memory
+ *              touched, not reserved.
+*/
+
+#ifndef _SPACE_H_
+#define _SPACE_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <mmu.h>
+#include <spinlock.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// ASID 0 is reserved for the switch between page tables
+#define SPACE_ASIDS         (256)
+
+// Regions populated on demand per space
+#define SPACE_REGIONS       (16)
+
+// Region flags
+#define SPACE_WRITE         (1 << 0)    // User may write (copy-on-write if shared)
+#define SPACE_EXEC          (1 << 1)    // User may execute
+
+
+// SpaceFault resolutions
+#define SPACE_FAULT_NONE    (0)         // Already resolved by another thread
+#define SPACE_FAULT_ZERO    (1)         // Zeroed page mapped
+#define SPACE_FAULT_COPY    (2)         // Shared page copied
+#define SPACE_FAULT_REUSE   (3)         // Shared page taken over (last user)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    vaddr_t  start;
+    size_t   size;                      // 0: region not used
+    uint32_t flags;                     // SPACE_* flags
+}space_region_t;
+
+typedef struct space
+{
+    spinlock_t     lock;                // Page table and region updates
+    pgt_t          pgt;                 // User page table (logical address)
+    ulong_t        ttbr;                // TTBR0 value
+    uint32_t       asid;
+    space_region_t regions[SPACE_REGIONS];
+}space_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Initializes the address space allocator. Must be called after
+ *          SlabInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the descriptors cache cannot be
+ *          created
+ */
+int32_t SpaceInit(void);
+
+/**
+ * @brief   Creates an empty address space
+ *
+ * @param   None
+ *
+ * @retval  Address space, NULL if out of memory or ASIDs
+ */
+space_t* SpaceCreate(void);
+
+/**
+ * @brief   Destroys an address space: releases its regions, page tables and
+ *          ASID. Other pages mapped in it (IpcShare) are not released. No
+ *          thread may run in it
+ *
+ * @param   space - Address space
+ *
+ * @retval  No return
+ */
+void SpaceDestroy(space_t* space);
+
+/**
+ * @brief   Moves the running thread to an address space (loaded right
+ *          away and on every switch to the thread)
+ *
+ * @param   space - Address space, NULL to make it a kernel thread again
+ *                  (the kernel tables are loaded on the running CPU)
+ *
+ * @retval  No return
+ */
+void SpaceEnter(space_t* space);
+
+/**
+ * @brief   Reserves a region populated on demand with zeroed pages. Nothing
+ *          is allocated or mapped until the pages are touched
+ *
+ * @param   space - Address space
+ *          vaddr - Start address (page aligned)
+ *          size - Size (page aligned)
+ *          flags - SPACE_* flags
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not valid or overlaps
+ *          another region, E_NO_RES if the space has no region left
+ */
+int32_t SpaceReserve(space_t* space, vaddr_t vaddr, size_t size, uint32_t flags);
+
+/**
+ * @brief   Releases a region: its pages are unmapped and released (shared
+ *          pages once their last user releases them)
+ *
+ * @param   space - Address space
+ *          vaddr - Start address of the region
+ *
+ * @retval  E_OK on success, E_INVAL if there is no region at vaddr
+ */
+int32_t SpaceRelease(space_t* space, vaddr_t vaddr);
+
+/**
+ * @brief   Maps pages the caller keeps (e.g. a boot image) in a region,
+ *          read-only and copy-on-write. Every mapping takes a reference
+ *          to the page (PageGet) and the caller keeps its own, so a write
+ *          always copies the page
+ *
+ * @param   space - Address space
+ *          vaddr - Start address (page aligned, in a region, not populated)
+ *          paddr - Physical address of the first page
+ *          size - Size (page aligned)
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not in a region
+ */
+int32_t SpaceShare(space_t* space, vaddr_t vaddr, paddr_t paddr, size_t size);
+
+/**
+ * @brief   Copies data to a region, populating its pages (zeroed first when
+ *          the data does not cover them)
+ *
+ * @param   space - Address space
+ *          vaddr - Destination address (in a region)
+ *          src - Source (kernel address)
+ *          size - Bytes to copy
+ *
+ * @retval  E_OK on success, E_INVAL if the range is not in a region,
+ *          E_BUSY if a page is shared, E_NO_MEMORY if out of memory
+ */
+int32_t SpaceCopyIn(space_t* space, vaddr_t vaddr, const void* src, size_t size);
+
+/**
+ * @brief   Creates a copy of an address space: same regions, the populated
+ *          pages are shared read-only and copied on the first write. The
+ *          pages are not copied
+ *
+ * @param   space - Address space to copy
+ *
+ * @retval  New address space, NULL if out of memory or ASIDs
+ */
+space_t* SpaceClone(space_t* space);
+
+/**
+ * @brief   Resolves a fault in a region: maps a zeroed page on the first
+ *          access, copies a shared page on a write (or takes it over if it
+ *          is no longer shared). Called by the abort handler
+ *
+ * @param   space - Address space
+ *          vaddr - Faulting address
+ *          write - TRUE for a write access
+ *          resolution - SPACE_FAULT_* output (valid on success)
+ *
+ * @retval  E_OK on success, E_FAULT if the access is not allowed,
+ *          E_NO_MEMORY if no page can be allocated
+ */
+int32_t SpaceFault(space_t* space, vaddr_t vaddr, bool_t write, uint32_t* resolution);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _SPACE_H_ */
@@ -0,0 +1,198 @@
+/**
+ * @file        spinlock.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Ticket and MCS Spinlocks Header File
+ *
+ *              Ticket locks are FIFO and take a single word: use them for
+ *              short critical sections with a few contenders. MCS locks
+ *              make every waiter spin on its own node, so contention does
+ *              not bounce the lock cache line between CPUs: use them for
+ *              heavily contended locks.
+ *              Builds with LOCK_STATS (debug builds) count acquisitions,
+ *              contention, wait and hold cycles per lock.
+*/
+
+#ifndef _SPINLOCK_H_
+#define _SPINLOCK_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <cpu.h>
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t acquisitions;
+    uint32_t contended;                 // Acquisitions that had to wait
+    uint64_t waitCycles;
+    uint64_t holdCycles;
+    uint32_t maxHoldCycles;
+}lock_stats_t;
+
+typedef struct
+{
+    // Next ticket in the upper half, ticket being served in the lower half
+    volatile uint32_t tickets;
+#ifdef LOCK_STATS
+    const char*  name;
+    uint32_t     holdStart;
+    lock_stats_t stats;
+#endif
+}spinlock_t;
+
+// MCS queue node: one per waiter, usually on the waiter stack
+typedef struct mcs_node
+{
+    struct mcs_node* volatile next;
+    volatile uint32_t locked;
+}__attribute__((aligned(CACHE_LINE_SIZE))) mcs_node_t;
+
+typedef struct
+{
+    mcs_node_t* volatile tail;
+#ifdef LOCK_STATS
+    const char*  name;
+    uint32_t     holdStart;
+    lock_stats_t stats;
+#endif
+}mcs_lock_t;
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+#ifdef LOCK_STATS
+    #define SPINLOCK_INIT(lockName)     {0, (lockName), 0, {0}}
+    #define MCS_LOCK_INIT(lockName)     {NULL, (lockName), 0, {0}}
+#else
+    #define SPINLOCK_INIT(lockName)     {0}
+    #define MCS_LOCK_INIT(lockName)     {NULL}
+#endif
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Initializes a ticket lock (unlocked)
+ *
+ * @param   lock - Lock
+ *          name - Name reported with the lock statistics
+ *
+ * @retval  No return
+ */
+void SpinLockInit(spinlock_t* lock, const char* name);
+
+/**
+ * @brief   Acquires a ticket lock. Waiters sleep in WFE until the holder
+ *          releases the lock
+ *
+ * @param   lock - Lock
+ *
+ * @retval  No return
+ */
+void SpinLock(spinlock_t* lock);
+
+/**
+ * @brief   Acquires a ticket lock if it is free
+ *
+ * @param   lock - Lock
+ *
+ * @retval  TRUE if the lock was acquired
+ */
+bool_t SpinTryLock(spinlock_t* lock);
+
+/**
+ * @brief   Releases a ticket lock and wakes the waiters
+ *
+ * @param   lock - Lock
+ *
+ * @retval  No return
+ */
+void SpinUnlock(spinlock_t* lock);
+
+/**
+ * @brief   Masks interrupts on the running CPU and acquires a ticket lock
+ *
+ * @param   lock - Lock
+ *
+ * @retval  Interrupt state for SpinUnlockIrqRestore
+ */
+uint32_t SpinLockIrqSave(spinlock_t* lock);
+
+/**
+ * @brief   Releases a ticket lock and restores the interrupt state
+ *
+ * @param   lock - Lock
+ *          flags - Value returned by SpinLockIrqSave
+ *
+ * @retval  No return
+ */
+void SpinUnlockIrqRestore(spinlock_t* lock, uint32_t flags);
+
+/**
+ * @brief   Initializes an MCS lock (unlocked)
+ *
+ * @param   lock - Lock
+ *          name - Name reported with the lock statistics
+ *
+ * @retval  No return
+ */
+void McsLockInit(mcs_lock_t* lock, const char* name);
+
+/**
+ * @brief   Acquires an MCS lock. The caller queues its node and waits on
+ *          it, so each waiter only reads its own cache line
+ *
+ * @param   lock - Lock
+ *          node - Waiter node, owned by the caller until McsUnlock returns
+ *
+ * @retval  No return
+ */
+void McsLock(mcs_lock_t* lock, mcs_node_t* node);
+
+/**
+ * @brief   Releases an MCS lock, handing it to the next waiter
+ *
+ * @param   lock - Lock
+ *          node - Node passed to McsLock
+ *
+ * @retval  No return
+ */
+void McsUnlock(mcs_lock_t* lock, mcs_node_t* node);
+
+/**
+ * @brief   Reads the statistics of a ticket lock
+ *
+ * @param   lock - Lock
+ *          stats - Statistics output
+ *
+ * @retval  E_OK on success, E_NO_RES if the statistics are not built in
+ */
+int32_t SpinLockStats(spinlock_t* lock, lock_stats_t* stats);
+
+/**
+ * @brief   Reads the statistics of an MCS lock
+ *
+ * @param   lock - Lock
+ *          stats - Statistics output
+ *
+ * @retval  E_OK on success, E_NO_RES if the statistics are not built in
+ */
+int32_t McsLockStats(mcs_lock_t* lock, lock_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _SPINLOCK_H_ */
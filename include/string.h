@@ -0,0 +1,111 @@
+/**
+ * @file        string.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Memory and String Routines Header File
+*/
+
+#ifndef _STRING_H_
+#define _STRING_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported types ----------------------------------------- */
+
+
+/* Exported constants ------------------------------------- */
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Copies n bytes from src to dst. The buffers must not overlap
+ *
+ * @param   dst - Destination buffer
+ *          src - Source buffer
+ *          n - Number of bytes to copy
+ *
+ * @retval  Returns dst
+ */
+void* memcpy(void* dst, const void* src, size_t n);
+
+/**
+ * @brief   Copies n bytes from src to dst. The buffers may overlap
+ *
+ * @param   dst - Destination buffer
+ *          src - Source buffer
+ *          n - Number of bytes to copy
+ *
+ * @retval  Returns dst
+ */
+void* memmove(void* dst, const void* src, size_t n);
+
+/**
+ * @brief   Fills n bytes of dst with the byte value c
+ *
+ * @param   dst - Destination buffer
+ *          c - Fill value (only the lower 8 bits are used)
+ *          n - Number of bytes to fill
+ *
+ * @retval  Returns dst
+ */
+void* memset(void* dst, int32_t c, size_t n);
+
+/**
+ * @brief   Clears n bytes of dst with whole cache line stores that do not
+ *          allocate in the L1 (write streaming). With STRING_NEON the caller
+ *          must be inside a kernel NEON section (VfpKernelBegin)
+ *
+ * @param   dst - Destination buffer (64 bytes aligned)
+ *          n - Number of bytes to clear (multiple of 64, not 0)
+ *
+ * @retval  No return
+ */
+void memzero_stream(void* dst, size_t n);
+
+/**
+ * @brief   Compares the first n bytes of s1 and s2
+ *
+ * @param   s1 - First buffer
+ *          s2 - Second buffer
+ *          n - Number of bytes to compare
+ *
+ * @retval  Zero if equal, otherwise the difference of the first mismatching bytes
+ */
+int32_t memcmp(const void* s1, const void* s2, size_t n);
+
+/**
+ * @brief   Gets the length of a null terminated string
+ *
+ * @param   s - String
+ *
+ * @retval  Number of characters before the terminator
+ */
+size_t strlen(const char* s);
+
+/**
+ * @brief   Compares two null terminated strings
+ *
+ * @param   s1 - First string
+ *          s2 - Second string
+ *
+ * @retval  Zero if equal, otherwise the difference of the first mismatching characters
+ */
+int32_t strcmp(const char* s1, const char* s2);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _STRING_H_ */
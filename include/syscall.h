@@ -0,0 +1,160 @@
+/**
+ * @file        syscall.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       System Call Interface Header File
+ *
+ *              System calls enter through SVC with the call number in r7
+ *              and the arguments in r0-r5. r0 returns the result and the
+ *              IPC calls return the message in r1-r4. r12 (and lr in SVC
+ *              mode) is not preserved, the other registers are.
+ *
+ *              svc_entry (entry.S) saves r0-r5 and the return state only:
+ *              the handlers are AAPCS functions and preserve r4-r11
+ *              themselves. The call number indexes syscallTable directly
+ *              and the first three arguments are passed to the handler in
+ *              the registers they arrived in.
+*/
+
+#ifndef _SYSCALL_H_
+#define _SYSCALL_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <ipc.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// System call numbers (r7)
+#define SYS_IPC_SEND            (0)
+#define SYS_IPC_RECEIVE         (1)
+#define SYS_IPC_CALL            (2)
+#define SYS_IPC_REPLY_WAIT      (3)
+#define SYS_NULL                (4)
+
+// Entries of the system call table (SYSCALL_COUNT in entry.S)
+#define SYS_COUNT               (5)
+
+
+/* Exported types ----------------------------------------- */
+
+// Registers saved by svc_entry (entry.S), restored on return (r0 excepted)
+typedef struct
+{
+    uint32_t r[6];
+    uint32_t pc;
+    uint32_t cpsr;
+}syscall_frame_t;
+
+// System call handler: arguments r0-r2, the others are read from the frame
+typedef int32_t (*syscall_t)(uint32_t a0, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+
+
+/* Exported macros ---------------------------------------- */
+
+// System call with the message registers r1-r4 in and out. lr is listed
+// as clobbered for callers running in SVC mode (kernel threads)
+#define SYSCALL_IPC(_nr, _ep, _msg)                                         \
+({                                                                          \
+    register uint32_t r0 asm("r0") = (_ep);                                 \
+    register uint32_t r1 asm("r1") = (_msg)->w[0];                          \
+    register uint32_t r2 asm("r2") = (_msg)->w[1];                          \
+    register uint32_t r3 asm("r3") = (_msg)->w[2];                          \
+    register uint32_t r4 asm("r4") = (_msg)->w[3];                          \
+    register uint32_t r7 asm("r7") = (_nr);                                 \
+    asm volatile("svc   #0"                                                 \
+                 : "+r" (r0), "+r" (r1), "+r" (r2), "+r" (r3), "+r" (r4)    \
+                 : "r" (r7)                                                 \
+                 : "r12", "lr", "cc", "memory");                            \
+    (_msg)->w[0] = r1;                                                      \
+    (_msg)->w[1] = r2;                                                      \
+    (_msg)->w[2] = r3;                                                      \
+    (_msg)->w[3] = r4;                                                      \
+    (int32_t)r0;                                                            \
+})
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Sends a message, waiting for a receiver
+ * @param   ep - Endpoint
+ *          msg - Message
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+static inline int32_t SysIpcSend(uint32_t ep, ipc_msg_t* msg)
+{
+    return SYSCALL_IPC(SYS_IPC_SEND, ep, msg);
+}
+
+/**
+ * @brief   Waits for a message
+ * @param   ep - Endpoint
+ *          msg - Message received
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+static inline int32_t SysIpcReceive(uint32_t ep, ipc_msg_t* msg)
+{
+    return SYSCALL_IPC(SYS_IPC_RECEIVE, ep, msg);
+}
+
+/**
+ * @brief   Sends a message and waits for the reply
+ * @param   ep - Endpoint
+ *          msg - Message sent, replaced by the reply
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+static inline int32_t SysIpcCall(uint32_t ep, ipc_msg_t* msg)
+{
+    return SYSCALL_IPC(SYS_IPC_CALL, ep, msg);
+}
+
+/**
+ * @brief   Replies to the last call received and waits for the next message
+ * @param   ep - Endpoint
+ *          msg - Reply, replaced by the message received
+ * @retval  E_OK on success, E_INVAL if ep is not valid
+ */
+static inline int32_t SysIpcReplyWait(uint32_t ep, ipc_msg_t* msg)
+{
+    return SYSCALL_IPC(SYS_IPC_REPLY_WAIT, ep, msg);
+}
+
+/**
+ * @brief   System call without work: the cost of entering and leaving the
+ *          kernel
+ * @param   None
+ * @retval  E_OK
+ */
+static inline int32_t SysNull(void)
+{
+    register uint32_t r0 asm("r0");
+    register uint32_t r7 asm("r7") = SYS_NULL;
+    asm volatile("svc   #0"
+                 : "=r" (r0)
+                 : "r" (r7)
+                 : "r12", "lr", "cc", "memory");
+    return (int32_t)r0;
+}
+
+/**
+ * @brief   Handles a system call number out of the table (called by
+ *          svc_entry)
+ * @param   a0, a1, a2 - Not used
+ *          frame - Registers of the caller
+ * @retval  E_INVAL
+ */
+int32_t SyscallInvalid(uint32_t a0, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _SYSCALL_H_ */
@@ -0,0 +1,141 @@
+/**
+ * @file        tlb.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       TLB and Instruction Cache Shootdown Header File
+ *
+ *              Cores with the multiprocessing extensions broadcast TLB and
+ *              cache maintenance to the inner shareable domain, so no IPI
+ *              is needed. Otherwise the running CPU invalidates locally
+ *              and records the range in a per-CPU batch: when the
+ *              outermost batch ends the other CPUs get one IPI each with
+ *              the coalesced range, however many pages were invalidated.
+*/
+
+#ifndef _TLB_H_
+#define _TLB_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Coalesced ranges larger than this are flushed whole on the other CPUs
+#define TLB_FLUSH_ALL_PAGES (64)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t broadcasts;                // Inner shareable invalidations
+    uint32_t pages;                     // Pages queued for a shootdown
+    uint32_t shootdowns;                // Batches sent to the other CPUs
+    uint32_t ipis;                      // IPIs sent by the shootdowns
+}tlb_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Detects whether the cores broadcast TLB and cache maintenance
+ *          (ID_MMFR3). Until called, broadcast is assumed
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TlbInit(void);
+
+/**
+ * @brief   Starts a batch: the shootdowns are delayed until the matching
+ *          TlbBatchEnd. Batches nest. Disables preemption
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TlbBatchBegin(void);
+
+/**
+ * @brief   Ends a batch. The outermost one sends the pending shootdown
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TlbBatchEnd(void);
+
+/**
+ * @brief   Sends the pending shootdown now, inside a batch (before page
+ *          tables are released)
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TlbSync(void);
+
+/**
+ * @brief   Invalidates the entries of a page (all ASIDs) on every CPU.
+ *          Must follow the page table update
+ *
+ * @param   vaddr - Virtual address
+ *
+ * @retval  No return
+ */
+void TlbInvalidatePage(ulong_t vaddr);
+
+/**
+ * @brief   Invalidates the entries of an ASID on every CPU
+ *
+ * @param   asid - Address space identifier
+ *
+ * @retval  No return
+ */
+void TlbInvalidateASID(uint32_t asid);
+
+/**
+ * @brief   Invalidates the instruction caches and branch predictors of
+ *          every CPU (after writing code)
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TlbInvalidateICache(void);
+
+/**
+ * @brief   Selects broadcast maintenance or IPI shootdowns (to measure the
+ *          IPI path on cores that broadcast)
+ *
+ * @param   enable - TRUE to use broadcast maintenance
+ *
+ * @retval  E_OK on success, E_INVAL if the cores do not broadcast
+ */
+int32_t TlbSetBroadcast(bool_t enable);
+
+/**
+ * @brief   Reads the shootdown statistics (all CPUs)
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void TlbStats(tlb_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _TLB_H_ */
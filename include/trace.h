@@ -0,0 +1,103 @@
+/**
+ * @file        trace.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Event Tracing Header File
+ *
+ *              Tracepoints (TRACE) write a fixed size binary record in the
+ *              ring of the running CPU: cycle counter, CPU, event and two
+ *              payload words. Nothing is formatted when the event happens;
+ *              the rings keep the last TRACE_RECORDS events of each CPU and
+ *              are printed on request (TraceDump) for tools/trace.py, which
+ *              turns them into a Chrome trace / Perfetto JSON file.
+ *
+ *              Tracing is built with USE_TRACE only (TRACE=1 in make), the
+ *              tracepoints are removed otherwise.
+*/
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Records per CPU (power of 2), the oldest are overwritten
+#define TRACE_RECORDS           (1024)
+
+// Events (tools/trace.py reads the names from this file)
+#define TRACE_BOOT              (0x01)  // a: TRACE_BOOT_* phase done
+#define TRACE_IRQ_ENTRY         (0x10)  // a: IRQ number
+#define TRACE_IRQ_EXIT          (0x11)  // a: IRQ number
+#define TRACE_SCHED_SWITCH      (0x20)  // a: previous thread, b: next thread
+#define TRACE_SCHED_WAKE        (0x21)  // a: thread, b: CPU
+#define TRACE_MMU_MAP           (0x30)  // a: virtual address, b: size
+#define TRACE_MMU_UNMAP         (0x31)  // a: virtual address, b: size
+#define TRACE_FAULT             (0x40)  // a: fault address, b: fault status
+
+// TRACE_BOOT phases
+#define TRACE_BOOT_MEMORY       (0)     // Page, slab and space allocators
+#define TRACE_BOOT_CONSOLE      (1)     // Device window and serial port
+#define TRACE_BOOT_IRQ          (2)     // Interrupt controller, IPIs and tick
+#define TRACE_BOOT_SMP          (3)     // Secondary CPUs started
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t timestamp;                 // Cycle counter of the CPU
+    uint16_t event;
+    uint16_t cpu;
+    uint32_t a;
+    uint32_t b;
+}trace_record_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+#ifdef USE_TRACE
+    #define TRACE(event, a, b)      TraceEvent((event), (uint32_t)(a), (uint32_t)(b))
+#else
+    #define TRACE(event, a, b)      do { } while(0)
+#endif
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Records an event in the ring of the running CPU (use TRACE).
+ *          May be called from any context, IRQ handlers included
+ *
+ * @param   event - Event (TRACE_*)
+ *          a, b - Payload
+ *
+ * @retval  No return
+ */
+void TraceEvent(uint32_t event, uint32_t a, uint32_t b);
+
+/**
+ * @brief   Prints the rings over the serial port, oldest record first, one
+ *          line per record between "@trace-begin" and "@trace-end":
+ *          @trace <cpu> <timestamp> <event> <a> <b> (hexadecimal)
+ *          Recording is paused while the rings are printed
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void TraceDump(void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _TRACE_H_ */
@@ -0,0 +1,128 @@
+/**
+ * @file        vfp.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Lazy VFP/NEON Context Switching Header File
+ *
+ *              The FPU is left disabled on every switch. The first VFP/NEON
+ *              instruction of a thread traps (undefined instruction) and
+ *              only then is the register bank of the previous owner saved
+ *              and the thread bank loaded. Threads that never use the FPU
+ *              have no register bank and cost nothing on a switch. The
+ *              kernel uses NEON inside VfpKernelBegin / VfpKernelEnd.
+*/
+
+#ifndef _VFP_H_
+#define _VFP_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <fpu.h>
+#include <sched.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// thread_t vfpCpu value when the registers of the thread are in memory
+#define VFP_CPU_NONE        (0xFF)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    uint32_t traps;                     // Undefined instruction traps taken
+    uint32_t saves;                     // Register banks saved
+    uint32_t restores;                  // Register banks loaded
+    uint32_t migrations;                // Banks fetched from another CPU
+    uint32_t kernel;                    // Kernel NEON sections
+}vfp_stats_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Creates the register bank cache. Must be called after SlabInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the cache cannot be created
+ */
+int32_t VfpInit(void);
+
+/**
+ * @brief   Gives the FPU to the running thread (called by the undefined
+ *          instruction vector with IRQs masked)
+ *
+ * @param   None
+ *
+ * @retval  E_OK if the instruction can be executed again, E_INVAL if it
+ *          is not a VFP/NEON instruction (the FPU was already enabled),
+ *          E_NO_MEMORY if the register bank cannot be allocated
+ */
+int32_t VfpTrap(void);
+
+/**
+ * @brief   Sets FPEXC for the thread switched in: enabled only if its
+ *          registers are the ones loaded on the running CPU (Schedule,
+ *          run queue locked)
+ *
+ * @param   next - Thread switched in
+ *
+ * @retval  No return
+ */
+void VfpSwitch(thread_t* next);
+
+/**
+ * @brief   Releases the register bank of an exiting thread
+ *
+ * @param   thread - Running thread
+ *
+ * @retval  No return
+ */
+void VfpThreadExit(thread_t* thread);
+
+/**
+ * @brief   Starts a kernel NEON section: saves the registers of the owner
+ *          and enables the FPU. Disables preemption. Sections do not nest:
+ *          an interrupt handler that finds the FPU in use gets FALSE and
+ *          must use the integer path
+ *
+ * @param   None
+ *
+ * @retval  TRUE if NEON may be used until VfpKernelEnd
+ */
+bool_t VfpKernelBegin(void);
+
+/**
+ * @brief   Ends a kernel NEON section started with VfpKernelBegin
+ *
+ * @param   None
+ *
+ * @retval  No return
+ */
+void VfpKernelEnd(void);
+
+/**
+ * @brief   Reads the VFP statistics (all CPUs)
+ *
+ * @param   stats - Statistics output
+ *
+ * @retval  No return
+ */
+void VfpStats(vfp_stats_t* stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _VFP_H_ */
@@ -0,0 +1,148 @@
+/**
+ * @file        virtual.h
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Kernel Virtual Space Manager Header File
+*/
+
+#ifndef _VIRTUAL_H_
+#define _VIRTUAL_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+
+/* Includes ----------------------------------------------- */
+#include <types.h>
+#include <mmu.h>
+
+
+/* Exported constants ------------------------------------- */
+
+// Allocation flags
+#define VIRTUAL_GUARD           (1 << 0)    // Leave an unmapped page after the region
+
+// End of the managed space (the last 1Mb is left for fixed mappings)
+#define VIRTUAL_END             (0xFFF00000)
+
+// Chunks a VMalloc region may be built from
+#define VIRTUAL_VMALLOC_CHUNKS  (8)
+
+
+/* Exported types ----------------------------------------- */
+
+typedef struct
+{
+    vaddr_t  start;
+    size_t   size;                      // Usable size (guard page excluded)
+    uint32_t flags;
+}vregion_info_t;
+
+
+/* Exported macros ---------------------------------------- */
+
+
+/* Exported functions ------------------------------------- */
+
+/**
+ * @brief   Initializes the virtual space manager with the kernel space
+ *          above the logical RAM mapping. Must be called after SlabInit
+ *
+ * @param   None
+ *
+ * @retval  E_OK on success, E_NO_MEMORY if the descriptors cannot be allocated
+ */
+int32_t VirtualInit(void);
+
+/**
+ * @brief   Allocates a kernel virtual region. Regions are aligned to 16Mb,
+ *          1Mb or 64Kb when their size allows it, so they can be mapped
+ *          with large granules
+ *
+ * @param   size - Region size (rounded up to PAGE_SIZE)
+ *          flags - VIRTUAL_GUARD to leave an unmapped page after the region
+ *
+ * @retval  Region start, NULL if there is no space left
+ */
+vaddr_t VirtualAlloc(size_t size, uint32_t flags);
+
+/**
+ * @brief   Claims a fixed kernel virtual range
+ *
+ * @param   vaddr - Range start (page aligned)
+ *          size - Range size
+ *
+ * @retval  vaddr on success, NULL if the range is outside the managed
+ *          space or already in use
+ */
+vaddr_t VirtualReserve(vaddr_t vaddr, size_t size);
+
+/**
+ * @brief   Releases a region. Its mappings must have been removed
+ *
+ * @param   vaddr - Region start
+ *
+ * @retval  E_OK on success, E_SRCH if there is no region at vaddr
+ */
+int32_t VirtualFree(vaddr_t vaddr);
+
+/**
+ * @brief   Finds the region containing an address
+ *
+ * @param   vaddr - Address
+ *          info - Region information output
+ *
+ * @retval  E_OK on success, E_SRCH if vaddr is not in a region
+ */
+int32_t VirtualLookup(vaddr_t vaddr, vregion_info_t* info);
+
+/**
+ * @brief   Allocates a region for the pages and maps them with MMU_MapPages.
+ *          The region alignment also takes the alignment of the first
+ *          (largest) chunk into account
+ *
+ * @param   pages - Page buffer vector
+ *          count - Number of entries
+ *          memCfg - Memory configuration
+ *          flags - Allocation flags (VIRTUAL_*)
+ *
+ * @retval  Region start, NULL on failure
+ */
+vaddr_t VirtualMap(pbv_t* pages, size_t count, memCfg_t* memCfg, uint32_t flags);
+
+/**
+ * @brief   Unmaps and releases a region (the pages are not released)
+ *
+ * @param   vaddr - Region start
+ *
+ * @retval  E_OK on success, E_SRCH if there is no region at vaddr
+ */
+int32_t VirtualUnmap(vaddr_t vaddr);
+
+/**
+ * @brief   Allocates virtually contiguous kernel memory (read/write,
+ *          write-allocate, not executable) backed by the page allocator.
+ *          A guard page follows the region
+ *
+ * @param   size - Bytes to allocate
+ *
+ * @retval  Memory start, NULL on failure
+ */
+void* VMalloc(size_t size);
+
+/**
+ * @brief   Releases memory allocated with VMalloc
+ *
+ * @param   ptr - Memory start
+ *
+ * @retval  No return
+ */
+void VFree(void* ptr);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* _VIRTUAL_H_ */
@@ -1,67 +1,108 @@
 #include <types.h>
+#include <atomic.h>
 #include <serial.h>
 #include <mmu.h>
 #include <pmu.h>
-
-#ifdef SUNXI_H3
-    const static pbv_t pages[4] = {{(ptr_t)0x50000000, 0x2000000}, {(ptr_t)0x60000000, 0x4000000}, {(ptr_t)0x68000000, 0xA00000}, {(ptr_t)0x70000000, 0xF00000}};
-#else
-    const static pbv_t pages[4] = {{(ptr_t)0x90000000, 0x2000000}, {(ptr_t)0xA0000000, 0x4000000}, {(ptr_t)0xA8000000, 0xA00000}, {(ptr_t)0xB0000000, 0xF00000}};
+#include <boottime.h>
+#include <platform.h>
+#include <percpu.h>
+#include <page.h>
+#include <slab.h>
+#include <virtual.h>
+#include <ioremap.h>
+#include <irq.h>
+#include <ipi.h>
+#include <tlb.h>
+#include <vfp.h>
+#include <sched.h>
+#include <space.h>
+#include <bench.h>
+#include <trace.h>
+
+#ifdef USE_BENCHMARKS
+static void BenchThread(void* arg)
+{
+    (void)arg;
+    BenchRunAll();
+#ifdef USE_TRACE
+    TraceDump();
+#endif
+}
 #endif
 
-extern char *itoa(int32_t num, char *str, int32_t base);
-
-const char test_string[] = "qvNqTZp1Z0yjuUXv6PHmyLWv0cUP7SHr2o2caUsvDz9oxhDQI9lLp2meDyEBvPW6lvYtuIC8nVEGgHDgLIW62zOpJKjOlem3sIoRgXz1tI3tPwIk8npEEASnMoDHYsjAebaViYDXBvU4FBBNyblmizLqaZFnSd5ebPHVD1006G4MMLFR3THV7mcJpeKHU6KVSRfKlh5ixYgoOevK59csJfpEIdEDDWNDpF95YGHzrlKUoKqia6AIonMXUZgG2AOkOg0VHmrCN7U99wONsa1NNW7KhiSskc2bzJlROKCFlgiLo4FfS1XKGLQCAxREVlKFXcG7rGemkwhdXuDM1nYxFUYn56YPvuGbrLZl0MZn6gM28nq5og2GeSCxID2XCGmoovUGmZdxuchwaInjSrHJRpLPZy5WEjLi0BNa14bHXzZpHYXOYXyX7d6uUHUlvrJYCLaiyoPppV0rKJSa6zBA6pjEplm9Sv6wYQZHskTYD3NPTj1qKkumRC6u9Ndycsp27brPtcZKNGqfH8WXjCRIDJ7TDrUtKKJZP4gESedmUsDO4U1S3fuIlMgpBTKfIjCuWV1EJJtNWtVr3dOJBMz6sW7e";
+#ifdef USE_TRACE
+// Dump command: 't' on the console prints the trace rings
+static void TraceConsole(void* arg)
+{
+    (void)arg;
 
-void MMU_Map1MbPages(ulong_t* pgt, ulong_t paddr, ulong_t vaddr, size_t pages, memCfg_t* memCfg);
+    while(TRUE)
+    {
+        if(getc() == 't')
+        {
+            TraceDump();
+        }
+    }
+}
+#endif
 
 void main()
 {
+    // Counters enabled without a reset: the cycle counter runs since
+    // cpu_boot (boot.S), so trace timestamps follow the boot phases
+    pmu_int_perfcounters(0, 0);
+
+    // Per-CPU areas are copied before any per-CPU variable is written.
+    // Without them every CPU would use the variables of CPU 0: stop here
+    // (nothing can be printed yet)
+    if(PercpuInit() != E_OK)
+    {
+        while(TRUE)
+        {
+            wfe();
+        }
+    }
+
+    // The boot code becomes the idle thread of CPU 0 (spinlocks need a thread)
+    SchedInit();
+    // Device tree from the boot loader: RAM size and device addresses
+    PlatformInit();
+    // Hand the remaining RAM to the page allocator
+    PageInit();
+    SlabInit();
+    SpaceInit();
+    TRACE(TRACE_BOOT, TRACE_BOOT_MEMORY, 0);
+    VfpInit();
+    VirtualInit();
+    // Device window (the serial driver maps its registers with ioremap)
+    IoRemapInit();
+
 #ifdef USE_EARLY_UART
     SerialOpen();
     puts("BareMetal OS!!!");
 #endif
+    TRACE(TRACE_BOOT, TRACE_BOOT_CONSOLE, 0);
 
-    uint32_t pmu_counter = 0;
-
-    // Initialize PMU counters
-    pmu_int_perfcounters(1, 0);
+    // Interrupt controller, IPIs and tick, then the secondary CPUs
+    IrqInit();
+    IpiInit();
+    TlbInit();
+    SchedCpuStart();
+    TRACE(TRACE_BOOT, TRACE_BOOT_IRQ, 0);
+    SmpBoot();
+    TRACE(TRACE_BOOT, TRACE_BOOT_SMP, 0);
 
-    PERFORMANCE_MONITORING_START(pmu_counter);
-
-    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
-
-    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
-
-    MMU_MapPages(pgt, (vaddr_t)0xA0100000, (pbv_t*)pages, 4, &memCfg);
-
-    uint32_t* ptr = (uint32_t*)0xA6B00000;
-
-    *ptr = 0xDEADFACE;
-
-    char* dst = (char*)0xA20FFFC0;
-    char* src = (char*)test_string;
-
-    while(*src != '\0')
-    {
-        *dst++ = *src++;
-    }
-
-    *dst = '\0';
-
-    PERFORMANCE_MONITORING_STOP(pmu_counter);
+#ifdef USE_EARLY_UART
+    BootTimesPrint();
+#endif
 
-    char str[16] = {0};
-    itoa(pmu_counter, str, 10);
+#ifdef USE_BENCHMARKS
+    ThreadCreate("bench", BenchThread, NULL, SCHED_PRIORITY_DEFAULT, 0);
+#endif
 
-#ifdef USE_EARLY_UART
-    puts("\n\nMMU test pass");
-    puts("\nTest duration: ");
-    puts(str);
-    puts("\n");
-    puts("\n");
-    puts((char*)0xA20FFFC0);
+#ifdef USE_TRACE
+    ThreadCreate("trace", TraceConsole, NULL, SCHED_PRIORITY_MIN, 0);
 #endif
 
-    while(TRUE);
+    SchedIdle();
 }
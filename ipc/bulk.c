@@ -0,0 +1,284 @@
+/**
+ * @file        bulk.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Bulk IPC by page mapping
+ *
+ *              The receiver gets the sender pages in its page table, so
+ *              the cost depends on the number of table entries (set by the
+ *              alignment of the chunks) rather than on the payload size.
+ *              User mappings are not global: they are tagged with the ASID
+ *              of the space and never hit in other spaces.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <ipc.h>
+#include <page.h>
+#include <misc.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+#define PAGE_ALIGNED(x)     ((((ulong_t)(x)) & (PAGE_SIZE - 1)) == 0)
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Checks a user range
+ * @param   vaddr - Start address
+ *          size - Size of the range
+ * @retval  TRUE if the range is page aligned and in the user space
+ */
+static bool_t IpcRangeValid(vaddr_t vaddr, size_t size);
+
+/**
+ * @brief   Gets the size of a page buffer vector
+ * @param   pages - Page buffer vector
+ *          count - Number of entries
+ * @retval  Size, 0 if a chunk is not page aligned
+ */
+static size_t IpcVectorSize(pbv_t* pages, size_t count);
+
+/**
+ * @brief   Checks that a range is outside the regions of a space: region
+ *          pages are released with the region, shared pages must not be
+ *          (space lock held)
+ * @param   space - Address space
+ *          vaddr - Start address
+ *          size - Size of the range
+ * @retval  TRUE if no region overlaps the range
+ */
+static bool_t IpcRangeUnreserved(space_t* space, vaddr_t vaddr, size_t size);
+
+/**
+ * @brief   Maps pages in an address space (space lock held)
+ * @param   to - Receiver address space
+ *          vaddr - Receiver address
+ *          pages - Page buffer vector
+ *          count - Number of entries
+ *          flags - IPC_MAP_* flags
+ * @retval  No return
+ */
+static void IpcMap(space_t* to, vaddr_t vaddr, pbv_t* pages, size_t count, uint32_t flags);
+
+/**
+ * @brief   Unmaps a range mapped by IpcShare / IpcGrant and drops the page
+ *          references held by the mappings (space lock held)
+ * @param   space - Address space
+ *          vaddr - Start address
+ *          size - Size of the range
+ * @retval  No return
+ */
+static void IpcUnmap(space_t* space, vaddr_t vaddr, size_t size);
+
+
+/* Private functions -------------------------------------- */
+
+bool_t IpcRangeValid(vaddr_t vaddr, size_t size)
+{
+    return (size != 0) && PAGE_ALIGNED(vaddr) && PAGE_ALIGNED(size) &&
+           ((ulong_t)vaddr < USER_SPACE_END) && (size <= (USER_SPACE_END - (ulong_t)vaddr));
+}
+
+size_t IpcVectorSize(pbv_t* pages, size_t count)
+{
+    size_t size = 0;
+    size_t i;
+
+    for(i = 0; i < count; ++i)
+    {
+        if(!PAGE_ALIGNED(pages[i].data) || !PAGE_ALIGNED(pages[i].size))
+        {
+            return 0;
+        }
+
+        size += pages[i].size;
+    }
+
+    return size;
+}
+
+bool_t IpcRangeUnreserved(space_t* space, vaddr_t vaddr, size_t size)
+{
+    ulong_t start = (ulong_t)vaddr;
+    uint32_t i;
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        space_region_t* region = &space->regions[i];
+
+        if((region->size != 0) &&
+           (start < ((ulong_t)region->start + region->size)) && ((ulong_t)region->start < (start + size)))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+void IpcMap(space_t* to, vaddr_t vaddr, pbv_t* pages, size_t count, uint32_t flags)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWRO, TRUE, FALSE, FALSE};
+
+    if(flags & IPC_MAP_WRITE)
+    {
+        memCfg.apolicy = APOLICY_RWRW;
+    }
+
+    MMU_MapPages(to->pgt, vaddr, pages, count, &memCfg);
+}
+
+void IpcUnmap(space_t* space, vaddr_t vaddr, size_t size)
+{
+    ulong_t start = (ulong_t)vaddr;
+    ulong_t end = start + size;
+
+    while(start < end)
+    {
+        paddr_t paddr = MMU_V2P(space->pgt, (vaddr_t)start);
+        ulong_t next = start + PAGE_SIZE;
+        ulong_t offset;
+
+        if(paddr == NULL)
+        {
+            start = next;
+            continue;
+        }
+
+        // A physically contiguous run ends on a mapping granule boundary
+        while((next < end) && (MMU_V2P(space->pgt, (vaddr_t)next) == (paddr_t)((ulong_t)paddr + (next - start))))
+        {
+            next += PAGE_SIZE;
+        }
+
+        // No CPU may reach the pages once their last reference is dropped
+        MMU_UnmapPages(space->pgt, (vaddr_t)start, next - start);
+
+        for(offset = 0; offset < (next - start); offset += PAGE_SIZE)
+        {
+            PagePut((paddr_t)((ulong_t)paddr + offset));
+        }
+
+        start = next;
+    }
+}
+
+/**
+ * IpcShare Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcShare(space_t* to, vaddr_t vaddr, pbv_t* pages, size_t count, uint32_t flags)
+{
+    size_t size = IpcVectorSize(pages, count);
+    size_t i, offset;
+
+    if((to == NULL) || !IpcRangeValid(vaddr, size))
+    {
+        return E_INVAL;
+    }
+
+    SpinLock(&to->lock);
+
+    if(!IpcRangeUnreserved(to, vaddr, size))
+    {
+        SpinUnlock(&to->lock);
+        return E_INVAL;
+    }
+
+    // Each mapping holds a reference, as in SpaceShare
+    for(i = 0; i < count; ++i)
+    {
+        for(offset = 0; offset < pages[i].size; offset += PAGE_SIZE)
+        {
+            PageGet((paddr_t)((ulong_t)pages[i].data + offset));
+        }
+    }
+
+    IpcMap(to, vaddr, pages, count, flags);
+    SpinUnlock(&to->lock);
+
+    return E_OK;
+}
+
+/**
+ * IpcGrant Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcGrant(space_t* from, vaddr_t fromVaddr, space_t* to, vaddr_t toVaddr, pbv_t* pages, size_t count, uint32_t flags)
+{
+    size_t size = IpcVectorSize(pages, count);
+    space_t* first = (from < to) ? from : to;
+    space_t* second = (from < to) ? to : from;
+    int32_t status = E_OK;
+
+    if((from == NULL) || (to == NULL) || !IpcRangeValid(fromVaddr, size) || !IpcRangeValid(toVaddr, size))
+    {
+        return E_INVAL;
+    }
+
+    // Both spaces locked in address order: no reservation can slip in
+    // between the unmap and the map
+    SpinLock(&first->lock);
+
+    if(second != first)
+    {
+        SpinLock(&second->lock);
+    }
+
+    // Region pages belong to the region: only IPC mappings (and their
+    // references) move to the receiver
+    if(!IpcRangeUnreserved(from, fromVaddr, size) || !IpcRangeUnreserved(to, toVaddr, size))
+    {
+        status = E_INVAL;
+    }
+    else
+    {
+        // The sender loses access before the receiver gets it
+        MMU_UnmapPages(from->pgt, fromVaddr, size);
+        IpcMap(to, toVaddr, pages, count, flags);
+    }
+
+    if(second != first)
+    {
+        SpinUnlock(&second->lock);
+    }
+
+    SpinUnlock(&first->lock);
+
+    return status;
+}
+
+/**
+ * IpcRevoke Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcRevoke(space_t* space, vaddr_t vaddr, size_t size)
+{
+    if((space == NULL) || !IpcRangeValid(vaddr, size))
+    {
+        return E_INVAL;
+    }
+
+    SpinLock(&space->lock);
+
+    if(!IpcRangeUnreserved(space, vaddr, size))
+    {
+        SpinUnlock(&space->lock);
+        return E_INVAL;
+    }
+
+    IpcUnmap(space, vaddr, size);
+    SpinUnlock(&space->lock);
+
+    return E_OK;
+}
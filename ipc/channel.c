@@ -0,0 +1,214 @@
+/**
+ * @file        channel.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Shared memory channels (single producer / single consumer)
+ *
+ *              head and tail are free running byte counters, the ring holds
+ *              head - tail bytes. Each side only writes its own index and
+ *              refreshes its copy of the other one when the cached value
+ *              says the ring is full (producer) or empty (consumer).
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <channel.h>
+#include <ipc.h>
+#include <page.h>
+#include <virtual.h>
+#include <atomic.h>
+#include <string.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+#define MIN(a, b)           (((a) < (b)) ? (a) : (b))
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Copies into the ring data, wrapping at the end
+ * @param   ch - Channel
+ *          offset - Free running offset
+ *          data - Data
+ *          size - Bytes to copy (at most the data size)
+ * @retval  No return
+ */
+static void ChannelCopyIn(channel_t* ch, uint32_t offset, const uint8_t* data, size_t size);
+
+/**
+ * @brief   Copies from the ring data, wrapping at the end
+ * @param   ch - Channel
+ *          offset - Free running offset
+ *          data - Buffer
+ *          size - Bytes to copy (at most the data size)
+ * @retval  No return
+ */
+static void ChannelCopyOut(channel_t* ch, uint32_t offset, uint8_t* data, size_t size);
+
+
+/* Private functions -------------------------------------- */
+
+void ChannelCopyIn(channel_t* ch, uint32_t offset, const uint8_t* data, size_t size)
+{
+    uint32_t start = offset & ch->mask;
+    size_t first = MIN(size, ch->dataSize - start);
+
+    memcpy(CHANNEL_DATA(ch->ring) + start, data, first);
+    memcpy(CHANNEL_DATA(ch->ring), data + first, size - first);
+}
+
+void ChannelCopyOut(channel_t* ch, uint32_t offset, uint8_t* data, size_t size)
+{
+    uint32_t start = offset & ch->mask;
+    size_t first = MIN(size, ch->dataSize - start);
+
+    memcpy(data, CHANNEL_DATA(ch->ring) + start, first);
+    memcpy(data + first, CHANNEL_DATA(ch->ring), size - first);
+}
+
+/**
+ * ChannelCreate Implementation (See header include/channel.h file for description)
+*/
+int32_t ChannelCreate(channel_t* ch, size_t size)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+
+    if((size < PAGE_SIZE) || (size & (size - 1)))
+    {
+        return E_INVAL;
+    }
+
+    ch->size = size + PAGE_SIZE;
+    ch->count = PageAllocVector(ch->size, ch->pages, CHANNEL_PAGES_MAX);
+
+    if(ch->count == 0)
+    {
+        return E_NO_MEMORY;
+    }
+
+    ch->ring = (channel_ring_t*)VirtualMap(ch->pages, ch->count, &memCfg, VIRTUAL_GUARD);
+
+    if(ch->ring == NULL)
+    {
+        PageFreeVector(ch->pages, ch->count);
+        return E_NO_MEMORY;
+    }
+
+    ch->dataSize = size;
+    ch->mask = size - 1;
+
+    memset(ch->ring, 0, sizeof(channel_ring_t));
+    ch->ring->size = size;
+
+    return E_OK;
+}
+
+/**
+ * ChannelDestroy Implementation (See header include/channel.h file for description)
+*/
+void ChannelDestroy(channel_t* ch)
+{
+    VirtualUnmap(ch->ring);
+    PageFreeVector(ch->pages, ch->count);
+
+    ch->ring = NULL;
+    ch->count = 0;
+}
+
+/**
+ * ChannelMap Implementation (See header include/channel.h file for description)
+*/
+int32_t ChannelMap(channel_t* ch, space_t* space, vaddr_t vaddr)
+{
+    return IpcShare(space, vaddr, ch->pages, ch->count, IPC_MAP_WRITE);
+}
+
+/**
+ * ChannelWrite Implementation (See header include/channel.h file for description)
+*/
+size_t ChannelWrite(channel_t* ch, const void* data, size_t size)
+{
+    channel_ring_t* ring = ch->ring;
+    uint32_t head = READ_ONCE(ring->producer.head);
+    uint32_t used = head - ring->producer.tailCache;
+
+    if((used > ch->dataSize) || ((ch->dataSize - used) < size))
+    {
+        ring->producer.tailCache = READ_ONCE(ring->consumer.tail);
+
+        // The consumer is done reading the space before it is overwritten
+        smp_mb();
+
+        used = head - ring->producer.tailCache;
+    }
+
+    // Indexes rewritten by the other side: more data than the ring holds
+    if(used > ch->dataSize)
+    {
+        return 0;
+    }
+
+    size = MIN(size, ch->dataSize - used);
+
+    if(size != 0)
+    {
+        ChannelCopyIn(ch, head, (const uint8_t*)data, size);
+
+        // Data visible before the new head
+        smp_wmb();
+        WRITE_ONCE(ring->producer.head, head + size);
+    }
+
+    return size;
+}
+
+/**
+ * ChannelRead Implementation (See header include/channel.h file for description)
+*/
+size_t ChannelRead(channel_t* ch, void* data, size_t size)
+{
+    channel_ring_t* ring = ch->ring;
+    uint32_t tail = READ_ONCE(ring->consumer.tail);
+    uint32_t used = ring->consumer.headCache - tail;
+
+    if((used > ch->dataSize) || (used < size))
+    {
+        ring->consumer.headCache = READ_ONCE(ring->producer.head);
+
+        // Data read after the head that published it
+        smp_rmb();
+
+        used = ring->consumer.headCache - tail;
+    }
+
+    // Indexes rewritten by the other side: more data than the ring holds
+    if(used > ch->dataSize)
+    {
+        return 0;
+    }
+
+    size = MIN(size, used);
+
+    if(size != 0)
+    {
+        ChannelCopyOut(ch, tail, (uint8_t*)data, size);
+
+        // Reads complete before the producer may reuse the space
+        smp_mb();
+        WRITE_ONCE(ring->consumer.tail, tail + size);
+    }
+
+    return size;
+}
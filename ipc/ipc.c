@@ -0,0 +1,485 @@
+/**
+ * @file        ipc.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Synchronous IPC (endpoints and register messages)
+ *
+ *              A thread waiting on an endpoint is blocked and linked in one
+ *              of its queues (through the run queue links, unused while
+ *              blocked). The side that arrives second copies the message
+ *              between the thread descriptors, so the rendezvous costs one
+ *              lock and, when the other thread has to run next, a direct
+ *              switch. Preemption is disabled from the moment a thread
+ *              marks itself blocked until it is switched out, so it cannot
+ *              be preempted after publishing itself and before the thread
+ *              it has to wake is woken.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <ipc.h>
+#include <sched.h>
+#include <spinlock.h>
+#include <percpu.h>
+
+
+/* Private constants -------------------------------------- */
+
+// The sender waits for a reply
+#define IPC_FLAG_CALL       (1 << 0)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    spinlock_t  lock;
+    const char* name;
+    bool_t      used;
+    thread_t*   senders;                // Senders waiting for a receiver
+    thread_t*   sendersTail;
+    thread_t*   receivers;              // Receivers waiting for a message
+    thread_t*   receiversTail;
+}endpoint_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static endpoint_t endpoints[IPC_ENDPOINTS];
+
+static spinlock_t endpointsLock = SPINLOCK_INIT("endpoints");
+
+static DEFINE_PERCPU(ipc_stats_t, ipcStats);
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Gets an endpoint from its identifier
+ * @param   id - Endpoint identifier
+ * @retval  Endpoint, NULL if not valid
+ */
+static endpoint_t* IpcEndpoint(uint32_t id);
+
+/**
+ * @brief   Adds a thread at the tail of an endpoint queue
+ * @param   head - Queue head
+ *          tail - Queue tail
+ *          thread - Thread
+ * @retval  No return
+ */
+static void IpcQueuePush(thread_t** head, thread_t** tail, thread_t* thread);
+
+/**
+ * @brief   Removes the thread at the head of an endpoint queue
+ * @param   head - Queue head
+ *          tail - Queue tail
+ * @retval  Thread, NULL if the queue is empty
+ */
+static thread_t* IpcQueuePop(thread_t** head, thread_t** tail);
+
+/**
+ * @brief   Copies the message registers
+ * @param   dst - Destination
+ *          src - Source
+ * @retval  No return
+ */
+static inline void IpcCopy(uint32_t* dst, const uint32_t* src);
+
+/**
+ * @brief   Runs a thread the running thread has just made ready to run:
+ *          directly when possible, through the scheduler otherwise. The
+ *          running thread must be marked blocked
+ * @param   next - Thread (blocked)
+ * @retval  No return (until the running thread is woken)
+ */
+static void IpcSwitch(thread_t* next);
+
+/**
+ * @brief   Send and call
+ * @param   id - Endpoint identifier
+ *          msg - Message (replaced by the reply for a call)
+ *          flags - IPC_FLAG_CALL or 0
+ * @retval  E_OK on success, E_INVAL if id is not valid
+ */
+static int32_t IpcTransfer(uint32_t id, ipc_msg_t* msg, uint32_t flags);
+
+/**
+ * @brief   Takes the message of a waiting sender. Senders of a call stay
+ *          blocked until the reply, the others are returned to be woken
+ * @param   self - Running thread
+ *          sender - Sender taken from the queue
+ *          msg - Message received
+ * @retval  Sender to wake after releasing the endpoint, NULL if none
+ */
+static thread_t* IpcTake(thread_t* self, thread_t* sender, ipc_msg_t* msg);
+
+
+/* Private functions -------------------------------------- */
+
+endpoint_t* IpcEndpoint(uint32_t id)
+{
+    if((id >= IPC_ENDPOINTS) || !endpoints[id].used)
+    {
+        return NULL;
+    }
+
+    return &endpoints[id];
+}
+
+void IpcQueuePush(thread_t** head, thread_t** tail, thread_t* thread)
+{
+    thread->next = NULL;
+
+    if(*head == NULL)
+    {
+        *head = thread;
+    }
+    else
+    {
+        (*tail)->next = thread;
+    }
+
+    *tail = thread;
+}
+
+thread_t* IpcQueuePop(thread_t** head, thread_t** tail)
+{
+    thread_t* thread = *head;
+
+    if(thread != NULL)
+    {
+        *head = thread->next;
+
+        if(*head == NULL)
+        {
+            *tail = NULL;
+        }
+    }
+
+    return thread;
+}
+
+void IpcCopy(uint32_t* dst, const uint32_t* src)
+{
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    dst[3] = src[3];
+}
+
+void IpcSwitch(thread_t* next)
+{
+    if(SchedHandoff(next) == E_OK)
+    {
+        THIS_CPU(ipcStats).handoffs++;
+        return;
+    }
+
+    // Next is still switching out on another CPU or bound elsewhere
+    ThreadWake(next);
+    Schedule();
+}
+
+thread_t* IpcTake(thread_t* self, thread_t* sender, ipc_msg_t* msg)
+{
+    IpcCopy(msg->w, sender->ipcMsg);
+
+    if(sender->ipcFlags & IPC_FLAG_CALL)
+    {
+        self->ipcCaller = sender;
+        return NULL;
+    }
+
+    self->ipcCaller = NULL;
+    return sender;
+}
+
+int32_t IpcTransfer(uint32_t id, ipc_msg_t* msg, uint32_t flags)
+{
+    endpoint_t* ep = IpcEndpoint(id);
+    thread_t* self = SchedCurrent();
+    thread_t* receiver;
+
+    if(ep == NULL)
+    {
+        return E_INVAL;
+    }
+
+    PreemptDisable();
+
+    if(flags & IPC_FLAG_CALL)
+    {
+        THIS_CPU(ipcStats).calls++;
+    }
+    else
+    {
+        THIS_CPU(ipcStats).sends++;
+    }
+
+    SpinLock(&ep->lock);
+
+    if((receiver = IpcQueuePop(&ep->receivers, &ep->receiversTail)) != NULL)
+    {
+        // Fast path: the receiver is waiting
+        IpcCopy(receiver->ipcMsg, msg->w);
+        receiver->ipcCaller = (flags & IPC_FLAG_CALL) ? self : NULL;
+
+        if(flags & IPC_FLAG_CALL)
+        {
+            self->state = THREAD_BLOCKED;
+        }
+
+        SpinUnlock(&ep->lock);
+
+        if(flags & IPC_FLAG_CALL)
+        {
+            // The receiver runs and replies while the caller waits
+            IpcSwitch(receiver);
+        }
+        else
+        {
+            ThreadWake(receiver);
+        }
+    }
+    else
+    {
+        IpcCopy(self->ipcMsg, msg->w);
+        self->ipcFlags = flags;
+        self->state = THREAD_BLOCKED;
+        IpcQueuePush(&ep->senders, &ep->sendersTail, self);
+
+        SpinUnlock(&ep->lock);
+
+        THIS_CPU(ipcStats).queued++;
+
+        // Woken by the receiver (send) or by the reply (call)
+        Schedule();
+    }
+
+    if(flags & IPC_FLAG_CALL)
+    {
+        IpcCopy(msg->w, self->ipcMsg);
+    }
+
+    PreemptEnable();
+
+    return E_OK;
+}
+
+/**
+ * IpcEndpointCreate Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcEndpointCreate(const char* name)
+{
+    int32_t id;
+
+    SpinLock(&endpointsLock);
+
+    for(id = 0; id < IPC_ENDPOINTS; ++id)
+    {
+        endpoint_t* ep = &endpoints[id];
+
+        if(!ep->used)
+        {
+            SpinLockInit(&ep->lock, name);
+            ep->name = name;
+            ep->senders = ep->sendersTail = NULL;
+            ep->receivers = ep->receiversTail = NULL;
+            ep->used = TRUE;
+            break;
+        }
+    }
+
+    SpinUnlock(&endpointsLock);
+
+    return (id == IPC_ENDPOINTS) ? E_NO_RES : id;
+}
+
+/**
+ * IpcEndpointDestroy Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcEndpointDestroy(uint32_t id)
+{
+    endpoint_t* ep = IpcEndpoint(id);
+    int32_t status = E_OK;
+
+    if(ep == NULL)
+    {
+        return E_INVAL;
+    }
+
+    SpinLock(&endpointsLock);
+    SpinLock(&ep->lock);
+
+    if((ep->senders != NULL) || (ep->receivers != NULL))
+    {
+        status = E_BUSY;
+    }
+    else
+    {
+        ep->used = FALSE;
+    }
+
+    SpinUnlock(&ep->lock);
+    SpinUnlock(&endpointsLock);
+
+    return status;
+}
+
+/**
+ * IpcSend Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcSend(uint32_t ep, ipc_msg_t* msg)
+{
+    return IpcTransfer(ep, msg, 0);
+}
+
+/**
+ * IpcCall Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcCall(uint32_t ep, ipc_msg_t* msg)
+{
+    return IpcTransfer(ep, msg, IPC_FLAG_CALL);
+}
+
+/**
+ * IpcReceive Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcReceive(uint32_t id, ipc_msg_t* msg)
+{
+    endpoint_t* ep = IpcEndpoint(id);
+    thread_t* self = SchedCurrent();
+    thread_t* sender;
+
+    if(ep == NULL)
+    {
+        return E_INVAL;
+    }
+
+    PreemptDisable();
+    SpinLock(&ep->lock);
+
+    if((sender = IpcQueuePop(&ep->senders, &ep->sendersTail)) != NULL)
+    {
+        sender = IpcTake(self, sender, msg);
+
+        SpinUnlock(&ep->lock);
+
+        if(sender != NULL)
+        {
+            ThreadWake(sender);
+        }
+    }
+    else
+    {
+        self->state = THREAD_BLOCKED;
+        IpcQueuePush(&ep->receivers, &ep->receiversTail, self);
+
+        SpinUnlock(&ep->lock);
+
+        THIS_CPU(ipcStats).queued++;
+
+        // The sender fills ipcMsg and ipcCaller
+        Schedule();
+
+        IpcCopy(msg->w, self->ipcMsg);
+    }
+
+    PreemptEnable();
+
+    return E_OK;
+}
+
+/**
+ * IpcReplyWait Implementation (See header include/ipc.h file for description)
+*/
+int32_t IpcReplyWait(uint32_t id, ipc_msg_t* msg)
+{
+    endpoint_t* ep = IpcEndpoint(id);
+    thread_t* self = SchedCurrent();
+    thread_t* caller = self->ipcCaller;
+    thread_t* sender;
+
+    if(ep == NULL)
+    {
+        return E_INVAL;
+    }
+
+    PreemptDisable();
+
+    // The caller is blocked until woken, the reply can be written now
+    if(caller != NULL)
+    {
+        IpcCopy(caller->ipcMsg, msg->w);
+        self->ipcCaller = NULL;
+    }
+
+    SpinLock(&ep->lock);
+
+    if((sender = IpcQueuePop(&ep->senders, &ep->sendersTail)) != NULL)
+    {
+        // More requests pending: keep serving, the caller runs when it can
+        sender = IpcTake(self, sender, msg);
+
+        SpinUnlock(&ep->lock);
+
+        if(sender != NULL)
+        {
+            ThreadWake(sender);
+        }
+
+        if(caller != NULL)
+        {
+            ThreadWake(caller);
+        }
+    }
+    else
+    {
+        self->state = THREAD_BLOCKED;
+        IpcQueuePush(&ep->receivers, &ep->receiversTail, self);
+
+        SpinUnlock(&ep->lock);
+
+        if(caller != NULL)
+        {
+            // Fast path: straight back to the caller
+            IpcSwitch(caller);
+        }
+        else
+        {
+            THIS_CPU(ipcStats).queued++;
+            Schedule();
+        }
+
+        IpcCopy(msg->w, self->ipcMsg);
+    }
+
+    PreemptEnable();
+
+    return E_OK;
+}
+
+/**
+ * IpcStats Implementation (See header include/ipc.h file for description)
+*/
+void IpcStats(ipc_stats_t* stats)
+{
+    uint32_t cpu;
+
+    *stats = (ipc_stats_t){0};
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        ipc_stats_t* cpuStats = PERCPU_PTR(ipcStats, cpu);
+
+        stats->calls += cpuStats->calls;
+        stats->sends += cpuStats->sends;
+        stats->handoffs += cpuStats->handoffs;
+        stats->queued += cpuStats->queued;
+    }
+}
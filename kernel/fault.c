@@ -0,0 +1,139 @@
+/**
+ * @file        fault.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Abort Handling (fault status decoding)
+ *
+ *              Short descriptor fault status: FS[4] is FSR bit 10, FS[3:0]
+ *              bits 3:0. Only section and page translation faults (page
+ *              not populated) and permission faults (write to a shared
+ *              page) can be resolved, and only for user addresses. The
+ *              cycles spent per resolution are counted with the PMU cycle
+ *              counter.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <fault.h>
+#include <space.h>
+#include <sched.h>
+#include <percpu.h>
+#include <pmu.h>
+#include <trace.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Fault status values
+#define FS_TRANSLATION_L1   (0x05)
+#define FS_TRANSLATION_L2   (0x07)
+#define FS_PERMISSION_L1    (0x0D)
+#define FS_PERMISSION_L2    (0x0F)
+
+// DFSR.WnR: abort caused by a write
+#define FSR_WNR             (1 << 11)
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+#define FSR_STATUS(fsr)     ((((fsr) >> 6) & 0x10) | ((fsr) & 0x0F))
+
+
+/* Private variables -------------------------------------- */
+
+static DEFINE_PERCPU(fault_stats_t, faultStats);
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * FaultAbort Implementation (See header include/fault.h file for description)
+*/
+int32_t FaultAbort(uint32_t fsr, vaddr_t far, uint32_t type)
+{
+    uint32_t start = pmu_get_cyclecount();
+    space_t* space = SchedCurrent()->space;
+    uint32_t status = FSR_STATUS(fsr);
+    uint32_t resolution;
+    int32_t result = E_OK;
+    bool_t write;
+
+    TRACE(TRACE_FAULT, far, fsr);
+
+    // Instruction fetches never write
+    write = ((type == FAULT_DATA) && (fsr & FSR_WNR)) ? TRUE : FALSE;
+
+    if((space == NULL) || ((ulong_t)far >= USER_SPACE_END) ||
+       ((status != FS_TRANSLATION_L1) && (status != FS_TRANSLATION_L2) &&
+        (status != FS_PERMISSION_L1) && (status != FS_PERMISSION_L2)) ||
+       (SpaceFault(space, far, write, &resolution) != E_OK))
+    {
+        result = E_FAULT;
+    }
+
+    uint32_t cycles = pmu_get_cyclecount() - start;
+
+    // The handler runs with IRQs enabled: counted on the CPU it ends on
+    PreemptDisable();
+
+    fault_stats_t* stats = THIS_CPU_PTR(faultStats);
+
+    if(result != E_OK)
+    {
+        stats->fatal++;
+    }
+    else if(resolution == SPACE_FAULT_ZERO)
+    {
+        stats->zeroFills++;
+        stats->zeroCycles += cycles;
+    }
+    else if(resolution == SPACE_FAULT_COPY)
+    {
+        stats->copies++;
+        stats->copyCycles += cycles;
+    }
+    else if(resolution == SPACE_FAULT_REUSE)
+    {
+        stats->reuses++;
+        stats->reuseCycles += cycles;
+    }
+    else
+    {
+        stats->spurious++;
+    }
+
+    PreemptEnable();
+
+    return result;
+}
+
+/**
+ * FaultStats Implementation (See header include/fault.h file for description)
+*/
+void FaultStats(fault_stats_t* stats)
+{
+    uint32_t cpu;
+
+    *stats = (fault_stats_t){0};
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        fault_stats_t* cpuStats = PERCPU_PTR(faultStats, cpu);
+
+        stats->zeroFills += cpuStats->zeroFills;
+        stats->copies += cpuStats->copies;
+        stats->reuses += cpuStats->reuses;
+        stats->spurious += cpuStats->spurious;
+        stats->fatal += cpuStats->fatal;
+        stats->zeroCycles += cpuStats->zeroCycles;
+        stats->copyCycles += cpuStats->copyCycles;
+        stats->reuseCycles += cpuStats->reuseCycles;
+    }
+}
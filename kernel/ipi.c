@@ -0,0 +1,280 @@
+/**
+ * @file        ipi.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Inter-Processor Interrupts (GIC SGIs)
+ *
+ *              Each CPU has a queue of call requests. A caller only sends
+ *              the SGI when it finds the queue empty: otherwise the target
+ *              has not taken the queue yet and serves the new request with
+ *              the ones already queued. Requests live on the caller stack
+ *              until the target has run them, the queue locks are taken
+ *              with IRQs masked.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <ipi.h>
+#include <irq.h>
+#include <cpu.h>
+#include <spinlock.h>
+#include <atomic.h>
+#include <percpu.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct ipi_request
+{
+    ipi_func_t          func;
+    void*               arg;
+    volatile uint32_t*  pending;        // Targets of the call still running it
+    struct ipi_request* next;
+}ipi_request_t;
+
+typedef struct
+{
+    spinlock_t     lock;
+    ipi_request_t* head;
+    ipi_request_t* tail;
+    ipi_stats_t    stats;
+}ipi_queue_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static DEFINE_PERCPU(ipi_queue_t, ipiQueue);
+
+static volatile uint32_t ipiOnline;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Runs the requests queued for the running CPU (IRQs masked)
+ * @param   None
+ * @retval  No return
+ */
+static void IpiProcess(void);
+
+/**
+ * @brief   Reschedule SGI handler: the run queue is checked on IRQ exit
+ *          (SchedIrqExit), nothing else to do
+ * @param   irq - Interrupt ID
+ *          arg - Not used
+ * @retval  No return
+ */
+static void IpiReschedHandler(uint32_t irq, void* arg);
+
+/**
+ * @brief   Call SGI handler
+ * @param   irq - Interrupt ID
+ *          arg - Not used
+ * @retval  No return
+ */
+static void IpiCallHandler(uint32_t irq, void* arg);
+
+
+/* Private functions -------------------------------------- */
+
+void IpiProcess(void)
+{
+    ipi_queue_t* queue = THIS_CPU_PTR(ipiQueue);
+    ipi_request_t* request;
+    ipi_request_t* next;
+
+    SpinLock(&queue->lock);
+    request = queue->head;
+    queue->head = queue->tail = NULL;
+    SpinUnlock(&queue->lock);
+
+    for(; request != NULL; request = next)
+    {
+        // The request is released by the caller once pending drops
+        next = request->next;
+
+        request->func(request->arg);
+        queue->stats.calls++;
+
+        smp_mb();
+        Atomic_FetchAdd32(request->pending, (uint32_t)-1);
+    }
+}
+
+void IpiReschedHandler(uint32_t irq, void* arg)
+{
+    THIS_CPU(ipiQueue).stats.received++;
+}
+
+void IpiCallHandler(uint32_t irq, void* arg)
+{
+    THIS_CPU(ipiQueue).stats.received++;
+
+    IpiProcess();
+}
+
+/**
+ * IpiInit Implementation (See header include/ipi.h file for description)
+*/
+int32_t IpiInit(void)
+{
+    uint32_t cpu;
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        ipi_queue_t* queue = PERCPU_PTR(ipiQueue, cpu);
+
+        SpinLockInit(&queue->lock, "ipi");
+        queue->head = queue->tail = NULL;
+        queue->stats = (ipi_stats_t){0};
+    }
+
+    IrqRegister(IPI_RESCHED, IpiReschedHandler, NULL);
+    IrqRegister(IPI_CALL, IpiCallHandler, NULL);
+
+    IpiCpuInit();
+
+    return E_OK;
+}
+
+/**
+ * IpiCpuInit Implementation (See header include/ipi.h file for description)
+*/
+void IpiCpuInit(void)
+{
+    IrqEnable(IPI_RESCHED);
+    IrqEnable(IPI_CALL);
+
+    Atomic_SetBit(CPU_Id(), &ipiOnline);
+}
+
+/**
+ * IpiOnlineMask Implementation (See header include/ipi.h file for description)
+*/
+uint32_t IpiOnlineMask(void)
+{
+    return READ_ONCE(ipiOnline);
+}
+
+/**
+ * IpiResched Implementation (See header include/ipi.h file for description)
+*/
+void IpiResched(uint32_t cpu)
+{
+    uint32_t flags = CPU_IrqSave();
+    ipi_stats_t* stats = &THIS_CPU(ipiQueue).stats;
+
+    stats->resched++;
+    stats->sent++;
+
+    IrqSendSgi(IPI_RESCHED, 1 << cpu);
+
+    CPU_IrqRestore(flags);
+}
+
+/**
+ * IpiCall Implementation (See header include/ipi.h file for description)
+*/
+uint32_t IpiCall(uint32_t cpuMask, ipi_func_t func, void* arg)
+{
+    ipi_request_t requests[NR_CPUS];
+    volatile uint32_t pending = 0;
+    uint32_t flags = CPU_IrqSave();
+    uint32_t self = CPU_Id();
+    uint32_t targets = cpuMask & READ_ONCE(ipiOnline) & ~(1 << self);
+    uint32_t sgiMask = 0, sent = 0;
+    uint32_t cpu;
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        if(targets & (1 << cpu))
+        {
+            pending++;
+        }
+    }
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        ipi_queue_t* queue = PERCPU_PTR(ipiQueue, cpu);
+        ipi_request_t* request = &requests[cpu];
+
+        if(!(targets & (1 << cpu)))
+        {
+            continue;
+        }
+
+        request->func = func;
+        request->arg = arg;
+        request->pending = &pending;
+        request->next = NULL;
+
+        SpinLock(&queue->lock);
+
+        if(queue->head == NULL)
+        {
+            queue->head = request;
+            sgiMask |= (1 << cpu);
+            sent++;
+        }
+        else
+        {
+            queue->tail->next = request;
+        }
+
+        queue->tail = request;
+
+        SpinUnlock(&queue->lock);
+    }
+
+    if(sgiMask != 0)
+    {
+        THIS_CPU(ipiQueue).stats.sent += sent;
+        IrqSendSgi(IPI_CALL, sgiMask);
+    }
+
+    if(cpuMask & (1 << self))
+    {
+        func(arg);
+    }
+
+    while(READ_ONCE(pending) != 0)
+    {
+        if(READ_ONCE(THIS_CPU(ipiQueue).head) != NULL)
+        {
+            IpiProcess();
+        }
+    }
+
+    // The targets are done with the requests and whatever func touched
+    smp_mb();
+
+    CPU_IrqRestore(flags);
+
+    return sent;
+}
+
+/**
+ * IpiStats Implementation (See header include/ipi.h file for description)
+*/
+int32_t IpiStats(uint32_t cpu, ipi_stats_t* stats)
+{
+    if(cpu >= NR_CPUS)
+    {
+        return E_INVAL;
+    }
+
+    uint32_t flags = CPU_IrqSave();
+
+    *stats = PERCPU(ipiQueue, cpu).stats;
+
+    CPU_IrqRestore(flags);
+
+    return E_OK;
+}
@@ -0,0 +1,857 @@
+/**
+ * @file        sched.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Thread Scheduler (per-CPU run queues with work stealing)
+ *
+ *              The run queue lock is taken with interrupts masked and held
+ *              across ContextSwitch: the thread switched in releases it
+ *              (SchedFinishSwitch), on the same CPU. A thread is only in a
+ *              run queue while it is ready, the running thread is kept in
+ *              the queue current field.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <sched.h>
+#include <spinlock.h>
+#include <atomic.h>
+#include <percpu.h>
+#include <page.h>
+#include <irq.h>
+#include <ipi.h>
+#include <vfp.h>
+#include <timer.h>
+#include <board.h>
+#include <platform.h>
+#include <cache.h>
+#include <pmu.h>
+#include <trace.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Polls of the online flag of a secondary CPU before giving up on it
+#define SMP_BOOT_TIMEOUT    (10000000)
+
+#define PEN_CLOSED          (0xFFFFFFFF)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    bool_t        needResched;          // Must be the first field (entry.S)
+    spinlock_t    lock;
+    uint32_t      bitmap;               // Bit n set: queues[n] not empty
+    thread_t*     queues[SCHED_PRIORITIES];
+    uint32_t      ready;
+    thread_t*     current;
+    thread_t*     idle;
+    thread_t*     dead;                 // Exited thread, released after the switch
+    bool_t        online;
+    uint32_t      switchStart;
+    sched_stats_t stats;
+}runqueue_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+// Not static: the system call return path tests needResched (entry.S)
+DEFINE_PERCPU(runqueue_t, runQueue);
+
+// Secondary CPU release (boot.S): cpu number and initial stack
+extern volatile uint32_t secondary_pen[2];
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Switches to another thread (kernel.S)
+ * @param   prev - Context of the running thread
+ *          next - Context of the thread switched in
+ * @retval  No return (until prev is switched in again)
+ */
+extern void ContextSwitch(thread_context_t* prev, thread_context_t* next);
+
+/**
+ * @brief   Sets up a thread descriptor at the base of its stack
+ * @param   thread - Thread descriptor
+ *          name - Thread name
+ *          priority - Priority
+ *          affinity - THREAD_CPU_ANY or CPU number
+ * @retval  No return
+ */
+static void ThreadSetup(thread_t* thread, const char* name, uint32_t priority, uint32_t affinity);
+
+/**
+ * @brief   First function of a new thread: completes the switch and runs
+ *          the thread entry
+ * @param   None
+ * @retval  Does not return
+ */
+static void ThreadStart(void);
+
+/**
+ * @brief   Adds a ready thread at the tail of its priority queue
+ * @param   rq - Run queue (locked)
+ *          thread - Thread
+ * @retval  No return
+ */
+static void RunQueueAdd(runqueue_t* rq, thread_t* thread);
+
+/**
+ * @brief   Removes a thread from its priority queue
+ * @param   rq - Run queue (locked)
+ *          thread - Thread
+ * @retval  No return
+ */
+static void RunQueueRemove(runqueue_t* rq, thread_t* thread);
+
+/**
+ * @brief   Takes the highest priority ready thread
+ * @param   rq - Run queue (locked)
+ * @retval  Thread, NULL if the queue is empty
+ */
+static thread_t* RunQueueTake(runqueue_t* rq);
+
+/**
+ * @brief   Takes a ready thread from another CPU. Locks of other queues
+ *          are only tried, so two CPUs stealing from each other never wait
+ * @param   cpu - Running CPU (its queue is locked)
+ * @retval  Thread, NULL if there is nothing to steal
+ */
+static thread_t* RunQueueSteal(uint32_t cpu);
+
+/**
+ * @brief   Selects the CPU a woken thread is placed on
+ * @param   thread - Thread
+ * @retval  CPU number
+ */
+static uint32_t SchedSelectCpu(thread_t* thread);
+
+/**
+ * @brief   Completes a switch in the thread switched in: releases the run
+ *          queue lock and the stack of an exited thread
+ * @param   None
+ * @retval  No return
+ */
+static void SchedFinishSwitch(void);
+
+
+/* Private functions -------------------------------------- */
+
+void ThreadSetup(thread_t* thread, const char* name, uint32_t priority, uint32_t affinity)
+{
+    uint32_t i;
+
+    for(i = 0; i < 8; ++i)
+    {
+        thread->context.r4_r11[i] = 0;
+    }
+
+    thread->context.sp = (uint32_t)thread + THREAD_STACK_SIZE;
+    thread->context.lr = (uint32_t)ThreadStart;
+    thread->context.ttbr0 = 0;
+    thread->context.asid = 0;
+    thread->context.usrSp = 0;
+    thread->context.usrLr = 0;
+    thread->space = NULL;
+    thread->next = thread->prev = NULL;
+    thread->preemptCount = 0;
+    thread->state = THREAD_BLOCKED;
+    thread->priority = priority;
+    thread->affinity = affinity;
+    thread->cpu = (affinity == THREAD_CPU_ANY) ? CPU_Id() : affinity;
+    thread->timeslice = SCHED_TIMESLICE;
+    thread->name = name;
+    thread->entry = NULL;
+    thread->arg = NULL;
+    thread->ipcFlags = 0;
+    thread->ipcCaller = NULL;
+    thread->vfp = NULL;
+    thread->vfpCpu = VFP_CPU_NONE;
+}
+
+void ThreadStart(void)
+{
+    thread_t* thread = SchedCurrent();
+
+    SchedFinishSwitch();
+    asm volatile("cpsie i" ::: "memory");
+
+    thread->entry(thread->arg);
+
+    ThreadExit();
+}
+
+void RunQueueAdd(runqueue_t* rq, thread_t* thread)
+{
+    thread_t** head = &rq->queues[thread->priority];
+
+    if(*head == NULL)
+    {
+        thread->next = thread->prev = thread;
+        *head = thread;
+        rq->bitmap |= (1 << thread->priority);
+    }
+    else
+    {
+        thread->next = *head;
+        thread->prev = (*head)->prev;
+        thread->prev->next = thread;
+        (*head)->prev = thread;
+    }
+
+    rq->ready++;
+}
+
+void RunQueueRemove(runqueue_t* rq, thread_t* thread)
+{
+    thread_t** head = &rq->queues[thread->priority];
+
+    if(thread->next == thread)
+    {
+        *head = NULL;
+        rq->bitmap &= ~(1 << thread->priority);
+    }
+    else
+    {
+        thread->prev->next = thread->next;
+        thread->next->prev = thread->prev;
+
+        if(*head == thread)
+        {
+            *head = thread->next;
+        }
+    }
+
+    rq->ready--;
+}
+
+thread_t* RunQueueTake(runqueue_t* rq)
+{
+    if(rq->bitmap == 0)
+    {
+        return NULL;
+    }
+
+    thread_t* thread = rq->queues[31 - __builtin_clz(rq->bitmap)];
+
+    RunQueueRemove(rq, thread);
+
+    return thread;
+}
+
+thread_t* RunQueueSteal(uint32_t cpu)
+{
+    uint32_t i;
+
+    for(i = 1; i < NR_CPUS; ++i)
+    {
+        uint32_t victimCpu = (cpu + i) % NR_CPUS;
+        runqueue_t* victim = PERCPU_PTR(runQueue, victimCpu);
+        thread_t* thread = NULL;
+
+        if((READ_ONCE(victim->ready) == 0) || !SpinTryLock(&victim->lock))
+        {
+            continue;
+        }
+
+        // Highest priority thread not bound to the victim
+        uint32_t bitmap = victim->bitmap;
+
+        while((bitmap != 0) && (thread == NULL))
+        {
+            uint32_t priority = 31 - __builtin_clz(bitmap);
+            thread_t* head = victim->queues[priority];
+            thread_t* candidate = head;
+
+            do
+            {
+                if(candidate->affinity == THREAD_CPU_ANY)
+                {
+                    thread = candidate;
+                    break;
+                }
+
+                candidate = candidate->next;
+            }while(candidate != head);
+
+            bitmap &= ~(1 << priority);
+        }
+
+        if(thread != NULL)
+        {
+            RunQueueRemove(victim, thread);
+            thread->cpu = cpu;
+        }
+
+        SpinUnlock(&victim->lock);
+
+        if(thread != NULL)
+        {
+            return thread;
+        }
+    }
+
+    return NULL;
+}
+
+uint32_t SchedSelectCpu(thread_t* thread)
+{
+    uint32_t cpu;
+
+    if(thread->affinity != THREAD_CPU_ANY)
+    {
+        return thread->affinity;
+    }
+
+    // The CPU that ran it last if the thread would run there right away
+    runqueue_t* rq = PERCPU_PTR(runQueue, thread->cpu);
+    thread_t* current = READ_ONCE(rq->current);
+
+    if((current == rq->idle) || (current->priority < thread->priority))
+    {
+        return thread->cpu;
+    }
+
+    // Otherwise an idle CPU
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        rq = PERCPU_PTR(runQueue, cpu);
+
+        if(rq->online && (READ_ONCE(rq->current) == rq->idle) && (READ_ONCE(rq->ready) == 0))
+        {
+            return cpu;
+        }
+    }
+
+    return thread->cpu;
+}
+
+void SchedFinishSwitch(void)
+{
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+    thread_t* dead = rq->dead;
+
+    rq->dead = NULL;
+    rq->stats.scheduleCycles += pmu_get_cyclecount() - rq->switchStart;
+
+    SpinUnlock(&rq->lock);
+
+    if(dead != NULL)
+    {
+        PageFree(MMU_L2P((vaddr_t)dead), THREAD_STACK_ORDER);
+    }
+}
+
+/**
+ * SchedInit Implementation (See header include/sched.h file for description)
+*/
+void SchedInit(void)
+{
+    uint32_t cpu, i;
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        runqueue_t* rq = PERCPU_PTR(runQueue, cpu);
+
+        SpinLockInit(&rq->lock, "runqueue");
+        rq->bitmap = 0;
+        for(i = 0; i < SCHED_PRIORITIES; ++i)
+        {
+            rq->queues[i] = NULL;
+        }
+        rq->ready = 0;
+        rq->current = NULL;
+        rq->idle = NULL;
+        rq->dead = NULL;
+        rq->needResched = FALSE;
+        rq->online = FALSE;
+        rq->stats = (sched_stats_t){0};
+    }
+
+    // The boot code runs on the boot stack, which has room for a descriptor
+    thread_t* boot = SchedCurrent();
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+
+    ThreadSetup(boot, "idle0", 0, 0);
+    boot->state = THREAD_RUNNING;
+    rq->idle = rq->current = boot;
+}
+
+/**
+ * SchedCpuStart Implementation (See header include/sched.h file for description)
+*/
+int32_t SchedCpuStart(void)
+{
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+
+    if(CPU_Id() == 0)
+    {
+        if(TimerInit(SCHED_TICK_HZ, SchedTick) != E_OK)
+        {
+            return E_NO_MEMORY;
+        }
+    }
+    else
+    {
+        TimerCpuInit();
+    }
+
+    smp_wmb();
+    WRITE_ONCE(rq->online, TRUE);
+
+    asm volatile("cpsie i" ::: "memory");
+
+    return E_OK;
+}
+
+/**
+ * SchedIdle Implementation (See header include/sched.h file for description)
+*/
+void SchedIdle(void)
+{
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+
+    while(TRUE)
+    {
+        // Runs local or stolen work until there is none left
+        Schedule();
+
+        // Spare time clears free pages for PageAllocZeroed, one page per
+        // pass and abandoned as soon as a thread is ready. Nothing left to
+        // do: woken by SEV (wakeups, lock releases) and by interrupts
+        if((READ_ONCE(rq->ready) == 0) && !PageZeroIdle(&rq->ready))
+        {
+            wfe();
+        }
+    }
+}
+
+/**
+ * Schedule Implementation (See header include/sched.h file for description)
+*/
+void Schedule(void)
+{
+    uint32_t flags = CPU_IrqSave();
+    uint32_t start = pmu_get_cyclecount();
+    uint32_t cpu = CPU_Id();
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+    thread_t* prev = rq->current;
+    thread_t* next;
+
+    SpinLock(&rq->lock);
+
+    rq->needResched = FALSE;
+
+    if((prev->state == THREAD_RUNNING) && (prev != rq->idle))
+    {
+        prev->state = THREAD_READY;
+        RunQueueAdd(rq, prev);
+    }
+
+    if((next = RunQueueTake(rq)) == NULL)
+    {
+        if((next = RunQueueSteal(cpu)) != NULL)
+        {
+            rq->stats.steals++;
+        }
+        else
+        {
+            next = rq->idle;
+        }
+    }
+
+    if(prev->state == THREAD_DEAD)
+    {
+        rq->dead = prev;
+    }
+
+    next->state = THREAD_RUNNING;
+    next->cpu = cpu;
+    next->timeslice = SCHED_TIMESLICE;
+    rq->switchStart = start;
+
+    if(next != prev)
+    {
+        rq->current = next;
+        rq->stats.switches++;
+
+        TRACE(TRACE_SCHED_SWITCH, prev, next);
+
+        VfpSwitch(next);
+        ContextSwitch(&prev->context, &next->context);
+    }
+
+    SchedFinishSwitch();
+
+    CPU_IrqRestore(flags);
+}
+
+/**
+ * SchedHandoff Implementation (See header include/sched.h file for description)
+*/
+int32_t SchedHandoff(thread_t* next)
+{
+    uint32_t flags = CPU_IrqSave();
+    uint32_t start = pmu_get_cyclecount();
+    uint32_t cpu = CPU_Id();
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+    thread_t* prev;
+
+    if(next->cpu != cpu)
+    {
+        runqueue_t* remote = PERCPU_PTR(runQueue, next->cpu);
+        bool_t running;
+
+        if(next->affinity != THREAD_CPU_ANY)
+        {
+            CPU_IrqRestore(flags);
+            return E_BUSY;
+        }
+
+        // Once its queue lock is released after the switch, a thread that
+        // is not current there has its context saved and may migrate
+        SpinLock(&remote->lock);
+        running = (remote->current == next);
+        SpinUnlock(&remote->lock);
+
+        if(running)
+        {
+            CPU_IrqRestore(flags);
+            return E_BUSY;
+        }
+    }
+
+    SpinLock(&rq->lock);
+
+    prev = rq->current;
+
+    if(prev->state == THREAD_RUNNING)
+    {
+        // Woken before the switch: keep it ready
+        prev->state = THREAD_READY;
+        RunQueueAdd(rq, prev);
+    }
+
+    next->state = THREAD_RUNNING;
+    next->cpu = cpu;
+    next->timeslice = SCHED_TIMESLICE;
+    rq->current = next;
+    rq->switchStart = start;
+    rq->stats.switches++;
+    rq->stats.handoffs++;
+
+    TRACE(TRACE_SCHED_SWITCH, prev, next);
+
+    VfpSwitch(next);
+    ContextSwitch(&prev->context, &next->context);
+
+    SchedFinishSwitch();
+
+    CPU_IrqRestore(flags);
+
+    return E_OK;
+}
+
+/**
+ * SchedTick Implementation (See header include/sched.h file for description)
+*/
+void SchedTick(void)
+{
+    runqueue_t* rq = THIS_CPU_PTR(runQueue);
+    thread_t* current = rq->current;
+
+    if(current == rq->idle)
+    {
+        // The idle loop looks for work after the interrupt
+        return;
+    }
+
+    if(--current->timeslice == 0)
+    {
+        current->timeslice = SCHED_TIMESLICE;
+
+        // Round robin with the ready threads of the same or higher priority
+        if((READ_ONCE(rq->bitmap) >> current->priority) != 0)
+        {
+            rq->needResched = TRUE;
+        }
+    }
+}
+
+/**
+ * SchedIrqExit Implementation (See header include/sched.h file for description)
+*/
+void SchedIrqExit(void)
+{
+    if(THIS_CPU(runQueue).needResched && (SchedCurrent()->preemptCount == 0))
+    {
+        Schedule();
+    }
+}
+
+/**
+ * SchedStats Implementation (See header include/sched.h file for description)
+*/
+int32_t SchedStats(uint32_t cpu, sched_stats_t* stats)
+{
+    if(cpu >= NR_CPUS)
+    {
+        return E_INVAL;
+    }
+
+    runqueue_t* rq = PERCPU_PTR(runQueue, cpu);
+    uint32_t flags = SpinLockIrqSave(&rq->lock);
+
+    *stats = rq->stats;
+    stats->ready = rq->ready;
+
+    SpinUnlockIrqRestore(&rq->lock, flags);
+
+    return E_OK;
+}
+
+/**
+ * ThreadCreate Implementation (See header include/sched.h file for description)
+*/
+thread_t* ThreadCreate(const char* name, thread_entry_t entry, void* arg, uint32_t priority, uint32_t affinity)
+{
+    // A thread bound to a CPU that is not running would never be scheduled
+    if((priority < SCHED_PRIORITY_MIN) || (priority > SCHED_PRIORITY_MAX) ||
+       ((affinity != THREAD_CPU_ANY) && ((affinity >= NR_CPUS) || !READ_ONCE(PERCPU_PTR(runQueue, affinity)->online))))
+    {
+        return NULL;
+    }
+
+    paddr_t stack = PageAlloc(THREAD_STACK_ORDER);
+
+    if(stack == NULL)
+    {
+        return NULL;
+    }
+
+    thread_t* thread = (thread_t*)MMU_P2L(stack);
+
+    ThreadSetup(thread, name, priority, affinity);
+    thread->entry = entry;
+    thread->arg = arg;
+
+    // Released by SchedFinishSwitch when the thread first runs
+    thread->preemptCount = 1;
+
+    ThreadWake(thread);
+
+    return thread;
+}
+
+/**
+ * ThreadExit Implementation (See header include/sched.h file for description)
+*/
+void ThreadExit(void)
+{
+    VfpThreadExit(SchedCurrent());
+
+    SchedCurrent()->state = THREAD_DEAD;
+
+    Schedule();
+
+    while(TRUE);
+}
+
+/**
+ * ThreadYield Implementation (See header include/sched.h file for description)
+*/
+void ThreadYield(void)
+{
+    Schedule();
+}
+
+/**
+ * ThreadBlock Implementation (See header include/sched.h file for description)
+*/
+void ThreadBlock(void)
+{
+    WRITE_ONCE(SchedCurrent()->state, THREAD_BLOCKED);
+
+    Schedule();
+}
+
+/**
+ * ThreadWake Implementation (See header include/sched.h file for description)
+*/
+int32_t ThreadWake(thread_t* thread)
+{
+    uint32_t flags = CPU_IrqSave();
+    runqueue_t* rq;
+    uint32_t cpu;
+
+    // Lock the queue of the CPU the thread is on (it may be switching out)
+    while(TRUE)
+    {
+        cpu = READ_ONCE(thread->cpu);
+        rq = PERCPU_PTR(runQueue, cpu);
+
+        SpinLock(&rq->lock);
+
+        if(thread->cpu == cpu)
+        {
+            break;
+        }
+
+        SpinUnlock(&rq->lock);
+    }
+
+    if(thread->state != THREAD_BLOCKED)
+    {
+        SpinUnlock(&rq->lock);
+        CPU_IrqRestore(flags);
+        return E_BUSY;
+    }
+
+    if(rq->current == thread)
+    {
+        // Blocking but not switched out yet: it keeps running
+        thread->state = THREAD_RUNNING;
+        SpinUnlock(&rq->lock);
+        CPU_IrqRestore(flags);
+        return E_OK;
+    }
+
+    // Ready and in no queue until placed: other wakers see it is not blocked
+    thread->state = THREAD_READY;
+    SpinUnlock(&rq->lock);
+
+    cpu = SchedSelectCpu(thread);
+    rq = PERCPU_PTR(runQueue, cpu);
+
+    SpinLock(&rq->lock);
+
+    thread->cpu = cpu;
+    RunQueueAdd(rq, thread);
+
+    if(thread->priority > rq->current->priority)
+    {
+        rq->needResched = TRUE;
+    }
+
+    rq->stats.wakeups++;
+    if(cpu != CPU_Id())
+    {
+        rq->stats.remoteWakeups++;
+    }
+
+    bool_t preempt = (cpu == CPU_Id()) && rq->needResched;
+    bool_t kick = (cpu != CPU_Id()) && rq->needResched && (rq->current != rq->idle);
+
+    // The release SEV wakes the target CPU if it is idle, a busy one is
+    // interrupted so it does not wait for the next tick
+    SpinUnlock(&rq->lock);
+
+    TRACE(TRACE_SCHED_WAKE, thread, cpu);
+
+    if(kick)
+    {
+        IpiResched(cpu);
+    }
+
+    CPU_IrqRestore(flags);
+
+    if(preempt && (SchedCurrent()->preemptCount == 0))
+    {
+        Schedule();
+    }
+
+    return E_OK;
+}
+
+/**
+ * SmpBoot Implementation (See header include/sched.h file for description)
+*/
+uint32_t SmpBoot(void)
+{
+    // Set in the linker script
+    extern uint8_t _start[];
+
+    uint32_t cpu, online = 1;
+    uint32_t cpus = PlatformGet()->cpus;
+
+    // Cores of the device tree, up to the cores the kernel is built for
+    if((cpus == 0) || (cpus > NR_CPUS))
+    {
+        cpus = NR_CPUS;
+    }
+
+    for(cpu = 1; cpu < cpus; ++cpu)
+    {
+        runqueue_t* rq = PERCPU_PTR(runQueue, cpu);
+        paddr_t stack = PageAlloc(THREAD_STACK_ORDER);
+        uint32_t timeout;
+
+        if(stack == NULL)
+        {
+            break;
+        }
+
+        thread_t* idle = (thread_t*)MMU_P2L(stack);
+
+        ThreadSetup(idle, "idle", 0, cpu);
+        idle->state = THREAD_RUNNING;
+        rq->idle = rq->current = idle;
+
+        // The pen is read with the caches off
+        secondary_pen[1] = (uint32_t)idle + THREAD_STACK_SIZE;
+        secondary_pen[0] = cpu;
+        v7_flush_dcache_range((vaddr_t)secondary_pen, (vaddr_t)&secondary_pen[2]);
+        sev();
+
+        if(BoardCpuStart(cpu, MMU_L2P((vaddr_t)_start)) == E_OK)
+        {
+            for(timeout = 0; (timeout < SMP_BOOT_TIMEOUT) && !READ_ONCE(rq->online); ++timeout)
+            {
+
+            }
+        }
+
+        if(READ_ONCE(rq->online))
+        {
+            online++;
+            continue;
+        }
+
+        // Closed first: a late core must not pick up the stack released here
+        secondary_pen[0] = PEN_CLOSED;
+        v7_flush_dcache_range((vaddr_t)secondary_pen, (vaddr_t)&secondary_pen[2]);
+
+        rq->idle = rq->current = NULL;
+        PageFree(stack, THREAD_STACK_ORDER);
+    }
+
+    secondary_pen[0] = PEN_CLOSED;
+    v7_flush_dcache_range((vaddr_t)secondary_pen, (vaddr_t)&secondary_pen[2]);
+
+    return online;
+}
+
+/**
+ * SecondaryMain Implementation (See header include/sched.h file for description)
+*/
+void SecondaryMain(void)
+{
+    PercpuCpuInit();
+
+    // Cycle counter running since cpu_boot (boot.S)
+    pmu_int_perfcounters(0, 0);
+
+    IrqCpuInit();
+    IpiCpuInit();
+    SchedCpuStart();
+
+    SchedIdle();
+}
@@ -0,0 +1,667 @@
+/**
+ * @file        space.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Address Spaces (user page tables and ASIDs)
+ *
+ *              Kernel threads keep the user page table loaded when they are
+ *              switched in (see ContextSwitch). Threads leaving a space load
+ *              the kernel tables again, a destroyed space is unloaded from
+ *              every CPU (IPI) and its ASID is invalidated on all cores both
+ *              when it is released and when it is reused.
+ *
+ *              Region pages are mapped one 4Kb page at a time by the fault
+ *              handler. A page mapped read-only in a writable region is
+ *              shared with another space: the page frame counts the extra
+ *              users (PageGet) and the last one takes it over on a write
+ *              instead of copying it.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <space.h>
+#include <sched.h>
+#include <slab.h>
+#include <spinlock.h>
+#include <ipi.h>
+#include <tlb.h>
+#include <page.h>
+#include <string.h>
+#include <misc.h>
+
+
+/* Private constants -------------------------------------- */
+
+#define ASID_WORDS          (SPACE_ASIDS / 32)
+
+// Pages unmapped at once by SpaceRelease before they are released
+#define RELEASE_BATCH       (64)
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+#define ASID_WORD(a)        ((a) >> 5)
+#define ASID_MASK(a)        (1U << ((a) & 0x1F))
+
+
+/* Private variables -------------------------------------- */
+
+static slab_cache_t* spaceCache;
+
+static spinlock_t asidLock = SPINLOCK_INIT("asid");
+
+// Bit n set: ASID n in use (ASID 0 is reserved)
+static uint32_t asidMap[ASID_WORDS] = {1};
+
+// Next ASID tried: ASIDs are handed out round robin so a released ASID
+// is reused as late as possible
+static uint32_t asidNext = 1;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Allocates an ASID
+ * @param   None
+ * @retval  ASID, 0 if all are in use
+ */
+static uint32_t AsidAlloc(void);
+
+/**
+ * @brief   Releases an ASID
+ * @param   asid - ASID
+ * @retval  No return
+ */
+static void AsidFree(uint32_t asid);
+
+/**
+ * @brief   Loads the kernel tables (boot TTBR0) with the reserved ASID on
+ *          the running CPU
+ * @param   None
+ * @retval  No return
+ */
+static void SpaceLoadKernel(void);
+
+/**
+ * @brief   Loads the kernel tables on the running CPU if it has a space
+ *          loaded (IPI call function)
+ * @param   arg - Address space
+ * @retval  No return
+ */
+static void SpaceUnload(void* arg);
+
+/**
+ * @brief   Finds the region holding an address. The space must be locked
+ * @param   space - Address space
+ *          vaddr - Address
+ * @retval  Region, NULL if vaddr is not in a region
+ */
+static space_region_t* SpaceRegionFind(space_t* space, vaddr_t vaddr);
+
+/**
+ * @brief   Maps a 4Kb page of a region. The space must be locked. Read-only
+ *          pages are read-only for the kernel too, so kernel writes to a
+ *          shared page fault and copy it as well
+ * @param   space - Address space
+ *          vaddr - Page address
+ *          paddr - Physical page
+ *          flags - Region flags
+ *          write - Map writable (SPACE_WRITE regions only)
+ * @retval  No return
+ */
+static void SpaceMapPage(space_t* space, vaddr_t vaddr, paddr_t paddr, uint32_t flags, bool_t write);
+
+/**
+ * @brief   Finds the region holding a whole range. The space must be locked
+ * @param   space - Address space
+ *          vaddr - Start address
+ *          size - Size of the range
+ * @retval  Region, NULL if the range is not in a single region
+ */
+static space_region_t* SpaceRegionRange(space_t* space, vaddr_t vaddr, size_t size);
+
+/**
+ * @brief   Unmaps and releases the populated pages of a region. The space
+ *          must be locked
+ * @param   space - Address space
+ *          region - Region
+ * @retval  No return
+ */
+static void SpaceRegionFree(space_t* space, space_region_t* region);
+
+
+/* Private functions -------------------------------------- */
+
+uint32_t AsidAlloc(void)
+{
+    uint32_t i, asid = 0;
+
+    SpinLock(&asidLock);
+
+    for(i = 0; i < (SPACE_ASIDS - 1); ++i)
+    {
+        uint32_t candidate = asidNext;
+
+        asidNext = (asidNext == (SPACE_ASIDS - 1)) ? 1 : (asidNext + 1);
+
+        if(!(asidMap[ASID_WORD(candidate)] & ASID_MASK(candidate)))
+        {
+            asidMap[ASID_WORD(candidate)] |= ASID_MASK(candidate);
+            asid = candidate;
+            break;
+        }
+    }
+
+    SpinUnlock(&asidLock);
+
+    return asid;
+}
+
+void AsidFree(uint32_t asid)
+{
+    SpinLock(&asidLock);
+    asidMap[ASID_WORD(asid)] &= ~ASID_MASK(asid);
+    SpinUnlock(&asidLock);
+}
+
+void SpaceLoadKernel(void)
+{
+    asm volatile("mcr   p15, 0, %[_zero], c13, c0, 1\n\t"
+                 "isb\n\t"
+                 "mcr   p15, 0, %[_ttbr], c2, c0, 0\n\t"
+                 "isb"
+                 :: [_zero] "r" (0), [_ttbr] "r" (MMU_UserTTBR(MMU_P2L(MMU_KernelPGT()))) : "memory");
+}
+
+void SpaceUnload(void* arg)
+{
+    space_t* space = (space_t*)arg;
+
+    if(MMU_UserPGT() == (pgt_t)MMU_L2P((vaddr_t)space->pgt))
+    {
+        SpaceLoadKernel();
+    }
+}
+
+space_region_t* SpaceRegionFind(space_t* space, vaddr_t vaddr)
+{
+    uint32_t i;
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        space_region_t* region = &space->regions[i];
+
+        if((region->size != 0) && ((ulong_t)vaddr >= (ulong_t)region->start) &&
+           (((ulong_t)vaddr - (ulong_t)region->start) < region->size))
+        {
+            return region;
+        }
+    }
+
+    return NULL;
+}
+
+space_region_t* SpaceRegionRange(space_t* space, vaddr_t vaddr, size_t size)
+{
+    space_region_t* region = SpaceRegionFind(space, vaddr);
+
+    if((region == NULL) || (size > (((ulong_t)region->start + region->size) - (ulong_t)vaddr)))
+    {
+        return NULL;
+    }
+
+    return region;
+}
+
+void SpaceMapPage(space_t* space, vaddr_t vaddr, paddr_t paddr, uint32_t flags, bool_t write)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, write ? APOLICY_RWRW : APOLICY_RORO, TRUE, (flags & SPACE_EXEC) ? TRUE : FALSE, FALSE};
+    pbv_t page = {(ptr_t)paddr, PAGE_SIZE};
+
+    MMU_MapPages(space->pgt, vaddr, &page, 1, &memCfg);
+}
+
+void SpaceRegionFree(space_t* space, space_region_t* region)
+{
+    paddr_t pages[RELEASE_BATCH];
+    ulong_t vaddr = (ulong_t)region->start;
+    ulong_t end = vaddr + region->size;
+
+    while(vaddr < end)
+    {
+        ulong_t chunk = ((end - vaddr) < (RELEASE_BATCH * PAGE_SIZE)) ? (end - vaddr) : (RELEASE_BATCH * PAGE_SIZE);
+        uint32_t i, count = 0;
+
+        for(i = 0; i < (chunk / PAGE_SIZE); ++i)
+        {
+            paddr_t paddr = MMU_V2P(space->pgt, (vaddr_t)(vaddr + (i * PAGE_SIZE)));
+
+            if(paddr != NULL)
+            {
+                pages[count++] = paddr;
+            }
+        }
+
+        // No CPU may reach the pages once they are released
+        if(count != 0)
+        {
+            MMU_UnmapPages(space->pgt, (vaddr_t)vaddr, chunk);
+
+            for(i = 0; i < count; ++i)
+            {
+                PagePut(pages[i]);
+            }
+        }
+
+        vaddr += chunk;
+    }
+
+    region->size = 0;
+}
+
+/**
+ * SpaceInit Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceInit(void)
+{
+    spaceCache = SlabCacheCreate("space", sizeof(space_t), sizeof(ulong_t), NULL);
+
+    return (spaceCache == NULL) ? E_NO_MEMORY : E_OK;
+}
+
+/**
+ * SpaceCreate Implementation (See header include/space.h file for description)
+*/
+space_t* SpaceCreate(void)
+{
+    space_t* space = (space_t*)SlabAlloc(spaceCache);
+    uint32_t i;
+
+    if(space == NULL)
+    {
+        return NULL;
+    }
+
+    if((space->asid = AsidAlloc()) == 0)
+    {
+        SlabFree(spaceCache, space);
+        return NULL;
+    }
+
+    if((space->pgt = MMU_AllocPGT()) == NULL)
+    {
+        AsidFree(space->asid);
+        SlabFree(spaceCache, space);
+        return NULL;
+    }
+
+    space->ttbr = MMU_UserTTBR(space->pgt);
+    SpinLockInit(&space->lock, "space");
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        space->regions[i].size = 0;
+    }
+
+    // Entries left by a CPU that still had the previous owner loaded
+    TlbInvalidateASID(space->asid);
+
+    return space;
+}
+
+/**
+ * SpaceDestroy Implementation (See header include/space.h file for description)
+*/
+void SpaceDestroy(space_t* space)
+{
+    uint32_t i;
+
+    // Kernel threads may still have it loaded on any CPU
+    IpiCall(IpiOnlineMask(), SpaceUnload, space);
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        if(space->regions[i].size != 0)
+        {
+            SpaceRegionFree(space, &space->regions[i]);
+        }
+    }
+
+    MMU_InvalidatePGT(space->pgt);
+    TlbInvalidateASID(space->asid);
+    MMU_FreePGT(space->pgt);
+
+    AsidFree(space->asid);
+    SlabFree(spaceCache, space);
+}
+
+/**
+ * SpaceEnter Implementation (See header include/space.h file for description)
+*/
+void SpaceEnter(space_t* space)
+{
+    thread_t* thread = SchedCurrent();
+    uint32_t flags = CPU_IrqSave();
+
+    thread->space = space;
+
+    if(space == NULL)
+    {
+        thread->context.ttbr0 = 0;
+        thread->context.asid = 0;
+
+        SpaceLoadKernel();
+    }
+    else
+    {
+        thread->context.ttbr0 = space->ttbr;
+        thread->context.asid = space->asid;
+
+        MMU_SetUserPGT(space->pgt, space->asid);
+    }
+
+    CPU_IrqRestore(flags);
+}
+
+/**
+ * SpaceReserve Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceReserve(space_t* space, vaddr_t vaddr, size_t size, uint32_t flags)
+{
+    ulong_t start = (ulong_t)vaddr;
+    space_region_t* free = NULL;
+    uint32_t i;
+
+    if((size == 0) || ((start | size) & (PAGE_SIZE - 1)) ||
+       (start >= USER_SPACE_END) || (size > (USER_SPACE_END - start)))
+    {
+        return E_INVAL;
+    }
+
+    SpinLock(&space->lock);
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        space_region_t* region = &space->regions[i];
+
+        if(region->size == 0)
+        {
+            free = (free == NULL) ? region : free;
+        }
+        else if((start < ((ulong_t)region->start + region->size)) && ((ulong_t)region->start < (start + size)))
+        {
+            SpinUnlock(&space->lock);
+            return E_INVAL;
+        }
+    }
+
+    if(free != NULL)
+    {
+        free->start = vaddr;
+        free->size = size;
+        free->flags = flags;
+    }
+
+    SpinUnlock(&space->lock);
+
+    return (free == NULL) ? E_NO_RES : E_OK;
+}
+
+/**
+ * SpaceRelease Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceRelease(space_t* space, vaddr_t vaddr)
+{
+    space_region_t* region;
+
+    SpinLock(&space->lock);
+
+    region = SpaceRegionFind(space, vaddr);
+
+    if((region == NULL) || (region->start != vaddr))
+    {
+        SpinUnlock(&space->lock);
+        return E_INVAL;
+    }
+
+    SpaceRegionFree(space, region);
+
+    SpinUnlock(&space->lock);
+
+    return E_OK;
+}
+
+/**
+ * SpaceShare Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceShare(space_t* space, vaddr_t vaddr, paddr_t paddr, size_t size)
+{
+    space_region_t* region;
+    ulong_t offset;
+
+    if(((ulong_t)vaddr | (ulong_t)paddr | size) & (PAGE_SIZE - 1))
+    {
+        return E_INVAL;
+    }
+
+    SpinLock(&space->lock);
+
+    if((region = SpaceRegionRange(space, vaddr, size)) == NULL)
+    {
+        SpinUnlock(&space->lock);
+        return E_INVAL;
+    }
+
+    for(offset = 0; offset < size; offset += PAGE_SIZE)
+    {
+        paddr_t page = (paddr_t)((ulong_t)paddr + offset);
+
+        PageGet(page);
+        SpaceMapPage(space, (vaddr_t)((ulong_t)vaddr + offset), page, region->flags, FALSE);
+    }
+
+    SpinUnlock(&space->lock);
+
+    return E_OK;
+}
+
+/**
+ * SpaceCopyIn Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceCopyIn(space_t* space, vaddr_t vaddr, const void* src, size_t size)
+{
+    space_region_t* region;
+    ulong_t addr = (ulong_t)vaddr;
+    ulong_t end = addr + size;
+    int32_t status = E_OK;
+    bool_t exec;
+
+    SpinLock(&space->lock);
+
+    if((region = SpaceRegionRange(space, vaddr, size)) == NULL)
+    {
+        SpinUnlock(&space->lock);
+        return E_INVAL;
+    }
+
+    while(addr < end)
+    {
+        ulong_t page = ROUND_DOWN(addr, PAGE_SIZE);
+        ulong_t chunk = (((page + PAGE_SIZE) < end) ? (page + PAGE_SIZE) : end) - addr;
+        paddr_t paddr = MMU_V2P(space->pgt, (vaddr_t)page);
+
+        if(paddr == NULL)
+        {
+            // Partly copied pages keep zeros around the data
+            paddr = (chunk != PAGE_SIZE) ? PageAllocZeroed() : PageAlloc(0);
+
+            if(paddr == NULL)
+            {
+                status = E_NO_MEMORY;
+                break;
+            }
+
+            SpaceMapPage(space, (vaddr_t)page, paddr, region->flags, (region->flags & SPACE_WRITE) ? TRUE : FALSE);
+        }
+        else if(PageShares(paddr) != 0)
+        {
+            status = E_BUSY;
+            break;
+        }
+
+        memcpy((void*)((ulong_t)MMU_P2L(paddr) + (addr - page)), src, chunk);
+
+        src = (const void*)((ulong_t)src + chunk);
+        addr += chunk;
+    }
+
+    exec = (region->flags & SPACE_EXEC) ? TRUE : FALSE;
+
+    SpinUnlock(&space->lock);
+
+    // Code written through the kernel mapping
+    if(exec)
+    {
+        TlbInvalidateICache();
+    }
+
+    return status;
+}
+
+/**
+ * SpaceClone Implementation (See header include/space.h file for description)
+*/
+space_t* SpaceClone(space_t* space)
+{
+    space_t* clone = SpaceCreate();
+    uint32_t i;
+
+    if(clone == NULL)
+    {
+        return NULL;
+    }
+
+    SpinLock(&space->lock);
+
+    // The parent loses write access: one shootdown for all its pages
+    TlbBatchBegin();
+
+    for(i = 0; i < SPACE_REGIONS; ++i)
+    {
+        space_region_t* region = &space->regions[i];
+        ulong_t vaddr;
+
+        clone->regions[i] = *region;
+
+        if(region->size == 0)
+        {
+            continue;
+        }
+
+        for(vaddr = (ulong_t)region->start; vaddr < ((ulong_t)region->start + region->size); vaddr += PAGE_SIZE)
+        {
+            paddr_t paddr = MMU_V2P(space->pgt, (vaddr_t)vaddr);
+
+            if(paddr == NULL)
+            {
+                continue;
+            }
+
+            PageGet(paddr);
+            SpaceMapPage(clone, (vaddr_t)vaddr, paddr, region->flags, FALSE);
+
+            if(region->flags & SPACE_WRITE)
+            {
+                MMU_UnmapPages(space->pgt, (vaddr_t)vaddr, PAGE_SIZE);
+                SpaceMapPage(space, (vaddr_t)vaddr, paddr, region->flags, FALSE);
+            }
+        }
+    }
+
+    TlbBatchEnd();
+
+    SpinUnlock(&space->lock);
+
+    return clone;
+}
+
+/**
+ * SpaceFault Implementation (See header include/space.h file for description)
+*/
+int32_t SpaceFault(space_t* space, vaddr_t vaddr, bool_t write, uint32_t* resolution)
+{
+    vaddr_t page = (vaddr_t)ROUND_DOWN((ulong_t)vaddr, PAGE_SIZE);
+    space_region_t* region;
+    paddr_t old, new;
+    bool_t exec;
+
+    SpinLock(&space->lock);
+
+    region = SpaceRegionFind(space, page);
+
+    if((region == NULL) || (write && !(region->flags & SPACE_WRITE)))
+    {
+        SpinUnlock(&space->lock);
+        return E_FAULT;
+    }
+
+    old = MMU_V2P(space->pgt, page);
+
+    if((old == NULL) || write)
+    {
+        if((old != NULL) && (PageShares(old) == 0))
+        {
+            // Last user of a shared page: write access, no copy
+            new = old;
+            *resolution = SPACE_FAULT_REUSE;
+        }
+        else if((new = ((old == NULL) ? PageAllocZeroed() : PageAlloc(0))) == NULL)
+        {
+            SpinUnlock(&space->lock);
+            return E_NO_MEMORY;
+        }
+        else if(old == NULL)
+        {
+            *resolution = SPACE_FAULT_ZERO;
+        }
+        else
+        {
+            memcpy((void*)MMU_P2L(new), (void*)MMU_P2L(old), PAGE_SIZE);
+            *resolution = SPACE_FAULT_COPY;
+        }
+
+        // Break before make: the read-only entry is gone from every TLB
+        // before the new one is written
+        if(old != NULL)
+        {
+            MMU_UnmapPages(space->pgt, page, PAGE_SIZE);
+        }
+
+        SpaceMapPage(space, page, new, region->flags, (region->flags & SPACE_WRITE) ? TRUE : FALSE);
+
+        if(*resolution == SPACE_FAULT_COPY)
+        {
+            PagePut(old);
+        }
+    }
+    else
+    {
+        // Mapped by another thread of the space since the fault
+        *resolution = SPACE_FAULT_NONE;
+    }
+
+    exec = (region->flags & SPACE_EXEC) ? TRUE : FALSE;
+
+    SpinUnlock(&space->lock);
+
+    if(exec && (*resolution != SPACE_FAULT_NONE))
+    {
+        TlbInvalidateICache();
+    }
+
+    return E_OK;
+}
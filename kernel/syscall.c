@@ -0,0 +1,117 @@
+/**
+ * @file        syscall.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       System Call Table
+ *
+ *              svc_entry (entry.S) loads the handler from syscallTable with
+ *              the call number and calls it with r0-r2 untouched, so there
+ *              is no decoding in between. The IPC calls take the message
+ *              straight from the saved r1-r4 and leave the reply there, so
+ *              it returns in registers.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <syscall.h>
+#include <ipc.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+// Message registers in the frame (r1-r4)
+#define FRAME_MSG(f)        ((ipc_msg_t*)&(f)->r[1])
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   System call handlers (see the Sys* calls in include/syscall.h)
+ * @param   ep - Endpoint (r0)
+ *          a1, a2 - Not used (message in the frame)
+ *          frame - Registers of the caller
+ * @retval  Result returned in r0
+ */
+static int32_t SyscallIpcSend(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+static int32_t SyscallIpcReceive(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+static int32_t SyscallIpcCall(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+static int32_t SyscallIpcReplyWait(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+static int32_t SyscallNull(uint32_t a0, uint32_t a1, uint32_t a2, syscall_frame_t* frame);
+
+
+/* Private variables -------------------------------------- */
+
+// Indexed by the call number in svc_entry (not static: entry.S)
+const syscall_t syscallTable[SYS_COUNT] =
+{
+    [SYS_IPC_SEND]          = SyscallIpcSend,
+    [SYS_IPC_RECEIVE]       = SyscallIpcReceive,
+    [SYS_IPC_CALL]          = SyscallIpcCall,
+    [SYS_IPC_REPLY_WAIT]    = SyscallIpcReplyWait,
+    [SYS_NULL]              = SyscallNull,
+};
+
+
+/* Private functions -------------------------------------- */
+
+int32_t SyscallIpcSend(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a1;
+    (void)a2;
+
+    return IpcSend(ep, FRAME_MSG(frame));
+}
+
+int32_t SyscallIpcReceive(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a1;
+    (void)a2;
+
+    return IpcReceive(ep, FRAME_MSG(frame));
+}
+
+int32_t SyscallIpcCall(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a1;
+    (void)a2;
+
+    return IpcCall(ep, FRAME_MSG(frame));
+}
+
+int32_t SyscallIpcReplyWait(uint32_t ep, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a1;
+    (void)a2;
+
+    return IpcReplyWait(ep, FRAME_MSG(frame));
+}
+
+int32_t SyscallNull(uint32_t a0, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a0;
+    (void)a1;
+    (void)a2;
+    (void)frame;
+
+    return E_OK;
+}
+
+/**
+ * SyscallInvalid Implementation (See header include/syscall.h file for description)
+*/
+int32_t SyscallInvalid(uint32_t a0, uint32_t a1, uint32_t a2, syscall_frame_t* frame)
+{
+    (void)a0;
+    (void)a1;
+    (void)a2;
+    (void)frame;
+
+    return E_INVAL;
+}
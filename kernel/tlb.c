@@ -0,0 +1,345 @@
+/**
+ * @file        tlb.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       TLB and instruction cache shootdown
+ *
+ *              The batch of a CPU holds the lowest and highest page
+ *              invalidated since the outermost TlbBatchBegin plus flags for
+ *              the invalidations that have no range (ASID, instruction
+ *              cache). The other CPUs invalidate the whole range, or their
+ *              whole TLB when the range is large, from the call IPI.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <tlb.h>
+#include <ipi.h>
+#include <mmu.h>
+#include <cpu.h>
+#include <sched.h>
+#include <atomic.h>
+#include <percpu.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Range flags
+#define TLB_RANGE_ALL       (1 << 0)    // Flush the whole TLB
+#define TLB_RANGE_ICACHE    (1 << 1)    // Invalidate the instruction cache
+
+// ID_MMFR3 maintenance broadcast field
+#define MMFR3_BCAST_SHIFT   (12)
+#define MMFR3_BCAST_CACHE   (1)         // Cache and branch predictor only
+#define MMFR3_BCAST_ALL     (2)         // TLB as well
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    ulong_t  start;                     // start == end: no pages
+    ulong_t  end;
+    uint32_t flags;
+}tlb_range_t;
+
+typedef struct
+{
+    uint32_t    depth;
+    tlb_range_t range;
+    tlb_stats_t stats;
+}tlb_batch_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static DEFINE_PERCPU(tlb_batch_t, tlbBatch);
+
+// Broadcast assumed until TlbInit reads the core features
+static bool_t tlbBroadcastHw = TRUE;
+static bool_t icacheBroadcastHw = TRUE;
+static bool_t tlbBroadcast = TRUE;
+static bool_t icacheBroadcast = TRUE;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Adds a page to the batch range
+ * @param   batch - Batch of the running CPU
+ *          vaddr - Page address
+ * @retval  No return
+ */
+static void TlbBatchAdd(tlb_batch_t* batch, ulong_t vaddr);
+
+/**
+ * @brief   Sends the pending range to the other CPUs and empties it
+ * @param   batch - Batch of the running CPU
+ * @retval  No return
+ */
+static void TlbShootdown(tlb_batch_t* batch);
+
+/**
+ * @brief   Invalidates a range on the running CPU (IPI call function)
+ * @param   arg - Range
+ * @retval  No return
+ */
+static void TlbShootdownLocal(void* arg);
+
+
+/* Private functions -------------------------------------- */
+
+void TlbBatchAdd(tlb_batch_t* batch, ulong_t vaddr)
+{
+    tlb_range_t* range = &batch->range;
+
+    if(range->start == range->end)
+    {
+        range->start = vaddr;
+        range->end = vaddr + PAGE_SIZE;
+    }
+    else if(vaddr < range->start)
+    {
+        range->start = vaddr;
+    }
+    else if(vaddr >= range->end)
+    {
+        range->end = vaddr + PAGE_SIZE;
+    }
+
+    batch->stats.pages++;
+}
+
+void TlbShootdown(tlb_batch_t* batch)
+{
+    tlb_range_t range = batch->range;
+
+    if((range.start == range.end) && (range.flags == 0))
+    {
+        return;
+    }
+
+    batch->range = (tlb_range_t){0};
+
+    // Table updates and the local invalidations complete first
+    asm volatile("dsb   ish" ::: "memory");
+
+    batch->stats.ipis += IpiCall(IpiOnlineMask() & ~(1 << CPU_Id()), TlbShootdownLocal, &range);
+    batch->stats.shootdowns++;
+}
+
+void TlbShootdownLocal(void* arg)
+{
+    tlb_range_t* range = (tlb_range_t*)arg;
+    ulong_t vaddr;
+
+    if((range->flags & TLB_RANGE_ALL) || ((range->end - range->start) > (TLB_FLUSH_ALL_PAGES * PAGE_SIZE)))
+    {
+        // TLBIALL
+        asm volatile("mcr   p15, 0, %[_zero], c8, c7, 0" :: [_zero] "r" (0) : "memory");
+    }
+    else
+    {
+        for(vaddr = range->start; vaddr < range->end; vaddr += PAGE_SIZE)
+        {
+            // TLBIMVAA
+            asm volatile("mcr   p15, 0, %[_vaddr], c8, c7, 3" :: [_vaddr] "r" (vaddr) : "memory");
+        }
+    }
+
+    if(range->flags & TLB_RANGE_ICACHE)
+    {
+        // ICIALLU, BPIALL
+        asm volatile("mcr   p15, 0, %[_zero], c7, c5, 0\n\t"
+                     "mcr   p15, 0, %[_zero], c7, c5, 6"
+                     :: [_zero] "r" (0) : "memory");
+    }
+
+    asm volatile("dsb\n\tisb" ::: "memory");
+}
+
+/**
+ * TlbInit Implementation (See header include/tlb.h file for description)
+*/
+void TlbInit(void)
+{
+    uint32_t mmfr3;
+
+    asm volatile("mrc   p15, 0, %[_mmfr3], c0, c1, 7" : [_mmfr3] "=r" (mmfr3));
+
+    mmfr3 = (mmfr3 >> MMFR3_BCAST_SHIFT) & 0xF;
+
+    tlbBroadcastHw = (mmfr3 >= MMFR3_BCAST_ALL);
+    icacheBroadcastHw = (mmfr3 >= MMFR3_BCAST_CACHE);
+
+    tlbBroadcast = tlbBroadcastHw;
+    icacheBroadcast = icacheBroadcastHw;
+}
+
+/**
+ * TlbBatchBegin Implementation (See header include/tlb.h file for description)
+*/
+void TlbBatchBegin(void)
+{
+    PreemptDisable();
+
+    THIS_CPU(tlbBatch).depth++;
+}
+
+/**
+ * TlbBatchEnd Implementation (See header include/tlb.h file for description)
+*/
+void TlbBatchEnd(void)
+{
+    tlb_batch_t* batch = THIS_CPU_PTR(tlbBatch);
+
+    if(--batch->depth == 0)
+    {
+        TlbShootdown(batch);
+    }
+
+    PreemptEnable();
+}
+
+/**
+ * TlbSync Implementation (See header include/tlb.h file for description)
+*/
+void TlbSync(void)
+{
+    PreemptDisable();
+
+    TlbShootdown(THIS_CPU_PTR(tlbBatch));
+
+    PreemptEnable();
+}
+
+/**
+ * TlbInvalidatePage Implementation (See header include/tlb.h file for description)
+*/
+void TlbInvalidatePage(ulong_t vaddr)
+{
+    TlbBatchBegin();
+
+    tlb_batch_t* batch = THIS_CPU_PTR(tlbBatch);
+
+    vaddr &= ~(PAGE_SIZE - 1);
+
+    // Page table update must be visible before the TLB maintenance
+    asm volatile("dsb   ishst" ::: "memory");
+
+    if(READ_ONCE(tlbBroadcast))
+    {
+        // TLBIMVAAIS: this address on all ASIDs and all cores
+        asm volatile("mcr   p15, 0, %[_vaddr], c8, c3, 3" :: [_vaddr] "r" (vaddr) : "memory");
+        batch->stats.broadcasts++;
+    }
+    else
+    {
+        // TLBIMVAA: this core, the others at the end of the batch
+        asm volatile("mcr   p15, 0, %[_vaddr], c8, c7, 3" :: [_vaddr] "r" (vaddr) : "memory");
+        TlbBatchAdd(batch, vaddr);
+    }
+
+    TlbBatchEnd();
+}
+
+/**
+ * TlbInvalidateASID Implementation (See header include/tlb.h file for description)
+*/
+void TlbInvalidateASID(uint32_t asid)
+{
+    TlbBatchBegin();
+
+    tlb_batch_t* batch = THIS_CPU_PTR(tlbBatch);
+
+    if(READ_ONCE(tlbBroadcast))
+    {
+        MMU_InvalidateASID(asid);
+        batch->stats.broadcasts++;
+    }
+    else
+    {
+        // TLBIASID, the other cores flush their whole TLB
+        asm volatile("dsb   ishst\n\t"
+                     "mcr   p15, 0, %[_asid], c8, c7, 2\n\t"
+                     "dsb\n\t"
+                     "isb"
+                     :: [_asid] "r" (asid & 0xFF) : "memory");
+        batch->range.flags |= TLB_RANGE_ALL;
+    }
+
+    TlbBatchEnd();
+}
+
+/**
+ * TlbInvalidateICache Implementation (See header include/tlb.h file for description)
+*/
+void TlbInvalidateICache(void)
+{
+    TlbBatchBegin();
+
+    tlb_batch_t* batch = THIS_CPU_PTR(tlbBatch);
+
+    if(READ_ONCE(icacheBroadcast))
+    {
+        // ICIALLUIS, BPIALLIS
+        asm volatile("mcr   p15, 0, %[_zero], c7, c1, 0\n\t"
+                     "mcr   p15, 0, %[_zero], c7, c1, 6\n\t"
+                     "dsb   ish\n\t"
+                     "isb"
+                     :: [_zero] "r" (0) : "memory");
+        batch->stats.broadcasts++;
+    }
+    else
+    {
+        // ICIALLU, BPIALL
+        asm volatile("mcr   p15, 0, %[_zero], c7, c5, 0\n\t"
+                     "mcr   p15, 0, %[_zero], c7, c5, 6\n\t"
+                     "dsb\n\t"
+                     "isb"
+                     :: [_zero] "r" (0) : "memory");
+        batch->range.flags |= TLB_RANGE_ICACHE;
+    }
+
+    TlbBatchEnd();
+}
+
+/**
+ * TlbSetBroadcast Implementation (See header include/tlb.h file for description)
+*/
+int32_t TlbSetBroadcast(bool_t enable)
+{
+    if(enable && !tlbBroadcastHw)
+    {
+        return E_INVAL;
+    }
+
+    WRITE_ONCE(tlbBroadcast, enable);
+    WRITE_ONCE(icacheBroadcast, enable && icacheBroadcastHw);
+
+    return E_OK;
+}
+
+/**
+ * TlbStats Implementation (See header include/tlb.h file for description)
+*/
+void TlbStats(tlb_stats_t* stats)
+{
+    uint32_t cpu;
+
+    *stats = (tlb_stats_t){0};
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        tlb_stats_t* cpuStats = &PERCPU_PTR(tlbBatch, cpu)->stats;
+
+        stats->broadcasts += cpuStats->broadcasts;
+        stats->pages += cpuStats->pages;
+        stats->shootdowns += cpuStats->shootdowns;
+        stats->ipis += cpuStats->ipis;
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file        trace.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Event Tracing (per-CPU rings)
+ *
+ *              Each ring is written by its CPU only, with IRQs masked for
+ *              the few stores of a record, so no lock or atomic operation
+ *              is needed. The head counts every record written: the ring
+ *              holds the last TRACE_RECORDS of them. Timestamps are the
+ *              cycle counter of each CPU, not synchronized between CPUs.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <trace.h>
+#include <cpu.h>
+#include <percpu.h>
+#include <pmu.h>
+#include <serial.h>
+
+#ifdef USE_TRACE
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    uint32_t       head;                // Records written
+    trace_record_t records[TRACE_RECORDS];
+}__attribute__((aligned(CACHE_LINE_SIZE))) trace_ring_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static DEFINE_PERCPU(trace_ring_t, traceRing);
+
+// Set while the rings are printed
+static volatile bool_t tracePaused;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Prints a value as 8 hexadecimal digits, preceded by a space
+ * @param   value - Value
+ * @retval  No return
+ */
+static void TracePrintHex(uint32_t value);
+
+
+/* Private functions -------------------------------------- */
+
+void TracePrintHex(uint32_t value)
+{
+    static const char digits[] = "0123456789abcdef";
+    char str[10];
+    int32_t i;
+
+    str[0] = ' ';
+    str[9] = '\0';
+
+    for(i = 8; i > 0; --i)
+    {
+        str[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+
+    puts(str);
+}
+
+/**
+ * TraceEvent Implementation (See header include/trace.h file for description)
+*/
+void TraceEvent(uint32_t event, uint32_t a, uint32_t b)
+{
+    uint32_t flags = CPU_IrqSave();
+    uint32_t cpu = CPU_Id();
+    trace_ring_t* ring = THIS_CPU_PTR(traceRing);
+    trace_record_t* record;
+
+    if(!tracePaused)
+    {
+        record = &ring->records[ring->head & (TRACE_RECORDS - 1)];
+        record->timestamp = pmu_get_cyclecount();
+        record->event = (uint16_t)event;
+        record->cpu = (uint16_t)cpu;
+        record->a = a;
+        record->b = b;
+        ring->head++;
+    }
+
+    CPU_IrqRestore(flags);
+}
+
+/**
+ * TraceDump Implementation (See header include/trace.h file for description)
+*/
+void TraceDump(void)
+{
+    uint32_t cpu, i;
+
+    // Records being written when the flag is set are complete well before
+    // the printing reaches them
+    tracePaused = TRUE;
+
+    puts("@trace-begin");
+    TracePrintHex(NR_CPUS);
+    puts("\n");
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        trace_ring_t* ring = PERCPU_PTR(traceRing, cpu);
+        uint32_t head = ring->head;
+
+        i = (head > TRACE_RECORDS) ? (head - TRACE_RECORDS) : 0;
+
+        for(; i < head; ++i)
+        {
+            trace_record_t* record = &ring->records[i & (TRACE_RECORDS - 1)];
+
+            puts("@trace");
+            TracePrintHex(record->cpu);
+            TracePrintHex(record->timestamp);
+            TracePrintHex(record->event);
+            TracePrintHex(record->a);
+            TracePrintHex(record->b);
+            puts("\n");
+        }
+    }
+
+    puts("@trace-end\n");
+
+    tracePaused = FALSE;
+}
+
+#endif /* USE_TRACE */
@@ -0,0 +1,290 @@
+/**
+ * @file        vfp.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Lazy VFP/NEON context switching
+ *
+ *              Each CPU records the thread whose registers it holds (the
+ *              owner). A thread switched out keeps its registers on the CPU
+ *              until another thread there uses the FPU, so a thread that is
+ *              the only FPU user of its CPU never saves or loads them. When
+ *              a thread migrates, the first trap on the new CPU asks the old
+ *              one (IPI) to save the bank first. thread->vfpCpu is the CPU
+ *              holding the registers of the thread, VFP_CPU_NONE when they
+ *              are in thread->vfp. Owners only change with IRQs masked on
+ *              the CPU that holds them.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <vfp.h>
+#include <fpu.h>
+#include <ipi.h>
+#include <slab.h>
+#include <cpu.h>
+#include <percpu.h>
+#include <atomic.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    thread_t*   owner;                  // Thread whose registers are loaded
+    bool_t      kernel;                 // Kernel NEON section running
+    vfp_stats_t stats;
+}vfp_cpu_t;
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+static DEFINE_PERCPU(vfp_cpu_t, vfpCpu);
+
+static slab_cache_t* vfpCache;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Saves the registers of the owner of the running CPU, if any,
+ *          and leaves the CPU without owner (IRQs masked, FPU enabled)
+ * @param   vfp - VFP state of the running CPU
+ * @retval  No return
+ */
+static void VfpSaveOwner(vfp_cpu_t* vfp);
+
+/**
+ * @brief   Saves the registers of a thread if the running CPU holds them
+ *          (IPI call function)
+ * @param   arg - Thread
+ * @retval  No return
+ */
+static void VfpFlush(void* arg);
+
+
+/* Private functions -------------------------------------- */
+
+void VfpSaveOwner(vfp_cpu_t* vfp)
+{
+    thread_t* owner = vfp->owner;
+
+    if(owner != NULL)
+    {
+        fpu_save(owner->vfp);
+
+        // Bank stored before another CPU may see it released (VfpTrap)
+        smp_wmb();
+        WRITE_ONCE(owner->vfpCpu, VFP_CPU_NONE);
+        vfp->owner = NULL;
+        vfp->stats.saves++;
+    }
+}
+
+void VfpFlush(void* arg)
+{
+    vfp_cpu_t* vfp = THIS_CPU_PTR(vfpCpu);
+    uint32_t fpexc;
+
+    if(vfp->owner == (thread_t*)arg)
+    {
+        fpexc = fpu_get_fpexc();
+        fpu_set_fpexc(FPEXC_EN);
+
+        VfpSaveOwner(vfp);
+
+        fpu_set_fpexc(fpexc & ~FPEXC_EN);
+    }
+}
+
+/**
+ * VfpInit Implementation (See header include/vfp.h file for description)
+*/
+int32_t VfpInit(void)
+{
+    uint32_t cpu;
+
+    // The areas of the secondary CPUs were copied from CPU 0 by PercpuInit,
+    // inside the kernel NEON section of memcpy: start them without a
+    // section, an owner or counts
+    for(cpu = 1; cpu < NR_CPUS; ++cpu)
+    {
+        vfp_cpu_t* vfp = &PERCPU(vfpCpu, cpu);
+
+        vfp->owner = NULL;
+        vfp->kernel = FALSE;
+        vfp->stats = (vfp_stats_t){0};
+    }
+
+    vfpCache = SlabCacheCreate("vfp", sizeof(fpu_state_t), sizeof(uint64_t), NULL);
+
+    return (vfpCache == NULL) ? E_NO_MEMORY : E_OK;
+}
+
+/**
+ * VfpTrap Implementation (See header include/vfp.h file for description)
+*/
+int32_t VfpTrap(void)
+{
+    vfp_cpu_t* vfp = THIS_CPU_PTR(vfpCpu);
+    thread_t* self = SchedCurrent();
+    uint32_t i;
+
+    // Enabled already: a real undefined instruction, or NEON used by the
+    // kernel outside a section
+    if((fpu_get_fpexc() & FPEXC_EN) || vfp->kernel)
+    {
+        return E_INVAL;
+    }
+
+    vfp->stats.traps++;
+
+    if(vfp->owner == self)
+    {
+        // Nobody used the FPU here since the thread last ran
+        fpu_set_fpexc(FPEXC_EN);
+        return E_OK;
+    }
+
+    if(self->vfp == NULL)
+    {
+        if((self->vfp = (fpu_state_t*)SlabAlloc(vfpCache)) == NULL)
+        {
+            return E_NO_MEMORY;
+        }
+
+        // Not a structure copy: the compiler could turn it into a memset
+        for(i = 0; i < 32; ++i)
+        {
+            self->vfp->d[i] = 0;
+        }
+        self->vfp->fpscr = FPSCR_DEFAULT;
+    }
+    else if(READ_ONCE(self->vfpCpu) != VFP_CPU_NONE)
+    {
+        // Registers left on the CPU the thread ran on before
+        IpiCall(1 << self->vfpCpu, VfpFlush, self);
+        vfp->stats.migrations++;
+    }
+
+    // Bank saved by the previous CPU read after its release (VfpSaveOwner)
+    smp_rmb();
+
+    fpu_set_fpexc(FPEXC_EN);
+
+    VfpSaveOwner(vfp);
+
+    fpu_restore(self->vfp);
+    self->vfpCpu = CPU_Id();
+    vfp->owner = self;
+    vfp->stats.restores++;
+
+    return E_OK;
+}
+
+/**
+ * VfpSwitch Implementation (See header include/vfp.h file for description)
+*/
+void VfpSwitch(thread_t* next)
+{
+    bool_t enabled = ((fpu_get_fpexc() & FPEXC_EN) != 0);
+
+    if(enabled != (THIS_CPU(vfpCpu).owner == next))
+    {
+        fpu_set_fpexc(enabled ? 0 : FPEXC_EN);
+    }
+}
+
+/**
+ * VfpThreadExit Implementation (See header include/vfp.h file for description)
+*/
+void VfpThreadExit(thread_t* thread)
+{
+    if(thread->vfp == NULL)
+    {
+        return;
+    }
+
+    uint32_t flags = CPU_IrqSave();
+
+    if(thread->vfpCpu != VFP_CPU_NONE)
+    {
+        IpiCall(1 << thread->vfpCpu, VfpFlush, thread);
+    }
+
+    CPU_IrqRestore(flags);
+
+    SlabFree(vfpCache, thread->vfp);
+    thread->vfp = NULL;
+}
+
+/**
+ * VfpKernelBegin Implementation (See header include/vfp.h file for description)
+*/
+bool_t VfpKernelBegin(void)
+{
+    PreemptDisable();
+
+    uint32_t flags = CPU_IrqSave();
+    vfp_cpu_t* vfp = THIS_CPU_PTR(vfpCpu);
+
+    if(vfp->kernel)
+    {
+        CPU_IrqRestore(flags);
+        PreemptEnable();
+        return FALSE;
+    }
+
+    vfp->kernel = TRUE;
+    vfp->stats.kernel++;
+
+    fpu_set_fpexc(FPEXC_EN);
+
+    VfpSaveOwner(vfp);
+
+    CPU_IrqRestore(flags);
+
+    return TRUE;
+}
+
+/**
+ * VfpKernelEnd Implementation (See header include/vfp.h file for description)
+*/
+void VfpKernelEnd(void)
+{
+    uint32_t flags = CPU_IrqSave();
+
+    fpu_set_fpexc(0);
+    THIS_CPU(vfpCpu).kernel = FALSE;
+
+    CPU_IrqRestore(flags);
+
+    PreemptEnable();
+}
+
+/**
+ * VfpStats Implementation (See header include/vfp.h file for description)
+*/
+void VfpStats(vfp_stats_t* stats)
+{
+    uint32_t cpu;
+
+    *stats = (vfp_stats_t){0};
+
+    for(cpu = 0; cpu < NR_CPUS; ++cpu)
+    {
+        vfp_stats_t* cpuStats = &PERCPU_PTR(vfpCpu, cpu)->stats;
+
+        stats->traps += cpuStats->traps;
+        stats->saves += cpuStats->saves;
+        stats->restores += cpuStats->restores;
+        stats->migrations += cpuStats->migrations;
+        stats->kernel += cpuStats->kernel;
+    }
+}
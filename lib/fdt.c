@@ -0,0 +1,517 @@
+/**
+ * @file        fdt.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Flattened Device Tree Walker
+ *
+ *              The structure block is walked once, keeping the properties
+ *              of the nodes on the path from the root (pointers into the
+ *              blob). A node is classified when it ends: its properties are
+ *              all known by then, and so are the ranges of its parent buses.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <fdt.h>
+#include <misc.h>
+#include <string.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Structure block tokens
+#define FDT_BEGIN_NODE          (0x1)
+#define FDT_END_NODE            (0x2)
+#define FDT_PROP                (0x3)
+#define FDT_NOP                 (0x4)
+#define FDT_END                 (0x9)
+
+// Header words
+#define FDT_H_MAGIC             (0)
+#define FDT_H_TOTALSIZE         (1)
+#define FDT_H_OFF_STRUCT        (2)
+#define FDT_H_OFF_STRINGS       (3)
+#define FDT_H_OFF_RSVMAP        (4)
+#define FDT_H_VERSION           (5)
+#define FDT_H_LAST_COMP         (6)
+#define FDT_HEADER_SIZE         (40)
+
+// Versions read (version 16 lacks the block sizes, which are not used)
+#define FDT_VERSION_MIN         (16)
+#define FDT_VERSION_LAST_COMP   (17)
+
+// Nodes on the path from the root (the root included)
+#define FDT_MAX_DEPTH           (8)
+
+// Defaults when a node has no #address-cells / #size-cells
+#define FDT_ADDRESS_CELLS       (2)
+#define FDT_SIZE_CELLS          (1)
+
+// Compatible strings of the devices looked up
+static const char* const UartCompatible[] = {"arm,pl011", "snps,dw-apb-uart", "ns16550a", NULL};
+static const char* const GicCompatible[] = {"arm,cortex-a9-gic", "arm,cortex-a7-gic", "arm,cortex-a15-gic", "arm,gic-400", NULL};
+static const char* const TwdCompatible[] = {"arm,cortex-a9-twd-timer", NULL};
+static const char* const TimerCompatible[] = {"arm,armv7-timer", NULL};
+
+
+/* Private types ------------------------------------------ */
+
+// Properties of a node on the current path (pointers into the blob)
+typedef struct
+{
+    const char*    name;
+    uint32_t       addressCells;        // Children #address-cells
+    uint32_t       sizeCells;           // Children #size-cells
+    const uint8_t* ranges;              // NULL without ranges
+    uint32_t       rangesLen;
+    const uint8_t* reg;
+    uint32_t       regLen;
+    const char*    compatible;          // String list
+    uint32_t       compatibleLen;
+    const char*    deviceType;
+    const uint8_t* clockFrequency;
+    bool_t         disabled;
+}fdt_node_t;
+
+
+/* Private macros ----------------------------------------- */
+
+// Header word of a blob
+#define FDT_HEADER(blob, word)  FdtBe32((const uint8_t*)(blob) + ((word) * 4))
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Reads a big endian 32 bit value (any alignment)
+ * @param   p - Value
+ * @retval  Value
+ */
+static uint32_t FdtBe32(const uint8_t* p);
+
+/**
+ * @brief   Reads a value of 1 or 2 cells
+ * @param   p - First cell
+ *          cells - Number of cells (0 reads as 0)
+ * @retval  Value
+ */
+static uint64_t FdtCells(const uint8_t* p, uint32_t cells);
+
+/**
+ * @brief   Stores a property of the node when the walker uses it
+ * @param   node - Node
+ *          name - Property name
+ *          value - Property value
+ *          len - Value size
+ * @retval  No return
+ */
+static void FdtProperty(fdt_node_t* node, const char* name, const uint8_t* value, uint32_t len);
+
+/**
+ * @brief   Checks the node compatible list against a list of strings
+ * @param   node - Node
+ *          list - Compatible strings, NULL terminated
+ * @retval  TRUE if one of the strings matches
+ */
+static bool_t FdtCompatible(const fdt_node_t* node, const char* const* list);
+
+/**
+ * @brief   Translates a bus address to a physical address through the
+ *          ranges of the bus and of its parents
+ * @param   path - Nodes from the root
+ *          bus - Depth of the bus the address belongs to
+ *          addr - Address, translated on success
+ * @retval  TRUE on success, FALSE if a bus has no matching range
+ */
+static bool_t FdtTranslate(const fdt_node_t* path, int32_t bus, uint64_t* addr);
+
+/**
+ * @brief   Reads a reg entry of a node as a physical range
+ * @param   path - Nodes from the root
+ *          depth - Depth of the node
+ *          index - Entry
+ *          addr - Physical address
+ *          size - Size
+ * @retval  TRUE on success, FALSE if the entry does not exist or cannot be
+ *          translated
+ */
+static bool_t FdtReg(const fdt_node_t* path, int32_t depth, uint32_t index, uint64_t* addr, uint64_t* size);
+
+/**
+ * @brief   Adds a node to the platform description, once its properties
+ *          are all known
+ * @param   platform - Platform description
+ *          path - Nodes from the root
+ *          depth - Depth of the node
+ * @retval  No return
+ */
+static void FdtNode(fdt_platform_t* platform, const fdt_node_t* path, int32_t depth);
+
+
+/* Private functions -------------------------------------- */
+
+uint32_t FdtBe32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+uint64_t FdtCells(const uint8_t* p, uint32_t cells)
+{
+    uint64_t value = 0;
+
+    for(; cells != 0; --cells, p += 4)
+    {
+        value = (value << 32) | FdtBe32(p);
+    }
+
+    return value;
+}
+
+void FdtProperty(fdt_node_t* node, const char* name, const uint8_t* value, uint32_t len)
+{
+    // String values must be terminated inside the property
+    bool_t string = (len != 0) && (value[len - 1] == '\0');
+
+    if(!strcmp(name, "#address-cells") && (len == 4))
+    {
+        node->addressCells = FdtBe32(value);
+    }
+    else if(!strcmp(name, "#size-cells") && (len == 4))
+    {
+        node->sizeCells = FdtBe32(value);
+    }
+    else if(!strcmp(name, "ranges"))
+    {
+        node->ranges = value;
+        node->rangesLen = len;
+    }
+    else if(!strcmp(name, "reg"))
+    {
+        node->reg = value;
+        node->regLen = len;
+    }
+    else if(!strcmp(name, "compatible") && string)
+    {
+        node->compatible = (const char*)value;
+        node->compatibleLen = len;
+    }
+    else if(!strcmp(name, "device_type") && string)
+    {
+        node->deviceType = (const char*)value;
+    }
+    else if(!strcmp(name, "status") && string)
+    {
+        node->disabled = strcmp((const char*)value, "okay") && strcmp((const char*)value, "ok");
+    }
+    else if(!strcmp(name, "clock-frequency") && (len == 4))
+    {
+        node->clockFrequency = value;
+    }
+}
+
+bool_t FdtCompatible(const fdt_node_t* node, const char* const* list)
+{
+    const char* s;
+    const char* end = node->compatible + node->compatibleLen;
+
+    if(node->compatible == NULL)
+    {
+        return FALSE;
+    }
+
+    for(s = node->compatible; s < end; s += strlen(s) + 1)
+    {
+        const char* const* c;
+
+        for(c = list; *c != NULL; ++c)
+        {
+            if(!strcmp(s, *c))
+            {
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+bool_t FdtTranslate(const fdt_node_t* path, int32_t bus, uint64_t* addr)
+{
+    // The root address space is the physical one
+    for(; bus > 0; --bus)
+    {
+        const fdt_node_t* node = &path[bus];
+        const fdt_node_t* parent = &path[bus - 1];
+        uint32_t entry = (node->addressCells + parent->addressCells + node->sizeCells) * 4;
+        const uint8_t* p;
+        bool_t found = FALSE;
+
+        if(node->ranges == NULL)
+        {
+            // Not memory mapped (no ranges property)
+            return FALSE;
+        }
+
+        if(node->rangesLen == 0)
+        {
+            // Empty ranges: identity
+            continue;
+        }
+
+        if((node->addressCells > 2) || (parent->addressCells > 2) || (node->sizeCells > 2))
+        {
+            return FALSE;
+        }
+
+        for(p = node->ranges; p + entry <= node->ranges + node->rangesLen; p += entry)
+        {
+            uint64_t child = FdtCells(p, node->addressCells);
+            uint64_t base = FdtCells(p + (node->addressCells * 4), parent->addressCells);
+            uint64_t len = FdtCells(p + ((node->addressCells + parent->addressCells) * 4), node->sizeCells);
+
+            if((*addr >= child) && ((*addr - child) < len))
+            {
+                *addr = base + (*addr - child);
+                found = TRUE;
+                break;
+            }
+        }
+
+        if(!found)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+bool_t FdtReg(const fdt_node_t* path, int32_t depth, uint32_t index, uint64_t* addr, uint64_t* size)
+{
+    const fdt_node_t* node = &path[depth];
+    const fdt_node_t* parent = &path[depth - 1];
+    uint32_t entry = (parent->addressCells + parent->sizeCells) * 4;
+
+    if((node->reg == NULL) || (entry == 0) || (parent->addressCells > 2) || (parent->sizeCells > 2) ||
+       (((index + 1) * entry) > node->regLen))
+    {
+        return FALSE;
+    }
+
+    *addr = FdtCells(node->reg + (index * entry), parent->addressCells);
+    *size = FdtCells(node->reg + (index * entry) + (parent->addressCells * 4), parent->sizeCells);
+
+    return FdtTranslate(path, depth - 1, addr);
+}
+
+void FdtNode(fdt_platform_t* platform, const fdt_node_t* path, int32_t depth)
+{
+    const fdt_node_t* node = &path[depth];
+    uint64_t addr, size;
+    uint32_t i;
+
+    if((depth == 0) || node->disabled)
+    {
+        return;
+    }
+
+    if((node->deviceType != NULL) && !strcmp(node->deviceType, "memory"))
+    {
+        // Banks above 4Gb cannot be used without LPAE
+        for(i = 0; FdtReg(path, depth, i, &addr, &size) && (platform->banks < FDT_MAX_BANKS); ++i)
+        {
+            if((size != 0) && (addr < 0x100000000ULL))
+            {
+                if(size > (0x100000000ULL - addr))
+                {
+                    size = 0x100000000ULL - addr;
+                }
+
+                platform->memory[platform->banks].data = (ptr_t)(ulong_t)addr;
+                platform->memory[platform->banks].size = (size_t)size;
+                platform->banks++;
+            }
+        }
+    }
+    else if((node->deviceType != NULL) && !strcmp(node->deviceType, "cpu") && !strcmp(path[depth - 1].name, "cpus"))
+    {
+        platform->cpus++;
+    }
+    else if(FdtCompatible(node, UartCompatible))
+    {
+        if((platform->uart == NULL) && FdtReg(path, depth, 0, &addr, &size))
+        {
+            platform->uart = (paddr_t)(ulong_t)addr;
+        }
+    }
+    else if(FdtCompatible(node, GicCompatible))
+    {
+        if(FdtReg(path, depth, 0, &addr, &size))
+        {
+            platform->gicDist = (paddr_t)(ulong_t)addr;
+        }
+
+        if(FdtReg(path, depth, 1, &addr, &size))
+        {
+            platform->gicCpu = (paddr_t)(ulong_t)addr;
+        }
+    }
+    else if(FdtCompatible(node, TwdCompatible))
+    {
+        if(FdtReg(path, depth, 0, &addr, &size))
+        {
+            platform->timer = (paddr_t)(ulong_t)addr;
+        }
+    }
+    else if(FdtCompatible(node, TimerCompatible) && (node->clockFrequency != NULL))
+    {
+        platform->timerFrequency = FdtBe32(node->clockFrequency);
+    }
+}
+
+/**
+ * FdtSize Implementation (See header include/fdt.h file for description)
+*/
+size_t FdtSize(const void* blob)
+{
+    size_t size;
+
+    if((blob == NULL) || (FDT_HEADER(blob, FDT_H_MAGIC) != FDT_MAGIC))
+    {
+        return 0;
+    }
+
+    size = FDT_HEADER(blob, FDT_H_TOTALSIZE);
+
+    if((FDT_HEADER(blob, FDT_H_VERSION) < FDT_VERSION_MIN) ||
+       (FDT_HEADER(blob, FDT_H_LAST_COMP) > FDT_VERSION_LAST_COMP) ||
+       (size < FDT_HEADER_SIZE) ||
+       (FDT_HEADER(blob, FDT_H_OFF_STRUCT) >= size) ||
+       (FDT_HEADER(blob, FDT_H_OFF_STRINGS) >= size) ||
+       (FDT_HEADER(blob, FDT_H_OFF_RSVMAP) >= size))
+    {
+        return 0;
+    }
+
+    return size;
+}
+
+/**
+ * FdtParse Implementation (See header include/fdt.h file for description)
+*/
+int32_t FdtParse(const void* blob, fdt_platform_t* platform)
+{
+    fdt_node_t path[FDT_MAX_DEPTH];
+    size_t size = FdtSize(blob);
+    const uint8_t* base = (const uint8_t*)blob;
+    const uint8_t* end = base + size;
+    const uint8_t* p;
+    const char* strings;
+    int32_t depth = -1;
+
+    if(size == 0)
+    {
+        return E_INVAL;
+    }
+
+    memset(platform, 0, sizeof(fdt_platform_t));
+
+    // Memory reservation block: 64 bit address and size pairs, ended by 0, 0
+    for(p = base + FDT_HEADER(blob, FDT_H_OFF_RSVMAP); p + 16 <= end; p += 16)
+    {
+        uint64_t addr = FdtCells(p, 2);
+        uint64_t len = FdtCells(p + 8, 2);
+
+        if((addr == 0) && (len == 0))
+        {
+            break;
+        }
+
+        if((platform->reserved < FDT_MAX_RESERVED) && (addr < 0x100000000ULL))
+        {
+            platform->reserve[platform->reserved].data = (ptr_t)(ulong_t)addr;
+            platform->reserve[platform->reserved].size = (size_t)len;
+            platform->reserved++;
+        }
+    }
+
+    strings = (const char*)(base + FDT_HEADER(blob, FDT_H_OFF_STRINGS));
+
+    for(p = base + FDT_HEADER(blob, FDT_H_OFF_STRUCT); p + 4 <= end; )
+    {
+        uint32_t token = FdtBe32(p);
+        p += 4;
+
+        switch(token)
+        {
+            case FDT_BEGIN_NODE:
+            {
+                if(++depth >= FDT_MAX_DEPTH)
+                {
+                    return E_INVAL;
+                }
+
+                fdt_node_t* node = &path[depth];
+
+                memset(node, 0, sizeof(fdt_node_t));
+                node->name = (const char*)p;
+                node->addressCells = FDT_ADDRESS_CELLS;
+                node->sizeCells = FDT_SIZE_CELLS;
+
+                // Name, terminated and padded to the next token
+                p += ROUND_UP(strlen(node->name) + 1, 4);
+                break;
+            }
+            case FDT_END_NODE:
+            {
+                if(depth < 0)
+                {
+                    return E_INVAL;
+                }
+
+                FdtNode(platform, path, depth);
+                depth--;
+                break;
+            }
+            case FDT_PROP:
+            {
+                if((depth < 0) || (p + 8 > end))
+                {
+                    return E_INVAL;
+                }
+
+                uint32_t len = FdtBe32(p);
+                const char* name = strings + FdtBe32(p + 4);
+                const uint8_t* value = p + 8;
+
+                p = value + ROUND_UP(len, 4);
+
+                if(p > end)
+                {
+                    return E_INVAL;
+                }
+
+                FdtProperty(&path[depth], name, value, len);
+                break;
+            }
+            case FDT_NOP:
+            {
+                break;
+            }
+            case FDT_END:
+            {
+                return (depth == -1) ? E_OK : E_INVAL;
+            }
+            default:
+            {
+                return E_INVAL;
+            }
+        }
+    }
+
+    return E_INVAL;
+}
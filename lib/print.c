@@ -0,0 +1,61 @@
+/**
+ * @file        print.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Decimal Output for the Report Lines
+ *
+ *              The @boot and @bench lines are sequences of " key=value"
+ *              fields with decimal values, printed without a formatter.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <serial.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * putu Implementation (See header arch/include/serial.h file for description)
+*/
+void putu(uint32_t value)
+{
+    char str[11];
+    int32_t i = sizeof(str) - 1;
+
+    str[i] = '\0';
+    do
+    {
+        str[--i] = '0' + (value % 10);
+        value /= 10;
+    }while(value != 0);
+
+    puts(&str[i]);
+}
+
+/**
+ * putfield Implementation (See header arch/include/serial.h file for description)
+*/
+void putfield(const char* key, uint32_t value)
+{
+    putc(' ');
+    puts(key);
+    putc('=');
+    putu(value);
+}
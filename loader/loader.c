@@ -0,0 +1,394 @@
+/**
+ * @file        loader.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       User Server Loader (ELF32)
+ *
+ *              A segment is split in three page ranges: pages backed by the
+ *              file only (mapped from the image), the page where the file
+ *              data ends and bss starts (copied, the rest of it zeroed) and
+ *              the bss pages after it (zero filled on demand). Servers run
+ *              until shutdown: process slots are not released.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <loader.h>
+#include <elf.h>
+#include <mmu.h>
+#include <misc.h>
+#include <string.h>
+#include <spinlock.h>
+#include <tlb.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Smallest large page entry (64Kb): in-place segments whose file offset
+// is not congruent with the address modulo this size use 4Kb pages only
+#define LARGE_PAGE_SIZE     (0x10000)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    space_t* space;
+    vaddr_t  entry;
+    bool_t   used;
+}loader_proc_t;
+
+
+/* Private macros ----------------------------------------- */
+
+#define PAGE_OFFSET(x)      (((ulong_t)(x)) & (PAGE_SIZE - 1))
+
+
+/* Private variables -------------------------------------- */
+
+// Set in the linker script
+extern const loader_image_t __servers_table_start[];
+extern const loader_image_t __servers_table_end[];
+
+static loader_proc_t procs[LOADER_PROCS];
+
+static loader_stats_t loaderStats;
+
+static spinlock_t loaderLock = SPINLOCK_INIT("loader");
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Checks the ELF header of an image
+ * @param   image - Server image
+ * @retval  ELF header, NULL if the image is not a valid ARM executable
+ */
+static const elf32_ehdr_t* LoaderCheck(const loader_image_t* image);
+
+/**
+ * @brief   Loads a PT_LOAD segment
+ * @param   image - Server image
+ *          space - Address space
+ *          phdr - Program header
+ *          flags - LOADER_* flags
+ *          stats - Statistics of the load
+ * @retval  E_OK on success, E_INVAL if the segment is not valid,
+ *          E_NO_MEMORY or E_NO_RES if the space cannot hold it
+ */
+static int32_t LoaderSegment(const loader_image_t* image, space_t* space, const elf32_phdr_t* phdr, uint32_t flags, loader_stats_t* stats);
+
+/**
+ * @brief   Server thread: enters the server space and drops to user mode
+ * @param   arg - Process
+ * @retval  No return
+ */
+static void LoaderStart(void* arg);
+
+// Drops to user mode at entry with r0 = arg (kernel.S), does not return
+extern void UserEnter(ulong_t entry, ulong_t usrSp, ulong_t arg, ulong_t svcSp);
+
+
+/* Private functions -------------------------------------- */
+
+const elf32_ehdr_t* LoaderCheck(const loader_image_t* image)
+{
+    const elf32_ehdr_t* ehdr = (const elf32_ehdr_t*)image->data;
+
+    if((image->size < sizeof(elf32_ehdr_t)) || PAGE_OFFSET(image->data))
+    {
+        return NULL;
+    }
+
+    if((ehdr->e_ident[0] != ELFMAG0) || (ehdr->e_ident[1] != ELFMAG1) ||
+       (ehdr->e_ident[2] != ELFMAG2) || (ehdr->e_ident[3] != ELFMAG3) ||
+       (ehdr->e_ident[EI_CLASS] != ELFCLASS32) || (ehdr->e_ident[EI_DATA] != ELFDATA2LSB) ||
+       (ehdr->e_type != ET_EXEC) || (ehdr->e_machine != EM_ARM))
+    {
+        return NULL;
+    }
+
+    if((ehdr->e_phentsize != sizeof(elf32_phdr_t)) || (ehdr->e_phoff > image->size) ||
+       ((ehdr->e_phnum * sizeof(elf32_phdr_t)) > (image->size - ehdr->e_phoff)) ||
+       (ehdr->e_phoff & 3))
+    {
+        return NULL;
+    }
+
+    return ehdr;
+}
+
+int32_t LoaderSegment(const loader_image_t* image, space_t* space, const elf32_phdr_t* phdr, uint32_t flags, loader_stats_t* stats)
+{
+    ulong_t vaddr = phdr->p_vaddr;
+    ulong_t fileEnd = vaddr + phdr->p_filesz;
+    ulong_t start = ROUND_DOWN(vaddr, PAGE_SIZE);
+    ulong_t end, inPlaceEnd, copyStart;
+    uint32_t spaceFlags = 0;
+    paddr_t paddr;
+    int32_t status;
+
+    // The stack sits on top of the segments
+    if((phdr->p_filesz > phdr->p_memsz) || (phdr->p_offset > image->size) ||
+       (phdr->p_filesz > (image->size - phdr->p_offset)) ||
+       (vaddr >= (LOADER_STACK_TOP - LOADER_STACK_SIZE)) ||
+       (phdr->p_memsz > ((LOADER_STACK_TOP - LOADER_STACK_SIZE) - vaddr)))
+    {
+        return E_INVAL;
+    }
+
+    end = ROUND_UP(vaddr + phdr->p_memsz, PAGE_SIZE);
+
+    if(phdr->p_flags & PF_W)
+    {
+        spaceFlags |= SPACE_WRITE;
+    }
+
+    if(phdr->p_flags & PF_X)
+    {
+        spaceFlags |= SPACE_EXEC;
+    }
+
+    // Pages backed by the file only. Without bss the last page also shows
+    // what follows the segment in the file, as with any ELF loader
+    inPlaceEnd = (phdr->p_memsz > phdr->p_filesz) ? ROUND_DOWN(fileEnd, PAGE_SIZE) : ROUND_UP(fileEnd, PAGE_SIZE);
+
+    if((flags & LOADER_COPY) || (PAGE_OFFSET(phdr->p_offset) != PAGE_OFFSET(vaddr)) || (inPlaceEnd < start))
+    {
+        inPlaceEnd = start;
+    }
+
+    paddr = MMU_L2P((vaddr_t)ROUND_DOWN((ulong_t)image->data + phdr->p_offset, PAGE_SIZE));
+
+    if(!(spaceFlags & SPACE_WRITE) && (inPlaceEnd > start))
+    {
+        // Text and read-only data: the image pages themselves, shared by
+        // every instance of the server
+        memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RORO, TRUE, (spaceFlags & SPACE_EXEC) ? TRUE : FALSE, FALSE};
+        pbv_t pages = {(ptr_t)paddr, inPlaceEnd - start};
+        ulong_t offset;
+
+        SpinLock(&space->lock);
+
+        if((start ^ (ulong_t)paddr) & (LARGE_PAGE_SIZE - 1))
+        {
+            // A large entry would map the frames of the aligned block
+            for(offset = 0; offset < (inPlaceEnd - start); offset += PAGE_SIZE)
+            {
+                pbv_t page = {(ptr_t)((ulong_t)paddr + offset), PAGE_SIZE};
+                MMU_MapPages(space->pgt, (vaddr_t)(start + offset), &page, 1, &memCfg);
+            }
+        }
+        else
+        {
+            MMU_MapPages(space->pgt, (vaddr_t)start, &pages, 1, &memCfg);
+        }
+
+        SpinUnlock(&space->lock);
+
+        stats->mapped += inPlaceEnd - start;
+
+        // Not a region: never faults, copied or released
+        start = inPlaceEnd;
+    }
+
+    if(start < end)
+    {
+        if((status = SpaceReserve(space, (vaddr_t)start, end - start, spaceFlags)) != E_OK)
+        {
+            return status;
+        }
+
+        if(inPlaceEnd > start)
+        {
+            // Writable data: copied page by page on the first write
+            SpaceShare(space, (vaddr_t)start, paddr, inPlaceEnd - start);
+
+            stats->shared += inPlaceEnd - start;
+        }
+    }
+
+    // File data not mapped in place
+    copyStart = (inPlaceEnd > vaddr) ? inPlaceEnd : vaddr;
+
+    if(fileEnd > copyStart)
+    {
+        status = SpaceCopyIn(space, (vaddr_t)copyStart, image->data + phdr->p_offset + (copyStart - vaddr), fileEnd - copyStart);
+
+        if(status != E_OK)
+        {
+            return status;
+        }
+
+        stats->copied += fileEnd - copyStart;
+    }
+
+    if(end > ROUND_UP(fileEnd, PAGE_SIZE))
+    {
+        stats->zeroed += end - ROUND_UP(fileEnd, PAGE_SIZE);
+    }
+
+    return E_OK;
+}
+
+void LoaderStart(void* arg)
+{
+    loader_proc_t* proc = (loader_proc_t*)arg;
+
+    SpaceEnter(proc->space);
+
+    // The SVC stack is reset: nothing of this frame is needed in user mode
+    UserEnter((ulong_t)proc->entry, LOADER_STACK_TOP, 0, (ulong_t)SchedCurrent() + THREAD_STACK_SIZE);
+}
+
+/**
+ * LoaderFind Implementation (See header include/loader.h file for description)
+*/
+const loader_image_t* LoaderFind(const char* name)
+{
+    const loader_image_t* image;
+
+    for(image = __servers_table_start; image < __servers_table_end; ++image)
+    {
+        if(strcmp(image->name, name) == 0)
+        {
+            return image;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * LoaderImage Implementation (See header include/loader.h file for description)
+*/
+const loader_image_t* LoaderImage(uint32_t index)
+{
+    if(index >= (uint32_t)(__servers_table_end - __servers_table_start))
+    {
+        return NULL;
+    }
+
+    return &__servers_table_start[index];
+}
+
+/**
+ * LoaderLoad Implementation (See header include/loader.h file for description)
+*/
+int32_t LoaderLoad(const loader_image_t* image, space_t* space, uint32_t flags, vaddr_t* entry)
+{
+    const elf32_ehdr_t* ehdr = LoaderCheck(image);
+    const elf32_phdr_t* phdrs;
+    loader_stats_t stats = {0};
+    int32_t status;
+    uint32_t i;
+
+    if(ehdr == NULL)
+    {
+        return E_INVAL;
+    }
+
+    phdrs = (const elf32_phdr_t*)(image->data + ehdr->e_phoff);
+
+    for(i = 0; i < ehdr->e_phnum; ++i)
+    {
+        if((phdrs[i].p_type != PT_LOAD) || (phdrs[i].p_memsz == 0))
+        {
+            continue;
+        }
+
+        if((status = LoaderSegment(image, space, &phdrs[i], flags, &stats)) != E_OK)
+        {
+            return status;
+        }
+    }
+
+    // User stack, populated as it grows
+    status = SpaceReserve(space, (vaddr_t)(LOADER_STACK_TOP - LOADER_STACK_SIZE), LOADER_STACK_SIZE, SPACE_WRITE);
+
+    if(status != E_OK)
+    {
+        return status;
+    }
+
+    // Text mapped in place may be in the I-cache at its kernel address only
+    TlbInvalidateICache();
+
+    *entry = (vaddr_t)ehdr->e_entry;
+
+    SpinLock(&loaderLock);
+    loaderStats.loads++;
+    loaderStats.mapped += stats.mapped;
+    loaderStats.shared += stats.shared;
+    loaderStats.copied += stats.copied;
+    loaderStats.zeroed += stats.zeroed;
+    SpinUnlock(&loaderLock);
+
+    return E_OK;
+}
+
+/**
+ * LoaderSpawn Implementation (See header include/loader.h file for description)
+*/
+thread_t* LoaderSpawn(const char* name, uint32_t priority, uint32_t affinity)
+{
+    const loader_image_t* image = LoaderFind(name);
+    loader_proc_t* proc = NULL;
+    thread_t* thread = NULL;
+    uint32_t i;
+
+    if(image == NULL)
+    {
+        return NULL;
+    }
+
+    SpinLock(&loaderLock);
+
+    for(i = 0; i < LOADER_PROCS; ++i)
+    {
+        if(!procs[i].used)
+        {
+            proc = &procs[i];
+            proc->used = TRUE;
+            break;
+        }
+    }
+
+    SpinUnlock(&loaderLock);
+
+    if(proc == NULL)
+    {
+        return NULL;
+    }
+
+    if((proc->space = SpaceCreate()) != NULL)
+    {
+        if(LoaderLoad(image, proc->space, 0, &proc->entry) == E_OK)
+        {
+            thread = ThreadCreate(image->name, LoaderStart, proc, priority, affinity);
+        }
+
+        if(thread == NULL)
+        {
+            SpaceDestroy(proc->space);
+        }
+    }
+
+    if(thread == NULL)
+    {
+        proc->used = FALSE;
+    }
+
+    return thread;
+}
+
+/**
+ * LoaderStats Implementation (See header include/loader.h file for description)
+*/
+void LoaderStats(loader_stats_t* stats)
+{
+    SpinLock(&loaderLock);
+    *stats = loaderStats;
+    SpinUnlock(&loaderLock);
+}
@@ -0,0 +1,1086 @@
+/**
+ * @file        page.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Physical Page Frame Allocator (Buddy System)
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <page.h>
+#include <misc.h>
+#include <cpu.h>
+#include <percpu.h>
+#include <spinlock.h>
+#include <sched.h>
+#include <atomic.h>
+#include <platform.h>
+#include <string.h>
+#include <vfp.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Frame flags
+#define FRAME_FREE          (1 << 0)    // First frame of a block in the buddy lists
+#define FRAME_COLOUR        (1 << 1)    // Frame in a colour list
+#define FRAME_ZERO          (1 << 2)    // Frame in the pre-zeroed list
+
+// Per-CPU cache limits
+#define PCP_HIGH            (32)        // Cache capacity
+#define PCP_BATCH           (16)        // Pages moved from/to the buddy lists at once
+
+// Idle page zeroing
+#define ZERO_CHUNK          (512)       // Bytes cleared between two checks for work
+#define ZERO_FREE_MIN       (1024)      // Free pages left alone (memory pressure)
+
+#define SECTION_SIZE        (0x100000)
+#define LARGE_SECTION_SIZE  (0x1000000)
+
+// Granules tried by PageAllocVector, largest first
+static const uint8_t VectorOrders[] = {PAGE_ORDER_16M, PAGE_ORDER_1M, PAGE_ORDER_64K, PAGE_ORDER_4K};
+
+
+/* Private types ------------------------------------------ */
+
+// Page frame descriptor (one per 4Kb frame)
+typedef struct frame
+{
+    struct frame*   next;
+    struct frame*   prev;
+    uint8_t         order;          // Block order (valid when FRAME_FREE is set)
+    uint8_t         flags;
+    uint16_t        shares;         // Extra mappings of an allocated 4Kb frame (PageGet)
+}frame_t;
+
+// Per-CPU cache of order 0 pages
+typedef struct
+{
+    uint32_t    count;
+    paddr_t     pages[PCP_HIGH];
+}page_cache_t;
+
+
+/* Private macros ----------------------------------------- */
+
+#define PFN(paddr)          ((ulong_t)(paddr) >> 12)
+#define FRAME_INDEX(paddr)  (PFN(paddr) - basePfn)
+#define FRAME_ADDR(index)   ((paddr_t)((basePfn + (index)) << 12))
+
+
+/* Private variables -------------------------------------- */
+
+static frame_t* frames;
+static ulong_t  basePfn;
+static size_t   totalFrames;
+static size_t   freeFrames;
+
+// End of the RAM managed (physical, section aligned)
+static ulong_t  ramEnd;
+
+// Free block lists per order (list heads)
+static frame_t  freeLists[PAGE_MAX_ORDER + 1];
+
+// Order 0 pages cached per CPU (only the owner CPU touches its cache)
+static DEFINE_PERCPU(page_cache_t, pageCache);
+
+// Free 4Kb frames per colour (list heads), fed with PAGE_COLOUR_ORDER blocks
+static frame_t  colourLists[PAGE_COLOURS];
+static size_t   colourFrames;
+
+// Order 0 pages cleared by the idle CPUs (list head), allocated in the buddy
+// system so they are not counted in freeFrames
+static frame_t  zeroList;
+static size_t   zeroFrames;
+static uint32_t zeroHits;
+static uint32_t zeroMisses;
+static uint32_t zeroAborts;
+
+// Buddy lists, colour lists, pre-zeroed list and frame descriptors
+static spinlock_t zoneLock = SPINLOCK_INIT("page zone");
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Inserts a free block in the list of its order
+ * @param   index - First frame of the block
+ *          order - Block order
+ * @retval  No return
+ */
+static void BuddyPush(size_t index, uint32_t order);
+
+/**
+ * @brief   Removes a free block from its list
+ * @param   frame - First frame of the block
+ * @retval  No return
+ */
+static void BuddyRemove(frame_t* frame);
+
+/**
+ * @brief   Allocates a block from the buddy lists, splitting larger blocks
+ * @param   order - Block order
+ * @retval  Physical address, NULL if there is no block available
+ */
+static paddr_t BuddyAlloc(uint32_t order);
+
+/**
+ * @brief   Returns a block to the buddy lists, merging it with its buddies
+ * @param   index - First frame of the block
+ *          order - Block order
+ * @retval  No return
+ */
+static void BuddyFree(size_t index, uint32_t order);
+
+/**
+ * @brief   Releases a range of frames as the largest aligned blocks possible
+ * @param   start - First frame
+ *          end - Frame after the last one
+ * @retval  No return
+ */
+static void BuddyFreeRange(size_t start, size_t end);
+
+/**
+ * @brief   Releases a range of frames, except the reserved ranges
+ * @param   start - First frame
+ *          end - Frame after the last one
+ *          reserve - Reserved physical ranges
+ *          count - Number of reserved ranges
+ * @retval  No return
+ */
+static void BuddyFreeAvailable(size_t start, size_t end, const pbv_t* reserve, uint32_t count);
+
+/**
+ * @brief   Takes a free frame of the given colour, splitting a buddy block
+ *          in one frame per colour when the colour list is empty
+ * @param   colour - Page colour
+ * @retval  Physical address, NULL if there is no block available
+ */
+static paddr_t ColourTake(uint32_t colour);
+
+/**
+ * @brief   Inserts a frame in the list of its colour
+ * @param   index - Frame
+ * @retval  No return
+ */
+static void ColourPush(size_t index);
+
+/**
+ * @brief   Returns a frame to its colour list. The block is given back to
+ *          the buddy lists once all its frames are free
+ * @param   paddr - Physical address
+ * @retval  No return
+ */
+static void ColourPut(paddr_t paddr);
+
+/**
+ * @brief   Inserts a cleared frame in the pre-zeroed list
+ * @param   index - Frame
+ * @retval  No return
+ */
+static void ZeroPush(size_t index);
+
+/**
+ * @brief   Takes a frame from the pre-zeroed list
+ * @param   None
+ * @retval  Physical address, NULL if the list is empty
+ */
+static paddr_t ZeroTake(void);
+
+/**
+ * @brief   Returns every pre-zeroed frame to the buddy lists (out of memory)
+ * @param   None
+ * @retval  TRUE if any frame was returned
+ */
+static bool_t ZeroDrain(void);
+
+/**
+ * @brief   Maps the RAM in the kernel logical space (1Mb granule or larger)
+ * @param   start - First physical address (1Mb aligned)
+ *          end - End physical address (1Mb aligned)
+ * @retval  No return
+ */
+static void PageMapLogical(ulong_t start, ulong_t end);
+
+
+/* Private functions -------------------------------------- */
+
+void BuddyPush(size_t index, uint32_t order)
+{
+    frame_t* frame = &frames[index];
+    frame_t* head = &freeLists[order];
+
+    frame->order = order;
+    frame->flags |= FRAME_FREE;
+
+    frame->next = head->next;
+    frame->prev = head;
+    head->next->prev = frame;
+    head->next = frame;
+}
+
+void BuddyRemove(frame_t* frame)
+{
+    frame->prev->next = frame->next;
+    frame->next->prev = frame->prev;
+    frame->flags &= ~FRAME_FREE;
+}
+
+paddr_t BuddyAlloc(uint32_t order)
+{
+    uint32_t current;
+
+    // Smallest block that fits, so large blocks are only split when needed
+    for(current = order; current <= PAGE_MAX_ORDER; ++current)
+    {
+        if(freeLists[current].next != &freeLists[current])
+        {
+            break;
+        }
+    }
+
+    if(current > PAGE_MAX_ORDER)
+    {
+        // Pre-zeroed pages are free memory too, give them back before failing
+        return ZeroDrain() ? BuddyAlloc(order) : NULL;
+    }
+
+    frame_t* frame = freeLists[current].next;
+    size_t index = frame - frames;
+
+    BuddyRemove(frame);
+
+    // Return the upper halves to the lists
+    while(current > order)
+    {
+        current--;
+        BuddyPush(index + (1 << current), current);
+    }
+
+    freeFrames -= (1 << order);
+
+    return FRAME_ADDR(index);
+}
+
+void BuddyFree(size_t index, uint32_t order)
+{
+    freeFrames += (1 << order);
+
+    while(order < PAGE_MAX_ORDER)
+    {
+        // Buddies are aligned on physical frame numbers
+        ulong_t buddyPfn = (basePfn + index) ^ (1 << order);
+
+        if((buddyPfn < basePfn) || ((buddyPfn - basePfn) >= totalFrames))
+        {
+            break;
+        }
+
+        frame_t* buddy = &frames[buddyPfn - basePfn];
+
+        if(!(buddy->flags & FRAME_FREE) || (buddy->order != order))
+        {
+            break;
+        }
+
+        BuddyRemove(buddy);
+
+        if((buddyPfn - basePfn) < index)
+        {
+            index = buddyPfn - basePfn;
+        }
+        order++;
+    }
+
+    BuddyPush(index, order);
+}
+
+void BuddyFreeRange(size_t start, size_t end)
+{
+    while(start < end)
+    {
+        uint32_t order = PAGE_MAX_ORDER;
+
+        while((order > 0) && ((((basePfn + start) & ((1 << order) - 1)) != 0) || ((start + (1 << order)) > end)))
+        {
+            order--;
+        }
+
+        BuddyFree(start, order);
+        start += (1 << order);
+    }
+}
+
+void BuddyFreeAvailable(size_t start, size_t end, const pbv_t* reserve, uint32_t count)
+{
+    uint32_t i;
+
+    // Few reserved ranges: split the range around the first one inside it
+    for(i = 0; i < count; ++i)
+    {
+        ulong_t first = PFN(reserve[i].data);
+        ulong_t last = PFN(ROUND_UP((ulong_t)reserve[i].data + reserve[i].size, PAGE_SIZE));
+
+        if((last > (basePfn + start)) && (first < (basePfn + end)))
+        {
+            if(first > (basePfn + start))
+            {
+                BuddyFreeAvailable(start, first - basePfn, &reserve[i + 1], count - i - 1);
+            }
+
+            if(last < (basePfn + end))
+            {
+                BuddyFreeAvailable(last - basePfn, end, &reserve[i + 1], count - i - 1);
+            }
+            return;
+        }
+    }
+
+    BuddyFreeRange(start, end);
+}
+
+paddr_t ColourTake(uint32_t colour)
+{
+    frame_t* head = &colourLists[colour];
+    uint32_t i;
+
+    if(head->next == head)
+    {
+        paddr_t block = BuddyAlloc(PAGE_COLOUR_ORDER);
+
+        if(block == NULL)
+        {
+            return NULL;
+        }
+
+        for(i = 0; i < PAGE_COLOURS; ++i)
+        {
+            ColourPush(FRAME_INDEX(block) + i);
+        }
+    }
+
+    frame_t* frame = head->next;
+
+    frame->prev->next = frame->next;
+    frame->next->prev = frame->prev;
+    frame->flags &= ~FRAME_COLOUR;
+    colourFrames--;
+
+    return FRAME_ADDR(frame - frames);
+}
+
+void ColourPush(size_t index)
+{
+    frame_t* frame = &frames[index];
+    frame_t* head = &colourLists[PAGE_COLOUR(FRAME_ADDR(index))];
+
+    frame->flags |= FRAME_COLOUR;
+    frame->next = head->next;
+    frame->prev = head;
+    head->next->prev = frame;
+    head->next = frame;
+    colourFrames++;
+}
+
+void ColourPut(paddr_t paddr)
+{
+    size_t index = FRAME_INDEX(paddr);
+    frame_t* frame;
+    uint32_t i;
+
+    ColourPush(index);
+
+    // Whole block free: merge it back so large allocations can use it
+    size_t first = index - PAGE_COLOUR(paddr);
+
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        if(!(frames[first + i].flags & FRAME_COLOUR))
+        {
+            return;
+        }
+    }
+
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        frame = &frames[first + i];
+        frame->prev->next = frame->next;
+        frame->next->prev = frame->prev;
+        frame->flags &= ~FRAME_COLOUR;
+    }
+
+    colourFrames -= PAGE_COLOURS;
+    BuddyFree(first, PAGE_COLOUR_ORDER);
+}
+
+void ZeroPush(size_t index)
+{
+    frame_t* frame = &frames[index];
+
+    frame->flags |= FRAME_ZERO;
+    frame->next = zeroList.next;
+    frame->prev = &zeroList;
+    zeroList.next->prev = frame;
+    zeroList.next = frame;
+    zeroFrames++;
+}
+
+paddr_t ZeroTake(void)
+{
+    frame_t* frame = zeroList.next;
+
+    if(frame == &zeroList)
+    {
+        return NULL;
+    }
+
+    frame->prev->next = frame->next;
+    frame->next->prev = frame->prev;
+    frame->flags &= ~FRAME_ZERO;
+    zeroFrames--;
+
+    return FRAME_ADDR(frame - frames);
+}
+
+bool_t ZeroDrain(void)
+{
+    paddr_t page;
+    bool_t drained = FALSE;
+
+    while((page = ZeroTake()) != NULL)
+    {
+        BuddyFree(FRAME_INDEX(page), 0);
+        drained = TRUE;
+    }
+
+    return drained;
+}
+
+void PageMapLogical(ulong_t start, ulong_t end)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    pgt_t pgt = MMU_P2L(MMU_KernelPGT());
+    ulong_t vaddr = (ulong_t)MMU_P2L((paddr_t)start);
+
+    if(start >= end)
+    {
+        return;
+    }
+
+    if(((vaddr ^ start) & (LARGE_SECTION_SIZE - 1)) == 0)
+    {
+        // Same alignment on both sides: let MMU_MapPages use 16Mb entries
+        pbv_t ram = {(ptr_t)start, end - start};
+        MMU_MapPages(pgt, (vaddr_t)vaddr, &ram, 1, &memCfg);
+    }
+    else
+    {
+        MMU_Map1MbPages((ulong_t*)pgt, start, vaddr, (end - start) / SECTION_SIZE, &memCfg);
+        asm volatile("dsb\n\tisb" ::: "memory");
+    }
+}
+
+/**
+ * PageInit Implementation (See header include/page.h file for description)
+*/
+int32_t PageInit(void)
+{
+    // Set in the linker script
+    extern ulong_t KernelVirtualBase;
+    extern ulong_t __image_end;
+    extern ulong_t __ddr_end;
+
+    const fdt_platform_t* platform = PlatformGet();
+
+    // The boot page table is placed at the RAM start
+    ulong_t ramStart = (ulong_t)MMU_L2P((vaddr_t)&KernelVirtualBase);
+    ulong_t imageEnd = ROUND_UP((ulong_t)MMU_L2P((vaddr_t)&__image_end), PAGE_SIZE);
+    uint32_t i;
+
+    ramEnd = ROUND_DOWN((ulong_t)MMU_L2P((vaddr_t)&__ddr_end), SECTION_SIZE);
+
+    // Device tree: the whole bank the kernel was loaded in
+    for(i = 0; i < platform->banks; ++i)
+    {
+        ulong_t base = (ulong_t)platform->memory[i].data;
+        ulong_t size = platform->memory[i].size;
+
+        if((ramStart >= base) && ((ramStart - base) < size))
+        {
+            size -= (ramStart - base);
+
+            if(size > PAGE_LOGICAL_MAX)
+            {
+                size = PAGE_LOGICAL_MAX;
+            }
+
+            // Bank ending at 4Gb
+            if(size > (~ramStart))
+            {
+                size = ~ramStart;
+            }
+
+            ramEnd = ROUND_DOWN(ramStart + size, SECTION_SIZE);
+            break;
+        }
+    }
+
+    // The boot code only maps the first sections (image included)
+    PageMapLogical(ROUND_UP(imageEnd, SECTION_SIZE), ramEnd);
+
+    basePfn = PFN(ramStart);
+    totalFrames = PFN(ramEnd) - basePfn;
+    freeFrames = 0;
+
+    // Frame descriptors go right after the image
+    frames = (frame_t*)MMU_P2L((paddr_t)imageEnd);
+    ulong_t reservedEnd = ROUND_UP(imageEnd + (totalFrames * sizeof(frame_t)), PAGE_SIZE);
+
+    if(reservedEnd >= ramEnd)
+    {
+        return E_NO_MEMORY;
+    }
+
+    for(i = 0; i <= PAGE_MAX_ORDER; ++i)
+    {
+        freeLists[i].next = freeLists[i].prev = &freeLists[i];
+    }
+
+    for(i = 0; i < totalFrames; ++i)
+    {
+        frames[i].flags = 0;
+        frames[i].order = 0;
+        frames[i].shares = 0;
+    }
+
+    for(i = 0; i < NR_CPUS; ++i)
+    {
+        PERCPU(pageCache, i).count = 0;
+    }
+
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        colourLists[i].next = colourLists[i].prev = &colourLists[i];
+    }
+    colourFrames = 0;
+
+    zeroList.next = zeroList.prev = &zeroList;
+    zeroFrames = 0;
+    zeroHits = zeroMisses = zeroAborts = 0;
+
+    // Boot page table, kernel image, frame descriptors and the device tree
+    // reserved ranges stay allocated
+    BuddyFreeAvailable(FRAME_INDEX(reservedEnd), totalFrames, platform->reserve, platform->reserved);
+
+    return E_OK;
+}
+
+/**
+ * PageLogicalEnd Implementation (See header include/page.h file for description)
+*/
+vaddr_t PageLogicalEnd(void)
+{
+    return MMU_P2L((paddr_t)ramEnd);
+}
+
+/**
+ * PageAlloc Implementation (See header include/page.h file for description)
+*/
+paddr_t PageAlloc(uint32_t order)
+{
+    if(order > PAGE_MAX_ORDER)
+    {
+        return NULL;
+    }
+
+    if(order != 0)
+    {
+        SpinLock(&zoneLock);
+        paddr_t block = BuddyAlloc(order);
+        SpinUnlock(&zoneLock);
+
+        return block;
+    }
+
+    paddr_t page = NULL;
+
+    // The cache belongs to the running CPU until preemption is enabled
+    PreemptDisable();
+
+    page_cache_t* cache = THIS_CPU_PTR(pageCache);
+
+    if(cache->count == 0)
+    {
+        // Refill in a batch to amortize the lock and buddy list operations
+        SpinLock(&zoneLock);
+
+        while(cache->count < PCP_BATCH)
+        {
+            paddr_t fresh = BuddyAlloc(0);
+
+            if(fresh == NULL)
+            {
+                break;
+            }
+
+            cache->pages[cache->count++] = fresh;
+        }
+
+        SpinUnlock(&zoneLock);
+    }
+
+    if(cache->count != 0)
+    {
+        page = cache->pages[--cache->count];
+    }
+
+    PreemptEnable();
+
+    return page;
+}
+
+/**
+ * PageFree Implementation (See header include/page.h file for description)
+*/
+void PageFree(paddr_t paddr, uint32_t order)
+{
+    if((paddr == NULL) || (order > PAGE_MAX_ORDER))
+    {
+        return;
+    }
+
+    if(order != 0)
+    {
+        SpinLock(&zoneLock);
+        BuddyFree(FRAME_INDEX(paddr), order);
+        SpinUnlock(&zoneLock);
+        return;
+    }
+
+    PreemptDisable();
+
+    page_cache_t* cache = THIS_CPU_PTR(pageCache);
+
+    if(cache->count == PCP_HIGH)
+    {
+        // Give a batch back so other CPUs and merges can use it
+        SpinLock(&zoneLock);
+
+        while(cache->count > (PCP_HIGH - PCP_BATCH))
+        {
+            BuddyFree(FRAME_INDEX(cache->pages[--cache->count]), 0);
+        }
+
+        SpinUnlock(&zoneLock);
+    }
+
+    cache->pages[cache->count++] = paddr;
+
+    PreemptEnable();
+}
+
+/**
+ * PageGet Implementation (See header include/page.h file for description)
+*/
+void PageGet(paddr_t paddr)
+{
+    SpinLock(&zoneLock);
+    frames[FRAME_INDEX(paddr)].shares++;
+    SpinUnlock(&zoneLock);
+}
+
+/**
+ * PagePut Implementation (See header include/page.h file for description)
+*/
+bool_t PagePut(paddr_t paddr)
+{
+    frame_t* frame = &frames[FRAME_INDEX(paddr)];
+    bool_t last;
+
+    SpinLock(&zoneLock);
+
+    last = (frame->shares == 0);
+
+    if(!last)
+    {
+        frame->shares--;
+    }
+
+    SpinUnlock(&zoneLock);
+
+    if(last)
+    {
+        PageFree(paddr, 0);
+    }
+
+    return last;
+}
+
+/**
+ * PageShares Implementation (See header include/page.h file for description)
+*/
+uint32_t PageShares(paddr_t paddr)
+{
+    return READ_ONCE(frames[FRAME_INDEX(paddr)].shares);
+}
+
+/**
+ * PageAllocVector Implementation (See header include/page.h file for description)
+*/
+size_t PageAllocVector(size_t size, pbv_t* pages, size_t max)
+{
+    size_t left = ROUND_UP(size, PAGE_SIZE) / PAGE_SIZE;
+    size_t count = 0;
+    uint32_t granule = 0;
+
+    while((left != 0) && (granule < sizeof(VectorOrders)))
+    {
+        uint32_t order = VectorOrders[granule];
+        size_t blockSize = (PAGE_SIZE << order);
+
+        if(left < (1 << order))
+        {
+            granule++;
+            continue;
+        }
+
+        paddr_t block = PageAlloc(order);
+
+        if(block == NULL)
+        {
+            // Fragmented: build the remaining size from smaller blocks
+            granule++;
+            continue;
+        }
+
+        if((count != 0) && (((ulong_t)pages[count - 1].data + pages[count - 1].size) == (ulong_t)block))
+        {
+            // Physically contiguous with the previous chunk
+            pages[count - 1].size += blockSize;
+        }
+        else if(count < max)
+        {
+            pages[count].data = block;
+            pages[count].size = blockSize;
+            count++;
+        }
+        else
+        {
+            PageFree(block, order);
+            break;
+        }
+
+        left -= (1 << order);
+    }
+
+    if(left != 0)
+    {
+        PageFreeVector(pages, count);
+        return 0;
+    }
+
+    return count;
+}
+
+/**
+ * PageFreeVector Implementation (See header include/page.h file for description)
+*/
+void PageFreeVector(pbv_t* pages, size_t count)
+{
+    size_t i;
+
+    SpinLock(&zoneLock);
+
+    for(i = 0; i < count; ++i)
+    {
+        size_t start = FRAME_INDEX(pages[i].data);
+        BuddyFreeRange(start, start + (pages[i].size / PAGE_SIZE));
+    }
+
+    SpinUnlock(&zoneLock);
+}
+
+/**
+ * PageColoursInit Implementation (See header include/page.h file for description)
+*/
+int32_t PageColoursInit(page_colours_t* colours, uint32_t mask, size_t budget)
+{
+    uint8_t allowed[PAGE_COLOURS];
+    uint32_t i, count = 0;
+
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        if(mask & (1 << i))
+        {
+            allowed[count++] = i;
+        }
+    }
+
+    if(count == 0)
+    {
+        return E_INVAL;
+    }
+
+    colours->mask = mask & PAGE_COLOURS_ALL;
+    colours->budget = budget;
+    colours->used = 0;
+
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        colours->map[i] = allowed[i % count];
+    }
+
+    return E_OK;
+}
+
+/**
+ * PageAllocColoured Implementation (See header include/page.h file for description)
+*/
+paddr_t PageAllocColoured(page_colours_t* colours, vaddr_t vaddr)
+{
+    uint32_t hint = PAGE_COLOUR(vaddr);
+    uint32_t i;
+
+    if((colours->budget != 0) && (colours->used >= colours->budget))
+    {
+        return NULL;
+    }
+
+    // Preferred colour first, then the other allowed colours
+    for(i = 0; i < PAGE_COLOURS; ++i)
+    {
+        uint32_t colour = colours->map[(hint + i) & (PAGE_COLOURS - 1)];
+
+        if((i != 0) && (colour == colours->map[hint]))
+        {
+            continue;
+        }
+
+        SpinLock(&zoneLock);
+        paddr_t page = ColourTake(colour);
+        SpinUnlock(&zoneLock);
+
+        if(page != NULL)
+        {
+            colours->used++;
+            return page;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * PageFreeColoured Implementation (See header include/page.h file for description)
+*/
+void PageFreeColoured(page_colours_t* colours, paddr_t paddr)
+{
+    if(paddr == NULL)
+    {
+        return;
+    }
+
+    colours->used--;
+
+    SpinLock(&zoneLock);
+    ColourPut(paddr);
+    SpinUnlock(&zoneLock);
+}
+
+/**
+ * PageAllocVectorColoured Implementation (See header include/page.h file for description)
+*/
+size_t PageAllocVectorColoured(page_colours_t* colours, vaddr_t vaddr, size_t size, pbv_t* pages, size_t max)
+{
+    size_t left = ROUND_UP(size, PAGE_SIZE) / PAGE_SIZE;
+    ulong_t va = (ulong_t)vaddr;
+    size_t count = 0;
+
+    for(; left != 0; --left, va += PAGE_SIZE)
+    {
+        paddr_t page = PageAllocColoured(colours, (vaddr_t)va);
+
+        if(page == NULL)
+        {
+            break;
+        }
+
+        // Contiguous runs are merged up to a colour block only: the virtual
+        // and physical addresses agree modulo 64Kb and no further, so a
+        // larger chunk would be given a 1Mb or 16Mb granule it cannot use
+        if((count != 0) && (((ulong_t)pages[count - 1].data + pages[count - 1].size) == (ulong_t)page) &&
+           ((ulong_t)page & ((PAGE_SIZE << PAGE_COLOUR_ORDER) - 1)))
+        {
+            pages[count - 1].size += PAGE_SIZE;
+        }
+        else if(count < max)
+        {
+            pages[count].data = page;
+            pages[count].size = PAGE_SIZE;
+            count++;
+        }
+        else
+        {
+            PageFreeColoured(colours, page);
+            break;
+        }
+    }
+
+    if(left != 0)
+    {
+        PageFreeVectorColoured(colours, pages, count);
+        return 0;
+    }
+
+    return count;
+}
+
+/**
+ * PageFreeVectorColoured Implementation (See header include/page.h file for description)
+*/
+void PageFreeVectorColoured(page_colours_t* colours, pbv_t* pages, size_t count)
+{
+    size_t i, offset;
+    for(i = 0; i < count; ++i)
+    {
+        for(offset = 0; offset < pages[i].size; offset += PAGE_SIZE)
+        {
+            PageFreeColoured(colours, (paddr_t)((ulong_t)pages[i].data + offset));
+        }
+    }
+}
+
+/**
+ * PageAllocZeroed Implementation (See header include/page.h file for description)
+*/
+paddr_t PageAllocZeroed(void)
+{
+    SpinLock(&zoneLock);
+
+    paddr_t page = ZeroTake();
+
+    if(page != NULL)
+    {
+        zeroHits++;
+    }
+    else
+    {
+        zeroMisses++;
+    }
+
+    SpinUnlock(&zoneLock);
+
+    if(page == NULL)
+    {
+        page = PageAlloc(0);
+
+        if(page != NULL)
+        {
+            memset(MMU_P2L(page), 0, PAGE_SIZE);
+        }
+    }
+
+    return page;
+}
+
+/**
+ * PageZeroIdle Implementation (See header include/page.h file for description)
+*/
+bool_t PageZeroIdle(volatile uint32_t* work)
+{
+    paddr_t page = NULL;
+    size_t done;
+
+    if(READ_ONCE(zeroFrames) >= PAGE_ZERO_HIGH)
+    {
+        return FALSE;
+    }
+
+    SpinLock(&zoneLock);
+
+    if((zeroFrames < PAGE_ZERO_HIGH) && (freeFrames > ZERO_FREE_MIN))
+    {
+        page = BuddyAlloc(0);
+    }
+
+    SpinUnlock(&zoneLock);
+
+    if(page == NULL)
+    {
+        return FALSE;
+    }
+
+#ifdef STRING_NEON
+    if(!VfpKernelBegin())
+    {
+        PageFree(page, 0);
+        return FALSE;
+    }
+#endif
+
+    // A few cache lines at a time, so arriving work waits for one chunk at most
+    uint8_t* data = (uint8_t*)MMU_P2L(page);
+
+    for(done = 0; (done < PAGE_SIZE) && (READ_ONCE(*work) == 0); done += ZERO_CHUNK)
+    {
+        memzero_stream(data + done, ZERO_CHUNK);
+    }
+
+#ifdef STRING_NEON
+    VfpKernelEnd();
+#endif
+
+    SpinLock(&zoneLock);
+
+    if(done == PAGE_SIZE)
+    {
+        ZeroPush(FRAME_INDEX(page));
+    }
+    else
+    {
+        BuddyFree(FRAME_INDEX(page), 0);
+        zeroAborts++;
+    }
+
+    SpinUnlock(&zoneLock);
+
+    return (done == PAGE_SIZE);
+}
+
+/**
+ * PageStats Implementation (See header include/page.h file for description)
+*/
+void PageStats(page_stats_t* stats)
+{
+    uint32_t i;
+
+    SpinLock(&zoneLock);
+
+    stats->totalPages = totalFrames;
+    stats->freePages = freeFrames;
+    stats->cachedPages = 0;
+    stats->colouredPages = colourFrames;
+    stats->zeroedPages = zeroFrames;
+    stats->zeroHits = zeroHits;
+    stats->zeroMisses = zeroMisses;
+    stats->zeroAborts = zeroAborts;
+
+    for(i = 0; i < NR_CPUS; ++i)
+    {
+        stats->cachedPages += PERCPU(pageCache, i).count;
+    }
+
+    for(i = 0; i <= PAGE_MAX_ORDER; ++i)
+    {
+        frame_t* frame;
+        stats->freeBlocks[i] = 0;
+
+        for(frame = freeLists[i].next; frame != &freeLists[i]; frame = frame->next)
+        {
+            stats->freeBlocks[i]++;
+        }
+    }
+
+    SpinUnlock(&zoneLock);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file        percpu.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Per-CPU Data Areas
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <percpu.h>
+#include <string.h>
+
+
+/* Private constants -------------------------------------- */
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+
+/* Private variables -------------------------------------- */
+
+// Area offsets from the per-CPU section (CPU 0 uses the section in place)
+static ulong_t percpuOffsets[NR_CPUS];
+
+
+/* Private function prototypes ---------------------------- */
+
+
+/* Private functions -------------------------------------- */
+
+/**
+ * PercpuInit Implementation (See header include/percpu.h file for description)
+*/
+int32_t PercpuInit(void)
+{
+    // Set in the linker script
+    extern uint8_t __percpu_start[];
+    extern uint8_t __percpu_end[];
+    extern uint8_t __percpu_areas[];
+    extern uint8_t __percpu_areas_end[];
+
+    // Section size is cache line aligned by the linker script
+    size_t size = __percpu_end - __percpu_start;
+    uint32_t cpu;
+
+    if((size * (NR_CPUS - 1)) > (size_t)(__percpu_areas_end - __percpu_areas))
+    {
+        return E_NO_RES;
+    }
+
+    percpuOffsets[0] = 0;
+
+    for(cpu = 1; cpu < NR_CPUS; ++cpu)
+    {
+        uint8_t* area = __percpu_areas + ((cpu - 1) * size);
+
+        memcpy(area, __percpu_start, size);
+        percpuOffsets[cpu] = area - __percpu_start;
+    }
+
+    return E_OK;
+}
+
+/**
+ * PercpuCpuInit Implementation (See header include/percpu.h file for description)
+*/
+void PercpuCpuInit(void)
+{
+    CPU_SetPercpuOffset(percpuOffsets[CPU_Id()]);
+}
+
+/**
+ * PercpuOffset Implementation (See header include/percpu.h file for description)
+*/
+ulong_t PercpuOffset(uint32_t cpu)
+{
+    return percpuOffsets[cpu];
+}
@@ -0,0 +1,569 @@
+/**
+ * @file        slab.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Fixed-size Kernel Object Allocator (Slab with per-CPU caches)
+ *
+ *              Objects are carved from slabs of 2^order pages taken from the
+ *              page allocator. The slab header (and its free index stack) is
+ *              placed at the start of the slab, so the slab of an object is
+ *              found by aligning its address down to the slab size. Free
+ *              objects are tracked by index, never by writing into them, so
+ *              constructed objects keep their state while cached.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <slab.h>
+#include <page.h>
+#include <mmu.h>
+#include <misc.h>
+#include <cpu.h>
+#include <spinlock.h>
+#include <sched.h>
+
+
+/* Private constants -------------------------------------- */
+
+// Per-CPU cache capacity and objects moved from/to the slabs at once
+#define SLAB_MAGAZINE_SIZE  (16)
+#define SLAB_BATCH          (8)
+
+// Largest slab (2^order pages)
+#define SLAB_MAX_ORDER      (3)
+
+// Empty slabs kept per cache before returning pages to the page allocator
+#define SLAB_KEEP_EMPTY     (1)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct slab_link
+{
+    struct slab_link* next;
+    struct slab_link* prev;
+}slab_link_t;
+
+// Slab header (start of the slab)
+typedef struct
+{
+    slab_link_t link;
+    uint16_t    freeCount;
+    uint16_t    free[];                 // Stack of free object indexes
+}slab_t;
+
+// Per-CPU object cache, one cache line aligned block per CPU
+typedef struct
+{
+    uint32_t count;
+    uint32_t allocs;
+    uint32_t allocHits;
+    uint32_t frees;
+    uint32_t freeHits;
+    void*    objects[SLAB_MAGAZINE_SIZE];
+}__attribute__((aligned(CACHE_LINE_SIZE))) slab_cpu_t;
+
+struct slab_cache
+{
+    slab_cpu_t  cpus[NR_CPUS];
+    const char* name;
+    size_t      objectSize;
+    uint32_t    order;
+    uint32_t    objectsPerSlab;
+    uint32_t    objectsOffset;          // First object offset in the slab
+    slab_ctor_t ctor;
+    spinlock_t  lock;                   // Slab lists and counters below
+    slab_link_t partial;
+    slab_link_t full;
+    slab_link_t empty;
+    uint32_t    slabs;
+    uint32_t    emptySlabs;
+    uint32_t    objectsInUse;           // Objects out of the slabs
+};
+
+
+/* Private macros ----------------------------------------- */
+
+#define SLAB_SIZE(cache)        (PAGE_SIZE << (cache)->order)
+#define SLAB_OBJECT(cache, s, i) ((void*)((ulong_t)(s) + (cache)->objectsOffset + ((i) * (cache)->objectSize)))
+
+
+/* Private variables -------------------------------------- */
+
+// Cache used to allocate the cache descriptors
+static slab_cache_t cacheCache;
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Sets up a cache descriptor and selects the slab layout
+ * @param   cache - Cache descriptor
+ *          name - Cache name
+ *          size - Object size
+ *          align - Object alignment
+ *          ctor - Object constructor
+ * @retval  E_OK on success, E_INVAL if the object does not fit in a slab
+ */
+static int32_t SlabCacheSetup(slab_cache_t* cache, const char* name, size_t size, size_t align, slab_ctor_t ctor);
+
+/**
+ * @brief   Moves a slab to the list matching its free objects
+ * @param   cache - Object cache
+ *          slab - Slab to move
+ * @retval  No return
+ */
+static void SlabRelink(slab_cache_t* cache, slab_t* slab);
+
+/**
+ * @brief   Allocates and constructs a new slab
+ * @param   cache - Object cache
+ * @retval  New slab (in the empty list), NULL if out of memory
+ */
+static slab_t* SlabGrow(slab_cache_t* cache);
+
+/**
+ * @brief   Returns a slab to the page allocator
+ * @param   cache - Object cache
+ *          slab - Empty slab
+ * @retval  No return
+ */
+static void SlabRelease(slab_cache_t* cache, slab_t* slab);
+
+/**
+ * @brief   Takes an object from the shared slabs
+ * @param   cache - Object cache
+ * @retval  Object, NULL if out of memory
+ */
+static void* SlabTake(slab_cache_t* cache);
+
+/**
+ * @brief   Returns an object to its slab
+ * @param   cache - Object cache
+ *          object - Object
+ * @retval  No return
+ */
+static void SlabPut(slab_cache_t* cache, void* object);
+
+/**
+ * @brief   Returns every object held by the per-CPU caches to the slabs
+ * @param   cache - Object cache
+ * @retval  No return
+ */
+static void SlabFlush(slab_cache_t* cache);
+
+
+/* Private functions -------------------------------------- */
+
+int32_t SlabCacheSetup(slab_cache_t* cache, const char* name, size_t size, size_t align, slab_ctor_t ctor)
+{
+    uint32_t i, order, count = 0;
+
+    if(align == SLAB_ALIGN_DEFAULT)
+    {
+        align = CACHE_LINE_SIZE;
+    }
+
+    if((size == 0) || (align & (align - 1)))
+    {
+        return E_INVAL;
+    }
+
+    if(align < sizeof(ulong_t))
+    {
+        align = sizeof(ulong_t);
+    }
+
+    cache->objectSize = ROUND_UP(size, align);
+
+    // Smallest slab wasting at most 1/8 of its size
+    for(order = 0; order <= SLAB_MAX_ORDER; ++order)
+    {
+        size_t slabSize = PAGE_SIZE << order;
+
+        count = (slabSize - sizeof(slab_t)) / (cache->objectSize + sizeof(uint16_t));
+
+        while((count != 0) && ((ROUND_UP(sizeof(slab_t) + count * sizeof(uint16_t), align) + count * cache->objectSize) > slabSize))
+        {
+            count--;
+        }
+
+        if((count != 0) && ((slabSize - count * cache->objectSize) * 8 <= slabSize))
+        {
+            break;
+        }
+    }
+
+    if(order > SLAB_MAX_ORDER)
+    {
+        order = SLAB_MAX_ORDER;
+    }
+
+    if(count == 0)
+    {
+        return E_INVAL;
+    }
+
+    cache->name = name;
+    cache->order = order;
+    cache->objectsPerSlab = count;
+    cache->objectsOffset = ROUND_UP(sizeof(slab_t) + count * sizeof(uint16_t), align);
+    cache->ctor = ctor;
+    SpinLockInit(&cache->lock, name);
+    cache->partial.next = cache->partial.prev = &cache->partial;
+    cache->full.next = cache->full.prev = &cache->full;
+    cache->empty.next = cache->empty.prev = &cache->empty;
+    cache->slabs = 0;
+    cache->emptySlabs = 0;
+    cache->objectsInUse = 0;
+
+    for(i = 0; i < NR_CPUS; ++i)
+    {
+        cache->cpus[i].count = 0;
+        cache->cpus[i].allocs = 0;
+        cache->cpus[i].allocHits = 0;
+        cache->cpus[i].frees = 0;
+        cache->cpus[i].freeHits = 0;
+    }
+
+    return E_OK;
+}
+
+void SlabRelink(slab_cache_t* cache, slab_t* slab)
+{
+    slab_link_t* list;
+
+    if(slab->freeCount == 0)
+    {
+        list = &cache->full;
+    }
+    else if(slab->freeCount == cache->objectsPerSlab)
+    {
+        list = &cache->empty;
+    }
+    else
+    {
+        list = &cache->partial;
+    }
+
+    // Unlink
+    slab->link.prev->next = slab->link.next;
+    slab->link.next->prev = slab->link.prev;
+
+    // Insert at the list head
+    slab->link.next = list->next;
+    slab->link.prev = list;
+    list->next->prev = &slab->link;
+    list->next = &slab->link;
+}
+
+slab_t* SlabGrow(slab_cache_t* cache)
+{
+    paddr_t block = PageAlloc(cache->order);
+
+    if(block == NULL)
+    {
+        return NULL;
+    }
+
+    slab_t* slab = (slab_t*)MMU_P2L(block);
+    uint32_t i;
+
+    // Lowest addresses are handed out first
+    slab->freeCount = cache->objectsPerSlab;
+    for(i = 0; i < cache->objectsPerSlab; ++i)
+    {
+        slab->free[i] = cache->objectsPerSlab - 1 - i;
+    }
+
+    if(cache->ctor != NULL)
+    {
+        for(i = 0; i < cache->objectsPerSlab; ++i)
+        {
+            cache->ctor(SLAB_OBJECT(cache, slab, i));
+        }
+    }
+
+    slab->link.next = cache->empty.next;
+    slab->link.prev = &cache->empty;
+    cache->empty.next->prev = &slab->link;
+    cache->empty.next = &slab->link;
+
+    cache->slabs++;
+    cache->emptySlabs++;
+
+    return slab;
+}
+
+void SlabRelease(slab_cache_t* cache, slab_t* slab)
+{
+    slab->link.prev->next = slab->link.next;
+    slab->link.next->prev = slab->link.prev;
+
+    cache->slabs--;
+    cache->emptySlabs--;
+
+    PageFree(MMU_L2P((vaddr_t)slab), cache->order);
+}
+
+void* SlabTake(slab_cache_t* cache)
+{
+    slab_t* slab;
+
+    // Fill partial slabs first so empty ones can be given back
+    if(cache->partial.next != &cache->partial)
+    {
+        slab = (slab_t*)cache->partial.next;
+    }
+    else if(cache->empty.next != &cache->empty)
+    {
+        slab = (slab_t*)cache->empty.next;
+    }
+    else if((slab = SlabGrow(cache)) == NULL)
+    {
+        return NULL;
+    }
+
+    if(slab->freeCount == cache->objectsPerSlab)
+    {
+        cache->emptySlabs--;
+    }
+
+    uint16_t index = slab->free[--slab->freeCount];
+
+    if((slab->freeCount == 0) || (slab->freeCount == cache->objectsPerSlab - 1))
+    {
+        SlabRelink(cache, slab);
+    }
+
+    cache->objectsInUse++;
+
+    return SLAB_OBJECT(cache, slab, index);
+}
+
+void SlabPut(slab_cache_t* cache, void* object)
+{
+    slab_t* slab = (slab_t*)ROUND_DOWN((ulong_t)object, SLAB_SIZE(cache));
+    uint16_t index = ((ulong_t)object - (ulong_t)slab - cache->objectsOffset) / cache->objectSize;
+
+    slab->free[slab->freeCount++] = index;
+    cache->objectsInUse--;
+
+    if((slab->freeCount == 1) || (slab->freeCount == cache->objectsPerSlab))
+    {
+        SlabRelink(cache, slab);
+    }
+
+    if(slab->freeCount == cache->objectsPerSlab)
+    {
+        cache->emptySlabs++;
+
+        if(cache->emptySlabs > SLAB_KEEP_EMPTY)
+        {
+            SlabRelease(cache, slab);
+        }
+    }
+}
+
+void SlabFlush(slab_cache_t* cache)
+{
+    uint32_t i;
+
+    SpinLock(&cache->lock);
+
+    for(i = 0; i < NR_CPUS; ++i)
+    {
+        slab_cpu_t* cpu = &cache->cpus[i];
+
+        while(cpu->count != 0)
+        {
+            SlabPut(cache, cpu->objects[--cpu->count]);
+        }
+    }
+
+    SpinUnlock(&cache->lock);
+}
+
+/**
+ * SlabInit Implementation (See header include/slab.h file for description)
+*/
+int32_t SlabInit(void)
+{
+    return SlabCacheSetup(&cacheCache, "slab_cache", sizeof(slab_cache_t), SLAB_ALIGN_DEFAULT, NULL);
+}
+
+/**
+ * SlabCacheCreate Implementation (See header include/slab.h file for description)
+*/
+slab_cache_t* SlabCacheCreate(const char* name, size_t size, size_t align, slab_ctor_t ctor)
+{
+    slab_cache_t* cache = SlabAlloc(&cacheCache);
+
+    if(cache == NULL)
+    {
+        return NULL;
+    }
+
+    if(SlabCacheSetup(cache, name, size, align, ctor) != E_OK)
+    {
+        SlabFree(&cacheCache, cache);
+        return NULL;
+    }
+
+    return cache;
+}
+
+/**
+ * SlabCacheDestroy Implementation (See header include/slab.h file for description)
+*/
+int32_t SlabCacheDestroy(slab_cache_t* cache)
+{
+    // No CPU may be using the cache at this point
+    SlabFlush(cache);
+
+    if(cache->objectsInUse != 0)
+    {
+        return E_BUSY;
+    }
+
+    while(cache->empty.next != &cache->empty)
+    {
+        SlabRelease(cache, (slab_t*)cache->empty.next);
+    }
+
+    SlabFree(&cacheCache, cache);
+
+    return E_OK;
+}
+
+/**
+ * SlabAlloc Implementation (See header include/slab.h file for description)
+*/
+void* SlabAlloc(slab_cache_t* cache)
+{
+    void* object = NULL;
+
+    // Fast path: only the running CPU touches its cache (no migration
+    // while preemption is disabled)
+    PreemptDisable();
+
+    slab_cpu_t* cpu = &cache->cpus[CPU_Id()];
+
+    cpu->allocs++;
+
+    if(cpu->count != 0)
+    {
+        cpu->allocHits++;
+        object = cpu->objects[--cpu->count];
+
+        PreemptEnable();
+        return object;
+    }
+
+    // Slow path: refill from the shared slabs
+    SpinLock(&cache->lock);
+
+    while(cpu->count < SLAB_BATCH)
+    {
+        void* fresh = SlabTake(cache);
+
+        if(fresh == NULL)
+        {
+            break;
+        }
+
+        cpu->objects[cpu->count++] = fresh;
+    }
+
+    SpinUnlock(&cache->lock);
+
+    if(cpu->count != 0)
+    {
+        object = cpu->objects[--cpu->count];
+    }
+
+    PreemptEnable();
+
+    return object;
+}
+
+/**
+ * SlabFree Implementation (See header include/slab.h file for description)
+*/
+void SlabFree(slab_cache_t* cache, void* object)
+{
+    slab_cpu_t* cpu;
+    uint32_t i;
+
+    if(object == NULL)
+    {
+        return;
+    }
+
+    PreemptDisable();
+
+    cpu = &cache->cpus[CPU_Id()];
+
+    cpu->frees++;
+
+    if(cpu->count == SLAB_MAGAZINE_SIZE)
+    {
+        // Give back the coldest objects, keeping the recently used ones
+        SpinLock(&cache->lock);
+
+        for(i = 0; i < SLAB_BATCH; ++i)
+        {
+            SlabPut(cache, cpu->objects[i]);
+        }
+
+        SpinUnlock(&cache->lock);
+
+        for(i = SLAB_BATCH; i < SLAB_MAGAZINE_SIZE; ++i)
+        {
+            cpu->objects[i - SLAB_BATCH] = cpu->objects[i];
+        }
+
+        cpu->count -= SLAB_BATCH;
+    }
+    else
+    {
+        cpu->freeHits++;
+    }
+
+    cpu->objects[cpu->count++] = object;
+
+    PreemptEnable();
+}
+
+/**
+ * SlabStats Implementation (See header include/slab.h file for description)
+*/
+void SlabStats(slab_cache_t* cache, slab_stats_t* stats)
+{
+    uint32_t i;
+
+    stats->name = cache->name;
+    stats->objectSize = cache->objectSize;
+    stats->objectsPerSlab = cache->objectsPerSlab;
+
+    SpinLock(&cache->lock);
+    stats->slabs = cache->slabs;
+    stats->objectsInUse = cache->objectsInUse;
+    SpinUnlock(&cache->lock);
+
+    stats->cachedObjects = 0;
+    stats->allocs = 0;
+    stats->allocHits = 0;
+    stats->frees = 0;
+    stats->freeHits = 0;
+
+    for(i = 0; i < NR_CPUS; ++i)
+    {
+        stats->cachedObjects += cache->cpus[i].count;
+        stats->allocs += cache->cpus[i].allocs;
+        stats->allocHits += cache->cpus[i].allocHits;
+        stats->frees += cache->cpus[i].frees;
+        stats->freeHits += cache->cpus[i].freeHits;
+    }
+}
@@ -0,0 +1,333 @@
+/**
+ * @file        spinlock.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Ticket and MCS Spinlocks
+ *
+ *              Waiters sleep in WFE: the ticket lock wakes them with SEV on
+ *              release and the MCS lock hands over with a store to the
+ *              waiter node followed by SEV.
+ *
+ *              Preemption is disabled while a lock is held: a holder
+ *              switched out would keep every waiter spinning.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <spinlock.h>
+#include <atomic.h>
+#include <sched.h>
+#include <pmu.h>
+
+
+/* Private constants -------------------------------------- */
+
+#define TICKET_SHIFT        (16)
+#define TICKET_MASK         (0xFFFF)
+
+
+/* Private types ------------------------------------------ */
+
+
+/* Private macros ----------------------------------------- */
+
+#define TICKET_OWNER(t)     ((t) & TICKET_MASK)
+#define TICKET_NEXT(t)      ((t) >> TICKET_SHIFT)
+
+
+/* Private variables -------------------------------------- */
+
+
+/* Private function prototypes ---------------------------- */
+
+#ifdef LOCK_STATS
+/**
+ * @brief   Records an acquisition. Called with the lock held
+ * @param   stats - Lock statistics
+ *          holdStart - Lock hold start (cycle count)
+ *          waitStart - Cycle count before waiting
+ *          contended - TRUE if the lock had to be waited for
+ * @retval  No return
+ */
+static void LockStatsAcquired(lock_stats_t* stats, uint32_t* holdStart, uint32_t waitStart, bool_t contended);
+
+/**
+ * @brief   Records a release. Called with the lock held
+ * @param   stats - Lock statistics
+ *          holdStart - Lock hold start (cycle count)
+ * @retval  No return
+ */
+static void LockStatsReleased(lock_stats_t* stats, uint32_t holdStart);
+#endif
+
+
+/* Private functions -------------------------------------- */
+
+#ifdef LOCK_STATS
+void LockStatsAcquired(lock_stats_t* stats, uint32_t* holdStart, uint32_t waitStart, bool_t contended)
+{
+    *holdStart = pmu_get_cyclecount();
+
+    stats->acquisitions++;
+
+    if(contended)
+    {
+        stats->contended++;
+        stats->waitCycles += *holdStart - waitStart;
+    }
+}
+
+void LockStatsReleased(lock_stats_t* stats, uint32_t holdStart)
+{
+    uint32_t hold = pmu_get_cyclecount() - holdStart;
+
+    stats->holdCycles += hold;
+
+    if(hold > stats->maxHoldCycles)
+    {
+        stats->maxHoldCycles = hold;
+    }
+}
+#endif
+
+/**
+ * SpinLockInit Implementation (See header include/spinlock.h file for description)
+*/
+void SpinLockInit(spinlock_t* lock, const char* name)
+{
+    lock->tickets = 0;
+
+#ifdef LOCK_STATS
+    lock->name = name;
+    lock->holdStart = 0;
+    lock->stats = (lock_stats_t){0};
+#else
+    (void)name;
+#endif
+}
+
+/**
+ * SpinLock Implementation (See header include/spinlock.h file for description)
+*/
+void SpinLock(spinlock_t* lock)
+{
+#ifdef LOCK_STATS
+    uint32_t waitStart = pmu_get_cyclecount();
+#endif
+    uint32_t tickets, ticket;
+    bool_t contended;
+
+    PreemptDisable();
+
+    tickets = Atomic_FetchAdd32(&lock->tickets, (1 << TICKET_SHIFT));
+    ticket = TICKET_NEXT(tickets);
+    contended = (TICKET_OWNER(tickets) != ticket);
+
+    if(contended)
+    {
+        while(TICKET_OWNER(READ_ONCE(lock->tickets)) != ticket)
+        {
+            wfe();
+        }
+    }
+
+    smp_mb();
+
+#ifdef LOCK_STATS
+    LockStatsAcquired(&lock->stats, &lock->holdStart, waitStart, contended);
+#else
+    (void)contended;
+#endif
+}
+
+/**
+ * SpinTryLock Implementation (See header include/spinlock.h file for description)
+*/
+bool_t SpinTryLock(spinlock_t* lock)
+{
+    uint32_t tickets = READ_ONCE(lock->tickets);
+
+    if(TICKET_OWNER(tickets) != TICKET_NEXT(tickets))
+    {
+        return FALSE;
+    }
+
+    PreemptDisable();
+
+    if(Atomic_CmpXchg32(&lock->tickets, tickets, tickets + (1 << TICKET_SHIFT)) != tickets)
+    {
+        PreemptEnable();
+        return FALSE;
+    }
+
+    smp_mb();
+
+#ifdef LOCK_STATS
+    LockStatsAcquired(&lock->stats, &lock->holdStart, 0, FALSE);
+#endif
+
+    return TRUE;
+}
+
+/**
+ * SpinUnlock Implementation (See header include/spinlock.h file for description)
+*/
+void SpinUnlock(spinlock_t* lock)
+{
+    volatile uint16_t* owner = (volatile uint16_t*)&lock->tickets;
+
+#ifdef LOCK_STATS
+    LockStatsReleased(&lock->stats, lock->holdStart);
+#endif
+
+    smp_mb();
+
+    // Only the holder changes the owner half: a halfword store is enough
+    // and it clears the exclusive monitors of CPUs taking a ticket
+    *owner = (uint16_t)(*owner + 1);
+
+    sev();
+
+    PreemptEnable();
+}
+
+/**
+ * SpinLockIrqSave Implementation (See header include/spinlock.h file for description)
+*/
+uint32_t SpinLockIrqSave(spinlock_t* lock)
+{
+    uint32_t flags = CPU_IrqSave();
+
+    SpinLock(lock);
+
+    return flags;
+}
+
+/**
+ * SpinUnlockIrqRestore Implementation (See header include/spinlock.h file for description)
+*/
+void SpinUnlockIrqRestore(spinlock_t* lock, uint32_t flags)
+{
+    SpinUnlock(lock);
+    CPU_IrqRestore(flags);
+}
+
+/**
+ * McsLockInit Implementation (See header include/spinlock.h file for description)
+*/
+void McsLockInit(mcs_lock_t* lock, const char* name)
+{
+    lock->tail = NULL;
+
+#ifdef LOCK_STATS
+    lock->name = name;
+    lock->holdStart = 0;
+    lock->stats = (lock_stats_t){0};
+#else
+    (void)name;
+#endif
+}
+
+/**
+ * McsLock Implementation (See header include/spinlock.h file for description)
+*/
+void McsLock(mcs_lock_t* lock, mcs_node_t* node)
+{
+#ifdef LOCK_STATS
+    uint32_t waitStart = pmu_get_cyclecount();
+#endif
+    mcs_node_t* prev;
+
+    PreemptDisable();
+
+    node->next = NULL;
+    node->locked = FALSE;
+
+    // The node must be initialized before it is visible to other CPUs
+    smp_mb();
+
+    prev = Atomic_XchgPtr((void* volatile*)&lock->tail, node);
+
+    if(prev != NULL)
+    {
+        WRITE_ONCE(prev->next, node);
+
+        while(!READ_ONCE(node->locked))
+        {
+            wfe();
+        }
+    }
+
+    smp_mb();
+
+#ifdef LOCK_STATS
+    LockStatsAcquired(&lock->stats, &lock->holdStart, waitStart, (prev != NULL));
+#endif
+}
+
+/**
+ * McsUnlock Implementation (See header include/spinlock.h file for description)
+*/
+void McsUnlock(mcs_lock_t* lock, mcs_node_t* node)
+{
+    mcs_node_t* next;
+
+#ifdef LOCK_STATS
+    LockStatsReleased(&lock->stats, lock->holdStart);
+#endif
+
+    smp_mb();
+
+    if((next = READ_ONCE(node->next)) == NULL)
+    {
+        // No waiter: release the lock
+        if(Atomic_CmpXchgPtr((void* volatile*)&lock->tail, node, NULL) == node)
+        {
+            PreemptEnable();
+            return;
+        }
+
+        // A waiter swapped the tail but has not linked its node yet
+        while((next = READ_ONCE(node->next)) == NULL)
+        {
+            barrier();
+        }
+    }
+
+    WRITE_ONCE(next->locked, TRUE);
+
+    sev();
+
+    PreemptEnable();
+}
+
+/**
+ * SpinLockStats Implementation (See header include/spinlock.h file for description)
+*/
+int32_t SpinLockStats(spinlock_t* lock, lock_stats_t* stats)
+{
+#ifdef LOCK_STATS
+    *stats = lock->stats;
+    return E_OK;
+#else
+    (void)lock;
+    (void)stats;
+    return E_NO_RES;
+#endif
+}
+
+/**
+ * McsLockStats Implementation (See header include/spinlock.h file for description)
+*/
+int32_t McsLockStats(mcs_lock_t* lock, lock_stats_t* stats)
+{
+#ifdef LOCK_STATS
+    *stats = lock->stats;
+    return E_OK;
+#else
+    (void)lock;
+    (void)stats;
+    return E_NO_RES;
+#endif
+}
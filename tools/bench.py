@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Collect in-kernel benchmark results from a QEMU vexpress-a9 run.
+
+Build the kernel with benchmarks enabled for the QEMU machine:
+
+    make BOARD_CONFIG=ve-a9-qemu.config BENCHMARKS=1 release
+
+then run:
+
+    tools/bench.py run -o results.json
+    tools/bench.py compare baseline.json results.json
+
+The kernel prints one "@bench" line per measurement between "@bench-begin"
+and "@bench-end" (see include/bench.h). Lines are parsed as key=value pairs.
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+import time
+
+DEFAULT_ELF = "bin/ve-a9-ukernel.elf"
+
+
+def parse_line(line):
+    fields = {}
+    for token in line.split()[1:]:
+        key, _, value = token.partition("=")
+        if value.isdigit():
+            value = int(value)
+        fields[key] = value
+    return fields
+
+
+def parse(lines):
+    header, results = None, []
+    for line in lines:
+        line = line.strip()
+        if line.startswith("@bench-begin"):
+            header, results = parse_line(line), []
+        elif line.startswith("@bench-end"):
+            return header, results
+        elif line.startswith("@bench ") and header is not None:
+            result = parse_line(line)
+            if result.get("units"):
+                result["med_per_unit"] = result["med"] / result["units"]
+            if result.get("med"):
+                result["units_per_cycle"] = result["units"] / result["med"]
+            results.append(result)
+    raise RuntimeError("incomplete benchmark output (no @bench-end)")
+
+
+def run_qemu(args):
+    cmd = [args.qemu, "-M", "vexpress-a9", "-m", args.memory, "-smp", str(args.smp),
+           "-nographic", "-monitor", "none", "-serial", "stdio", "-kernel", args.elf]
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True, errors="replace")
+    lines, deadline = [], time.time() + args.timeout
+    try:
+        for line in proc.stdout:
+            lines.append(line)
+            if args.verbose:
+                sys.stderr.write(line)
+            if line.strip().startswith("@bench-end") or time.time() > deadline:
+                break
+    finally:
+        proc.kill()
+        proc.wait()
+    return lines
+
+
+def cmd_run(args):
+    lines = open(args.log).readlines() if args.log else run_qemu(args)
+    header, results = parse(lines)
+    report = {"header": header, "results": results}
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as out:
+            out.write(text + "\n")
+    else:
+        print(text)
+    return 0
+
+
+def cmd_compare(args):
+    base = {r["name"]: r for r in json.load(open(args.baseline))["results"]}
+    new = {r["name"]: r for r in json.load(open(args.current))["results"]}
+    regressions = 0
+    print("%-40s %12s %12s %8s" % ("name", "base med", "new med", "delta"))
+    for name in sorted(set(base) | set(new)):
+        if name not in base or name not in new:
+            print("%-40s %s" % (name, "only in " + ("current" if name in new else "baseline")))
+            continue
+        old, cur = base[name]["med"], new[name]["med"]
+        delta = (cur - old) * 100.0 / old if old else 0.0
+        flag = ""
+        if delta > args.threshold:
+            flag, regressions = " REGRESSION", regressions + 1
+        print("%-40s %12d %12d %+7.1f%%%s" % (name, old, cur, delta, flag))
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+
+    run = sub.add_parser("run", help="boot the kernel in QEMU and collect results")
+    run.add_argument("--elf", default=DEFAULT_ELF)
+    run.add_argument("--qemu", default="qemu-system-arm")
+    run.add_argument("--memory", default="1G")
+    run.add_argument("--smp", type=int, default=1)
+    run.add_argument("--timeout", type=int, default=300, help="seconds")
+    run.add_argument("--log", help="parse a saved serial log instead of running QEMU")
+    run.add_argument("-o", "--output", help="JSON output file (default stdout)")
+    run.add_argument("-v", "--verbose", action="store_true", help="echo serial output")
+    run.set_defaults(func=cmd_run)
+
+    cmp = sub.add_parser("compare", help="compare two result files")
+    cmp.add_argument("baseline")
+    cmp.add_argument("current")
+    cmp.add_argument("--threshold", type=float, default=5.0,
+                     help="median increase (%%) reported as a regression")
+    cmp.set_defaults(func=cmd_compare)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Convert kernel trace rings to a Chrome trace / Perfetto JSON file.
+
+Build the kernel with tracing enabled:
+
+    make BOARD_CONFIG=ve-a9-qemu.config TRACE=1 release
+
+capture the serial output (the rings are printed after the benchmarks, or
+when 't' is typed on the console), then run:
+
+    tools/trace.py serial.log -o trace.json
+
+and open trace.json in ui.perfetto.dev or chrome://tracing. The kernel
+prints one "@trace" line per record between "@trace-begin" and "@trace-end"
+(see include/trace.h); event names are read from that header.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+DEFAULT_HEADER = "include/trace.h"
+
+# Threads of each CPU process in the output
+TID_THREADS = 0
+TID_IRQ = 1
+
+
+def parse_events(header):
+    events, phases = {}, {}
+    pattern = re.compile(r"#define\s+TRACE_(\w+)\s+\((0x[0-9A-Fa-f]+|\d+)\)")
+    for line in open(header):
+        match = pattern.match(line.strip())
+        if not match or match.group(1) == "RECORDS":
+            continue
+        name, value = match.group(1), int(match.group(2), 0)
+        if name.startswith("BOOT_"):
+            phases[value] = name[5:].lower()
+        else:
+            events[value] = name.lower()
+    return events, phases
+
+
+def parse(lines):
+    records = None
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "@trace-begin":
+            records = []
+        elif fields[0] == "@trace-end" and records is not None:
+            return records
+        elif fields[0] == "@trace" and records is not None and len(fields) == 6:
+            cpu, ts, event, a, b = (int(f, 16) for f in fields[1:])
+            records.append({"cpu": cpu, "ts": ts, "event": event, "a": a, "b": b})
+    raise RuntimeError("incomplete trace output (no @trace-end)")
+
+
+def unwrap(records):
+    # 32-bit cycle counters, one per CPU: records of a CPU are in order
+    last, high = {}, {}
+    for record in records:
+        cpu = record["cpu"]
+        if cpu in last and record["ts"] < last[cpu]:
+            high[cpu] = high.get(cpu, 0) + (1 << 32)
+        last[cpu] = record["ts"]
+        record["ts"] += high.get(cpu, 0)
+
+
+def convert(records, events, phases, mhz):
+    out = []
+    cpus = sorted({r["cpu"] for r in records})
+    for cpu in cpus:
+        out.append({"ph": "M", "name": "process_name", "pid": cpu, "args": {"name": "cpu%d" % cpu}})
+        out.append({"ph": "M", "name": "thread_name", "pid": cpu, "tid": TID_THREADS, "args": {"name": "threads"}})
+        out.append({"ph": "M", "name": "thread_name", "pid": cpu, "tid": TID_IRQ, "args": {"name": "irq"}})
+
+    running = {}
+    for record in records:
+        cpu, name = record["cpu"], events.get(record["event"], "event_%#x" % record["event"])
+        base = {"pid": cpu, "ts": record["ts"] / mhz}
+        if name == "irq_entry":
+            out.append(dict(base, ph="B", tid=TID_IRQ, name="irq %d" % record["a"]))
+        elif name == "irq_exit":
+            out.append(dict(base, ph="E", tid=TID_IRQ, name="irq %d" % record["a"]))
+        elif name == "sched_switch":
+            # One slice per thread run, named after the thread descriptor
+            if running.get(cpu) is not None:
+                out.append(dict(base, ph="E", tid=TID_THREADS, name=running[cpu]))
+            running[cpu] = "thread %#010x" % record["b"]
+            out.append(dict(base, ph="B", tid=TID_THREADS, name=running[cpu]))
+        elif name == "boot":
+            phase = phases.get(record["a"], str(record["a"]))
+            out.append(dict(base, ph="i", s="p", tid=TID_THREADS, name="boot " + phase))
+        else:
+            out.append(dict(base, ph="i", s="t", tid=TID_THREADS, name=name,
+                            args={"a": "%#010x" % record["a"], "b": "%#010x" % record["b"]}))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="serial log (default stdin)")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="event definitions")
+    parser.add_argument("--mhz", type=float, default=1000.0,
+                        help="cycle counter frequency, MHz (CPU clock)")
+    parser.add_argument("-o", "--output", help="JSON output file (default stdout)")
+    args = parser.parse_args()
+
+    lines = open(args.log).readlines() if args.log else sys.stdin.readlines()
+    events, phases = parse_events(args.header)
+    records = parse(lines)
+    unwrap(records)
+
+    text = json.dumps({"traceEvents": convert(records, events, phases, args.mhz),
+                       "displayTimeUnit": "ns"})
+    if args.output:
+        with open(args.output, "w") as out:
+            out.write(text + "\n")
+    else:
+        print(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
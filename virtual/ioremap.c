@@ -0,0 +1,233 @@
+/**
+ * @file        ioremap.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Device Memory Mapping
+ *
+ *              The device window is split in 1Mb slots. A mapping is a run
+ *              of slots holding consecutive physical sections; the first
+ *              slot of the run keeps its length and reference count. Any
+ *              request inside a mapped run with the same policy reuses it.
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <ioremap.h>
+#include <virtual.h>
+#include <misc.h>
+#include <spinlock.h>
+
+
+/* Private constants -------------------------------------- */
+
+#define SECTION_SIZE        (0x100000)
+#define IOREMAP_SLOTS       (IOREMAP_WINDOW_SIZE / SECTION_SIZE)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct
+{
+    ulong_t  paddr;                     // Section physical address
+    uint16_t head;                      // First slot of the run
+    uint16_t count;                     // Run length (first slot only)
+    uint16_t refs;                      // Users (first slot only)
+    uint8_t  cpolicy;
+    uint8_t  used;
+}io_slot_t;
+
+
+/* Private macros ----------------------------------------- */
+
+#define SLOT_VADDR(slot)    (window + ((slot) * SECTION_SIZE))
+
+
+/* Private variables -------------------------------------- */
+
+static io_slot_t slots[IOREMAP_SLOTS];
+
+static ulong_t window;
+
+// Last run used: drivers usually map the same block repeatedly
+static uint32_t lastRun;
+
+static spinlock_t ioLock = SPINLOCK_INIT("ioremap");
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Checks if a run holds the sections and policy requested
+ * @param   head - First slot of the run
+ *          paddr - First section
+ *          sections - Number of sections
+ *          cpolicy - Cache policy
+ * @retval  TRUE if the run can be shared
+ */
+static bool_t IoRunMatch(uint32_t head, ulong_t paddr, uint32_t sections, uint8_t cpolicy);
+
+/**
+ * @brief   Finds free consecutive slots
+ * @param   count - Number of slots
+ * @retval  First slot, IOREMAP_SLOTS if there are none
+ */
+static uint32_t IoSlotsFind(uint32_t count);
+
+
+/* Private functions -------------------------------------- */
+
+bool_t IoRunMatch(uint32_t head, ulong_t paddr, uint32_t sections, uint8_t cpolicy)
+{
+    io_slot_t* run = &slots[head];
+
+    return (run->used && (run->head == head) && (run->cpolicy == cpolicy) &&
+            (paddr >= run->paddr) &&
+            ((paddr - run->paddr) / SECTION_SIZE + sections <= run->count));
+}
+
+uint32_t IoSlotsFind(uint32_t count)
+{
+    uint32_t slot, free = 0;
+
+    for(slot = 0; slot < IOREMAP_SLOTS; ++slot)
+    {
+        free = slots[slot].used ? 0 : free + 1;
+
+        if(free == count)
+        {
+            return slot + 1 - count;
+        }
+    }
+
+    return IOREMAP_SLOTS;
+}
+
+/**
+ * IoRemapInit Implementation (See header include/ioremap.h file for description)
+*/
+int32_t IoRemapInit(void)
+{
+    uint32_t slot;
+
+    window = (ulong_t)VirtualAlloc(IOREMAP_WINDOW_SIZE, 0);
+
+    if(window == 0)
+    {
+        return E_NO_MEMORY;
+    }
+
+    for(slot = 0; slot < IOREMAP_SLOTS; ++slot)
+    {
+        slots[slot].used = FALSE;
+    }
+
+    lastRun = 0;
+
+    return E_OK;
+}
+
+/**
+ * IoRemap Implementation (See header include/ioremap.h file for description)
+*/
+void* IoRemap(paddr_t paddr, size_t size, uint8_t cpolicy)
+{
+    ulong_t first = ROUND_DOWN((ulong_t)paddr, SECTION_SIZE);
+    ulong_t offset = (ulong_t)paddr - first;
+    uint32_t sections = ROUND_UP(offset + size, SECTION_SIZE) / SECTION_SIZE;
+    uint32_t slot;
+
+    if((window == 0) || (size == 0) || (sections > IOREMAP_SLOTS))
+    {
+        return NULL;
+    }
+
+    SpinLock(&ioLock);
+
+    // Share an existing run
+    if(!IoRunMatch(lastRun, first, sections, cpolicy))
+    {
+        for(slot = 0; slot < IOREMAP_SLOTS; slot += slots[slot].used ? slots[slot].count : 1)
+        {
+            if(IoRunMatch(slot, first, sections, cpolicy))
+            {
+                break;
+            }
+        }
+
+        lastRun = slot;
+    }
+
+    if(lastRun < IOREMAP_SLOTS)
+    {
+        io_slot_t* run = &slots[lastRun];
+
+        run->refs++;
+
+        SpinUnlock(&ioLock);
+
+        return (void*)(SLOT_VADDR(lastRun) + (first - run->paddr) + offset);
+    }
+
+    // New run
+    if((slot = IoSlotsFind(sections)) == IOREMAP_SLOTS)
+    {
+        lastRun = 0;
+        SpinUnlock(&ioLock);
+        return NULL;
+    }
+
+    memCfg_t memCfg = {cpolicy, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    pbv_t device = {(ptr_t)first, sections * SECTION_SIZE};
+    uint32_t i;
+
+    for(i = 0; i < sections; ++i)
+    {
+        slots[slot + i].paddr = first + (i * SECTION_SIZE);
+        slots[slot + i].head = slot;
+        slots[slot + i].cpolicy = cpolicy;
+        slots[slot + i].used = TRUE;
+    }
+
+    slots[slot].count = sections;
+    slots[slot].refs = 1;
+    lastRun = slot;
+
+    // Slots are 1Mb aligned: MMU_MapPages uses sections only
+    MMU_MapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)SLOT_VADDR(slot), &device, 1, &memCfg);
+
+    SpinUnlock(&ioLock);
+
+    return (void*)(SLOT_VADDR(slot) + offset);
+}
+
+/**
+ * IoUnmap Implementation (See header include/ioremap.h file for description)
+*/
+void IoUnmap(void* vaddr)
+{
+    ulong_t addr = (ulong_t)vaddr;
+
+    if((addr < window) || (addr >= window + IOREMAP_WINDOW_SIZE))
+    {
+        return;
+    }
+
+    SpinLock(&ioLock);
+
+    uint32_t slot = slots[(addr - window) / SECTION_SIZE].head;
+    io_slot_t* run = &slots[slot];
+    uint32_t i;
+
+    if(run->used && (--run->refs == 0))
+    {
+        MMU_UnmapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)SLOT_VADDR(slot), run->count * SECTION_SIZE);
+
+        for(i = run->count; i != 0; --i)
+        {
+            slots[slot + i - 1].used = FALSE;
+        }
+    }
+
+    SpinUnlock(&ioLock);
+}
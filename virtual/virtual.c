@@ -0,0 +1,762 @@
+/**
+ * @file        virtual.c
+ * @author      Carlos Fernandes
+ * @version     1.0
+ * @date        19 October, 2026
+ * @brief       Kernel Virtual Space Manager
+ *
+ *              Free and used ranges are kept in two AVL trees ordered by
+ *              start address. Free tree nodes also hold the largest free
+ *              size of their subtree, so the lowest range that fits a
+ *              request is found in O(log n).
+*/
+
+
+/* Includes ----------------------------------------------- */
+#include <virtual.h>
+#include <page.h>
+#include <slab.h>
+#include <spinlock.h>
+#include <misc.h>
+
+
+/* Private constants -------------------------------------- */
+
+#define LARGE_SECTION_SIZE  (0x1000000)
+#define SECTION_SIZE        (0x100000)
+#define LARGE_PAGE_SIZE     (0x10000)
+
+// Region flags (besides the VIRTUAL_* allocation flags)
+#define REGION_MAPPED       (1 << 8)    // Mapped with VirtualMap
+#define REGION_VMALLOC      (1 << 9)    // Pages owned by the region (VMalloc)
+
+
+/* Private types ------------------------------------------ */
+
+typedef struct vnode
+{
+    struct vnode* left;
+    struct vnode* right;
+    ulong_t       start;
+    size_t        size;                 // Range size (guard page included)
+    size_t        maxSize;              // Largest size in the subtree
+    int32_t       height;
+}vnode_t;
+
+// Used range (node first, so it can be used as a tree node)
+typedef struct
+{
+    vnode_t  node;
+    size_t   size;                      // Usable size
+    uint32_t flags;
+    size_t   count;                     // VMalloc chunks
+    pbv_t    pages[VIRTUAL_VMALLOC_CHUNKS];
+}vregion_t;
+
+
+/* Private macros ----------------------------------------- */
+
+#define HEIGHT(n)           (((n) == NULL) ? 0 : (n)->height)
+#define MAX_SIZE(n)         (((n) == NULL) ? 0 : (n)->maxSize)
+#define MAX(a, b)           (((a) > (b)) ? (a) : (b))
+
+
+/* Private variables -------------------------------------- */
+
+static vnode_t* freeTree;
+static vnode_t* usedTree;
+
+static slab_cache_t* nodeCache;
+static slab_cache_t* regionCache;
+
+static ulong_t virtualStart;
+
+// Both trees and the kernel page table entries of the regions
+static spinlock_t vmLock = SPINLOCK_INIT("virtual");
+
+
+/* Private function prototypes ---------------------------- */
+
+/**
+ * @brief   Recomputes the height and largest size of a node
+ * @param   node - Tree node
+ * @retval  No return
+ */
+static void NodeUpdate(vnode_t* node);
+
+/**
+ * @brief   Restores the AVL balance of a subtree
+ * @param   node - Subtree root
+ * @retval  New subtree root
+ */
+static vnode_t* NodeBalance(vnode_t* node);
+
+/**
+ * @brief   Inserts a node in a tree
+ * @param   root - Tree root
+ *          node - Node to insert
+ * @retval  New tree root
+ */
+static vnode_t* TreeInsert(vnode_t* root, vnode_t* node);
+
+/**
+ * @brief   Removes the node with the given start from a tree
+ * @param   root - Tree root
+ *          start - Node start
+ * @retval  New tree root
+ */
+static vnode_t* TreeRemove(vnode_t* root, ulong_t start);
+
+/**
+ * @brief   Finds the node with the highest start not above addr
+ * @param   root - Tree root
+ *          addr - Address
+ * @retval  Node, NULL if none
+ */
+static vnode_t* TreeFloor(vnode_t* root, ulong_t addr);
+
+/**
+ * @brief   Finds the lowest free range where an aligned block fits
+ * @param   root - Free tree root
+ *          size - Block size
+ *          align - Block alignment
+ *          bound - Only subtrees with a range of bound bytes are visited
+ * @retval  Free range, NULL if none
+ */
+static vnode_t* FreeFind(vnode_t* root, size_t size, size_t align, size_t bound);
+
+/**
+ * @brief   Takes [start, start + size) from the free range that holds it
+ * @param   range - Free range
+ *          start - Block start
+ *          size - Block size
+ * @retval  E_OK on success, E_NO_MEMORY if a node cannot be allocated
+ */
+static int32_t FreeTake(vnode_t* range, ulong_t start, size_t size);
+
+/**
+ * @brief   Returns a range to the free tree, merging it with its neighbours
+ * @param   start - Range start
+ *          size - Range size
+ * @retval  E_OK on success, E_NO_MEMORY if a node cannot be allocated
+ */
+static int32_t FreeInsert(ulong_t start, size_t size);
+
+/**
+ * @brief   Creates the descriptor of a used region
+ * @param   start - Region start
+ *          size - Usable size
+ *          span - Size including the guard page
+ *          flags - Region flags
+ * @retval  Region, NULL if out of memory
+ */
+static vregion_t* RegionCreate(ulong_t start, size_t size, size_t span, uint32_t flags);
+
+/**
+ * @brief   Allocates a region with the given alignment
+ * @param   size - Usable size
+ *          align - Alignment
+ *          flags - Region flags
+ * @retval  Region, NULL on failure
+ */
+static vregion_t* RegionAlloc(size_t size, size_t align, uint32_t flags);
+
+/**
+ * @brief   Releases a region and its descriptor
+ * @param   region - Region
+ * @retval  No return
+ */
+static void RegionFree(vregion_t* region);
+
+/**
+ * @brief   Alignment allowing the largest granule that fits in size
+ * @param   size - Region size
+ * @retval  Alignment
+ */
+static size_t GranuleAlign(size_t size);
+
+
+/* Private functions -------------------------------------- */
+
+void NodeUpdate(vnode_t* node)
+{
+    size_t children = MAX(MAX_SIZE(node->left), MAX_SIZE(node->right));
+
+    node->height = MAX(HEIGHT(node->left), HEIGHT(node->right)) + 1;
+    node->maxSize = MAX(node->size, children);
+}
+
+vnode_t* NodeBalance(vnode_t* node)
+{
+    vnode_t* pivot;
+    int32_t balance;
+
+    NodeUpdate(node);
+    balance = HEIGHT(node->left) - HEIGHT(node->right);
+
+    if(balance > 1)
+    {
+        if(HEIGHT(node->left->left) < HEIGHT(node->left->right))
+        {
+            // Left-right case: rotate the left child to the left first
+            pivot = node->left->right;
+            node->left->right = pivot->left;
+            pivot->left = node->left;
+            NodeUpdate(pivot->left);
+            node->left = pivot;
+        }
+
+        // Rotate right
+        pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        NodeUpdate(node);
+        NodeUpdate(pivot);
+        return pivot;
+    }
+
+    if(balance < -1)
+    {
+        if(HEIGHT(node->right->right) < HEIGHT(node->right->left))
+        {
+            // Right-left case: rotate the right child to the right first
+            pivot = node->right->left;
+            node->right->left = pivot->right;
+            pivot->right = node->right;
+            NodeUpdate(pivot->right);
+            node->right = pivot;
+        }
+
+        // Rotate left
+        pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        NodeUpdate(node);
+        NodeUpdate(pivot);
+        return pivot;
+    }
+
+    return node;
+}
+
+vnode_t* TreeInsert(vnode_t* root, vnode_t* node)
+{
+    if(root == NULL)
+    {
+        node->left = node->right = NULL;
+        NodeUpdate(node);
+        return node;
+    }
+
+    if(node->start < root->start)
+    {
+        root->left = TreeInsert(root->left, node);
+    }
+    else
+    {
+        root->right = TreeInsert(root->right, node);
+    }
+
+    return NodeBalance(root);
+}
+
+vnode_t* TreeRemove(vnode_t* root, ulong_t start)
+{
+    if(root == NULL)
+    {
+        return NULL;
+    }
+
+    if(start < root->start)
+    {
+        root->left = TreeRemove(root->left, start);
+    }
+    else if(start > root->start)
+    {
+        root->right = TreeRemove(root->right, start);
+    }
+    else
+    {
+        if((root->left == NULL) || (root->right == NULL))
+        {
+            return (root->left != NULL) ? root->left : root->right;
+        }
+
+        // Replace the node with its successor
+        vnode_t* successor = root->right;
+        while(successor->left != NULL)
+        {
+            successor = successor->left;
+        }
+
+        successor->right = TreeRemove(root->right, successor->start);
+        successor->left = root->left;
+        root = successor;
+    }
+
+    return NodeBalance(root);
+}
+
+vnode_t* TreeFloor(vnode_t* root, ulong_t addr)
+{
+    vnode_t* floor = NULL;
+
+    while(root != NULL)
+    {
+        if(root->start <= addr)
+        {
+            floor = root;
+            root = root->right;
+        }
+        else
+        {
+            root = root->left;
+        }
+    }
+
+    return floor;
+}
+
+vnode_t* FreeFind(vnode_t* root, size_t size, size_t align, size_t bound)
+{
+    vnode_t* found;
+
+    if((root == NULL) || (root->maxSize < bound))
+    {
+        return NULL;
+    }
+
+    // Lowest addresses first
+    if((found = FreeFind(root->left, size, align, bound)) != NULL)
+    {
+        return found;
+    }
+
+    ulong_t start = ROUND_UP(root->start, align);
+
+    if((start >= root->start) && ((start - root->start) + size <= root->size))
+    {
+        return root;
+    }
+
+    return FreeFind(root->right, size, align, bound);
+}
+
+int32_t FreeTake(vnode_t* range, ulong_t start, size_t size)
+{
+    ulong_t end = range->start + range->size;
+    vnode_t* tail = NULL;
+
+    if((start + size) < end)
+    {
+        if((tail = SlabAlloc(nodeCache)) == NULL)
+        {
+            return E_NO_MEMORY;
+        }
+
+        tail->start = start + size;
+        tail->size = end - (start + size);
+    }
+
+    // The range size changes, so it must be reinserted to fix the subtree sizes
+    freeTree = TreeRemove(freeTree, range->start);
+
+    if(start > range->start)
+    {
+        range->size = start - range->start;
+        freeTree = TreeInsert(freeTree, range);
+    }
+    else
+    {
+        SlabFree(nodeCache, range);
+    }
+
+    if(tail != NULL)
+    {
+        freeTree = TreeInsert(freeTree, tail);
+    }
+
+    return E_OK;
+}
+
+int32_t FreeInsert(ulong_t start, size_t size)
+{
+    vnode_t* prev = TreeFloor(freeTree, start);
+    vnode_t* next = TreeFloor(freeTree, start + size);
+
+    if((next != NULL) && (next->start != start + size))
+    {
+        next = NULL;
+    }
+
+    if((prev != NULL) && (prev->start + prev->size != start))
+    {
+        prev = NULL;
+    }
+
+    if(next != NULL)
+    {
+        freeTree = TreeRemove(freeTree, next->start);
+        size += next->size;
+        SlabFree(nodeCache, next);
+    }
+
+    if(prev != NULL)
+    {
+        freeTree = TreeRemove(freeTree, prev->start);
+        prev->size += size;
+        freeTree = TreeInsert(freeTree, prev);
+        return E_OK;
+    }
+
+    vnode_t* node = SlabAlloc(nodeCache);
+
+    if(node == NULL)
+    {
+        return E_NO_MEMORY;
+    }
+
+    node->start = start;
+    node->size = size;
+    freeTree = TreeInsert(freeTree, node);
+
+    return E_OK;
+}
+
+vregion_t* RegionCreate(ulong_t start, size_t size, size_t span, uint32_t flags)
+{
+    vregion_t* region = SlabAlloc(regionCache);
+
+    if(region == NULL)
+    {
+        return NULL;
+    }
+
+    region->node.start = start;
+    region->node.size = span;
+    region->size = size;
+    region->flags = flags;
+    region->count = 0;
+
+    usedTree = TreeInsert(usedTree, &region->node);
+
+    return region;
+}
+
+vregion_t* RegionAlloc(size_t size, size_t align, uint32_t flags)
+{
+    size_t span;
+    vnode_t* range;
+
+    size = ROUND_UP(size, PAGE_SIZE);
+    span = size + ((flags & VIRTUAL_GUARD) ? PAGE_SIZE : 0);
+
+    if(size == 0)
+    {
+        return NULL;
+    }
+
+    // Any range holding size + align fits the block: O(log n) search.
+    // Fall back to an exact search when the space is tight
+    range = FreeFind(freeTree, span, align, span + align - PAGE_SIZE);
+
+    if(range == NULL)
+    {
+        range = FreeFind(freeTree, span, align, span);
+    }
+
+    if(range == NULL)
+    {
+        return NULL;
+    }
+
+    ulong_t start = ROUND_UP(range->start, align);
+    vregion_t* region = RegionCreate(start, size, span, flags);
+
+    if(region == NULL)
+    {
+        return NULL;
+    }
+
+    if(FreeTake(range, start, span) != E_OK)
+    {
+        usedTree = TreeRemove(usedTree, start);
+        SlabFree(regionCache, region);
+        return NULL;
+    }
+
+    return region;
+}
+
+void RegionFree(vregion_t* region)
+{
+    usedTree = TreeRemove(usedTree, region->node.start);
+
+    // On failure the range is lost (no descriptor memory)
+    FreeInsert(region->node.start, region->node.size);
+
+    SlabFree(regionCache, region);
+}
+
+size_t GranuleAlign(size_t size)
+{
+    if(size >= LARGE_SECTION_SIZE)
+    {
+        return LARGE_SECTION_SIZE;
+    }
+    else if(size >= SECTION_SIZE)
+    {
+        return SECTION_SIZE;
+    }
+    else if(size >= LARGE_PAGE_SIZE)
+    {
+        return LARGE_PAGE_SIZE;
+    }
+
+    return PAGE_SIZE;
+}
+
+/**
+ * VirtualInit Implementation (See header include/virtual.h file for description)
+*/
+int32_t VirtualInit(void)
+{
+    nodeCache = SlabCacheCreate("vm_free", sizeof(vnode_t), sizeof(ulong_t), NULL);
+    regionCache = SlabCacheCreate("vm_region", sizeof(vregion_t), SLAB_ALIGN_DEFAULT, NULL);
+
+    if((nodeCache == NULL) || (regionCache == NULL))
+    {
+        return E_NO_MEMORY;
+    }
+
+    freeTree = NULL;
+    usedTree = NULL;
+    // After the RAM mapped in the logical space (PageInit)
+    virtualStart = ROUND_UP((ulong_t)PageLogicalEnd(), LARGE_SECTION_SIZE);
+
+    return FreeInsert(virtualStart, VIRTUAL_END - virtualStart);
+}
+
+/**
+ * VirtualAlloc Implementation (See header include/virtual.h file for description)
+*/
+vaddr_t VirtualAlloc(size_t size, uint32_t flags)
+{
+    SpinLock(&vmLock);
+    vregion_t* region = RegionAlloc(size, GranuleAlign(size), flags & VIRTUAL_GUARD);
+    vaddr_t vaddr = (region == NULL) ? NULL : (vaddr_t)region->node.start;
+    SpinUnlock(&vmLock);
+
+    return vaddr;
+}
+
+/**
+ * VirtualReserve Implementation (See header include/virtual.h file for description)
+*/
+vaddr_t VirtualReserve(vaddr_t vaddr, size_t size)
+{
+    ulong_t start = (ulong_t)vaddr;
+    vregion_t* region = NULL;
+
+    size = ROUND_UP(size, PAGE_SIZE);
+
+    SpinLock(&vmLock);
+
+    vnode_t* range = TreeFloor(freeTree, start);
+
+    if(!(start & (PAGE_SIZE - 1)) && (range != NULL) && (start + size <= range->start + range->size))
+    {
+        region = RegionCreate(start, size, size, 0);
+
+        if((region != NULL) && (FreeTake(range, start, size) != E_OK))
+        {
+            usedTree = TreeRemove(usedTree, start);
+            SlabFree(regionCache, region);
+            region = NULL;
+        }
+    }
+
+    SpinUnlock(&vmLock);
+
+    return (region == NULL) ? NULL : vaddr;
+}
+
+/**
+ * VirtualFree Implementation (See header include/virtual.h file for description)
+*/
+int32_t VirtualFree(vaddr_t vaddr)
+{
+    SpinLock(&vmLock);
+
+    vregion_t* region = (vregion_t*)TreeFloor(usedTree, (ulong_t)vaddr);
+
+    if((region == NULL) || (region->node.start != (ulong_t)vaddr))
+    {
+        SpinUnlock(&vmLock);
+        return E_SRCH;
+    }
+
+    RegionFree(region);
+
+    SpinUnlock(&vmLock);
+
+    return E_OK;
+}
+
+/**
+ * VirtualLookup Implementation (See header include/virtual.h file for description)
+*/
+int32_t VirtualLookup(vaddr_t vaddr, vregion_info_t* info)
+{
+    SpinLock(&vmLock);
+
+    vregion_t* region = (vregion_t*)TreeFloor(usedTree, (ulong_t)vaddr);
+
+    if((region == NULL) || ((ulong_t)vaddr >= region->node.start + region->size))
+    {
+        SpinUnlock(&vmLock);
+        return E_SRCH;
+    }
+
+    info->start = (vaddr_t)region->node.start;
+    info->size = region->size;
+    info->flags = region->flags & VIRTUAL_GUARD;
+
+    SpinUnlock(&vmLock);
+
+    return E_OK;
+}
+
+/**
+ * VirtualMap Implementation (See header include/virtual.h file for description)
+*/
+vaddr_t VirtualMap(pbv_t* pages, size_t count, memCfg_t* memCfg, uint32_t flags)
+{
+    size_t size = 0;
+    size_t i;
+
+    if(count == 0)
+    {
+        return NULL;
+    }
+
+    for(i = 0; i < count; ++i)
+    {
+        size += pages[i].size;
+    }
+
+    // Large granules need the same alignment on both sides
+    size_t align = GranuleAlign(size);
+    while((align > PAGE_SIZE) && ((ulong_t)pages[0].data & (align - 1)))
+    {
+        align = GranuleAlign(align - 1);
+    }
+
+    SpinLock(&vmLock);
+
+    vregion_t* region = RegionAlloc(size, align, (flags & VIRTUAL_GUARD) | REGION_MAPPED);
+
+    if(region == NULL)
+    {
+        SpinUnlock(&vmLock);
+        return NULL;
+    }
+
+    // Regions may share L1 entries: the mapping is done under the lock too
+    MMU_MapPages(MMU_P2L(MMU_KernelPGT()), (vaddr_t)region->node.start, pages, count, memCfg);
+
+    SpinUnlock(&vmLock);
+
+    return (vaddr_t)region->node.start;
+}
+
+/**
+ * VirtualUnmap Implementation (See header include/virtual.h file for description)
+*/
+int32_t VirtualUnmap(vaddr_t vaddr)
+{
+    SpinLock(&vmLock);
+
+    vregion_t* region = (vregion_t*)TreeFloor(usedTree, (ulong_t)vaddr);
+
+    if((region == NULL) || (region->node.start != (ulong_t)vaddr))
+    {
+        SpinUnlock(&vmLock);
+        return E_SRCH;
+    }
+
+    MMU_UnmapPages(MMU_P2L(MMU_KernelPGT()), vaddr, region->size);
+    RegionFree(region);
+
+    SpinUnlock(&vmLock);
+
+    return E_OK;
+}
+
+/**
+ * VMalloc Implementation (See header include/virtual.h file for description)
+*/
+void* VMalloc(size_t size)
+{
+    memCfg_t memCfg = {CPOLICY_WRITEALLOC, APOLICY_RWNA, TRUE, FALSE, TRUE};
+    pbv_t pages[VIRTUAL_VMALLOC_CHUNKS];
+
+    size_t count = PageAllocVector(size, pages, VIRTUAL_VMALLOC_CHUNKS);
+
+    if(count == 0)
+    {
+        return NULL;
+    }
+
+    vaddr_t vaddr = VirtualMap(pages, count, &memCfg, VIRTUAL_GUARD);
+
+    if(vaddr == NULL)
+    {
+        PageFreeVector(pages, count);
+        return NULL;
+    }
+
+    SpinLock(&vmLock);
+
+    vregion_t* region = (vregion_t*)TreeFloor(usedTree, (ulong_t)vaddr);
+
+    region->flags |= REGION_VMALLOC;
+    region->count = count;
+    for(count = 0; count < region->count; ++count)
+    {
+        region->pages[count] = pages[count];
+    }
+
+    SpinUnlock(&vmLock);
+
+    return vaddr;
+}
+
+/**
+ * VFree Implementation (See header include/virtual.h file for description)
+*/
+void VFree(void* ptr)
+{
+    SpinLock(&vmLock);
+
+    vregion_t* region = (vregion_t*)TreeFloor(usedTree, (ulong_t)ptr);
+
+    if((region == NULL) || (region->node.start != (ulong_t)ptr) || !(region->flags & REGION_VMALLOC))
+    {
+        SpinUnlock(&vmLock);
+        return;
+    }
+
+    pbv_t pages[VIRTUAL_VMALLOC_CHUNKS];
+    size_t i, count = region->count;
+
+    for(i = 0; i < count; ++i)
+    {
+        pages[i] = region->pages[i];
+    }
+
+    SpinUnlock(&vmLock);
+
+    VirtualUnmap(ptr);
+    PageFreeVector(pages, count);
+}